@@ -12,6 +12,9 @@ AnalayzerProAudioProcessorEditor::AnalayzerProAudioProcessorEditor (AnalayzerPro
     // Apply custom LookAndFeel globally
     juce::LookAndFeel::setDefaultLookAndFeel (&lnf_);
 
+    // Open editors are analysed first by the shared scheduler (closed ones are throttled)
+    p.getAnalyzerEngine().setAnalysisPriority (AnalysisScheduler::Priority::Foreground);
+
 
     // Init Tooltips
     tooltipManager_ = std::make_unique<mdsp_ui::TooltipManager> (*this, ui_);
@@ -51,6 +54,7 @@ AnalayzerProAudioProcessorEditor::~AnalayzerProAudioProcessorEditor()
 {
     // Shutdown MainView BEFORE destruction to stop timers and clear callbacks
     mainView.shutdown();
+    audioProcessor.getAnalyzerEngine().setAnalysisPriority (AnalysisScheduler::Priority::Background);
     
     // Clear look and feel if set
     setLookAndFeel (nullptr);
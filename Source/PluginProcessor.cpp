@@ -1,5 +1,6 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
+#include "diagnostics/RealtimeGuard.h"
 #include <atomic>
 #include <cmath>
 #include <limits>
@@ -86,6 +87,9 @@ namespace
     {
         return std::isfinite (db) ? juce::jmax (db, -120.0f) : -120.0f;
     }
+
+    // AnalysisBandwidth choice index -> bandwidth (Full, 20 kHz, 10 kHz, 5 kHz); Full analyses at the host rate
+    constexpr double kAnalysisBandwidthsHz[] = { 0.0, 20000.0, 10000.0, 5000.0 };
 }
 
 //==============================================================================
@@ -101,6 +105,9 @@ AnalayzerProAudioProcessor::AnalayzerProAudioProcessor()
       ),
       apvts (*this, nullptr, "PARAMETERS", createParameterLayout())
 {
+    analyzerEngine.setStageProfiler (&stageProfiler_);   // Off until the profiler overlay enables it
+    startTimerHz (4);                                     // Analysis bandwidth watcher (see timerCallback)
+    
     // Analyzer parameters are polled and applied in processBlock (single source of truth).
     // Avoid APVTS listeners here to prevent double-application and to keep RT behavior predictable.
     // Cache raw parameter pointers once (valid for lifetime of APVTS)
@@ -108,6 +115,12 @@ AnalayzerProAudioProcessor::AnalayzerProAudioProcessor()
     pAveraging_ = apvts.getRawParameterValue ("Averaging");
     pHoldPeaks_ = apvts.getRawParameterValue ("HoldPeaks");
     pPeakDecay_ = apvts.getRawParameterValue ("PeakDecay");
+    pMultiRes_  = apvts.getRawParameterValue ("analyzerMultiRes");
+    pFftOverlap_ = apvts.getRawParameterValue ("FftOverlap");
+    pAnalysisBandwidth_ = apvts.getRawParameterValue ("AnalysisBandwidth");
+    pFilterBank_ = apvts.getRawParameterValue ("analyzerFilterBank");
+    pBandResolution_ = apvts.getRawParameterValue ("analyzerBandResolution");
+    pLtas_ = apvts.getRawParameterValue ("analyzerShowLTAS");
     
     pTraceShowLR_   = apvts.getRawParameterValue ("TraceShowLR"); // Legacy
     pTraceShowMono_ = apvts.getRawParameterValue ("analyzerShowMono");
@@ -140,6 +153,7 @@ AnalayzerProAudioProcessor::AnalayzerProAudioProcessor()
 
 AnalayzerProAudioProcessor::~AnalayzerProAudioProcessor()
 {
+    stopTimer();
 }
 
 //==============================================================================
@@ -212,9 +226,19 @@ void AnalayzerProAudioProcessor::prepareToPlay (double sampleRate, int samplesPe
 #if JUCE_DEBUG
     DBG ("Prepare: inCh=" << getTotalNumInputChannels() << " outCh=" << getTotalNumOutputChannels());
 #endif
-    analyzerEngine.prepare (sampleRate, samplesPerBlock);
     // AC1: Force logical default on init so Peak Hold works immediately
+    // (configured before prepare(), which may hand the engine to the analysis pool)
     analyzerEngine.setPeakHoldMode (AnalyzerEngine::PeakHoldMode::Off);
+    // Realtime playback: run FFT/publishing on the shared analysis pool so a large FFT never
+    // lands inside one audio callback. Offline renders stay inline to keep analysis in lockstep.
+    analyzerEngine.setAnalysisThreadEnabled (! isNonRealtime());
+    // Inline realtime fallback (pool registry full): bound the hops per callback, oversized
+    // blocks carry over. Offline renders have no deadline and keep lockstep.
+    analyzerEngine.setHopBudgetEnabled (! isNonRealtime());
+    analyzerEngine.setNumInputChannels (getTotalNumInputChannels());
+    preparedBandwidthIndex_ = getBandwidthIndex();
+    analyzerEngine.setAnalysisBandwidthHz (kAnalysisBandwidthsHz[preparedBandwidthIndex_]);
+    analyzerEngine.prepare (sampleRate, samplesPerBlock);
     loudnessAnalyzer.prepare (sampleRate, samplesPerBlock);
 
     meterSampleRate_ = (sampleRate > 1.0 ? sampleRate : 48000.0);
@@ -236,16 +260,25 @@ void AnalayzerProAudioProcessor::prepareToPlay (double sampleRate, int samplesPe
 
     lastFftSizeIndex_ = -1;
     lastAveragingIndex_ = -1;
+    lastOverlapIndex_ = -1;
     lastHold_ = false;
+    lastMultiRes_ = false;
+    lastFilterBank_ = false;
+    lastBandResolutionIndex_ = -1;
+    lastLtas_ = false;
     lastPeakDecayDbPerSec_ = std::numeric_limits<float>::quiet_NaN();
 
-    analysisBuffer.setSize (2, samplesPerBlock);
+    // Analysis scratch: at least kMinAnalysisChunkSamples, larger host blocks are fed in chunks
+    analysisBuffer.setSize (2, juce::jmax (samplesPerBlock, kMinAnalysisChunkSamples));
     outputAnalysisBuffer.setSize (2, samplesPerBlock);
+
+    isPrepared_.store (true, std::memory_order_release);
 }
 
 
 void AnalayzerProAudioProcessor::releaseResources()
 {
+    isPrepared_.store (false, std::memory_order_release);
     analyzerEngine.reset();
     loudnessAnalyzer.reset();
 }
@@ -254,15 +287,15 @@ bool AnalayzerProAudioProcessor::isBusesLayoutSupported (const BusesLayout& layo
 {
     const auto& mainOut = layouts.getMainOutputChannelSet();
 
-    // Output must be mono or stereo
-    if (mainOut != juce::AudioChannelSet::mono()
-        && mainOut != juce::AudioChannelSet::stereo())
-        return false;
-
     // Must have output enabled
     if (mainOut.isDisabled())
         return false;
 
+    // Mono, stereo or a multichannel layout up to 7.1.4 (L/R feed the main analyser,
+    // every channel feeds the per-channel view)
+    if (mainOut.size() > MultichannelAnalyzer::kMaxChannels)
+        return false;
+
 #if !JucePlugin_IsSynth
     // For effect plugins: require input matches output
     const auto& mainIn = layouts.getMainInputChannelSet();
@@ -296,30 +329,29 @@ void AnalayzerProAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
         return;
 
     juce::ScopedNoDenormals noDenormals;
+    RealtimeGuard::ScopedRealtimeThread realtimeScope;   // Checked only in builds that link the rtcheck hooks
     auto totalNumInputChannels  = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
     
     const int n = buffer.getNumSamples();
     const float dtSec = static_cast<float> (n / juce::jmax (1.0, meterSampleRate_));
+    
+    // Stage timing (no-op unless the profiler is enabled)
+    using Stage = StageProfiler::Stage;
+    StageProfiler::Scope profileCallback (&stageProfiler_, Stage::Callback);
+    stageProfiler_.setDeadline (n, meterSampleRate_);
 
     // --- Analysis Path Transform ---
-    // 1. Copy to scratch buffer
+    // 1. Copy to scratch buffer (chunked, see the analyzer feed below)
     // 2. Apply Mode (L-R, Mono, M/S)
     // 3. Feed Consumers (Meters, Analyzer, Loudness)
-    
-    // Ensure scratch buffer is big enough (should be resized in prepareToPlay)
-    if (analysisBuffer.getNumSamples() < n)
-        analysisBuffer.setSize (2, n, true, false, true);
 
-    const int numAnalChannels = juce::jmin (2, buffer.getNumChannels());
-    
-    // Copy input to scratch
-    for (int ch = 0; ch < numAnalChannels; ++ch)
-        analysisBuffer.copyFrom (ch, 0, buffer, ch, 0, n);
+    // Multichannel buses: every raw input channel (pre-gain) to the per-channel analyser
+    // (wait-free copy, skipped while no view displays it; only in the callback total)
+    if (totalNumInputChannels > 2)
+        analyzerEngine.processMultichannel (buffer);
     
-    // Zero any unused channels in scratch
-    for (int ch = numAnalChannels; ch < analysisBuffer.getNumChannels(); ++ch)
-        analysisBuffer.clear (ch, 0, n);
+    int64_t stageStart = stageProfiler_.begin();
 
     // DECOUPLED: Analysis buffer always carries Stereo L/R.
     // Downstream consumers (Scope, Meters) can decide how to view it.
@@ -376,29 +408,20 @@ void AnalayzerProAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
         if (clipped)
             inputMeters_[ch].clipLatched.store (true, std::memory_order_relaxed);
     }
-
-    // Clear any output channels that don't contain input data
-    for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
-        buffer.clear (i, 0, buffer.getNumSamples());
-
-    // Apply gain (to OUTPUT buffer, NOT analysis buffer)
-    const auto gainValue = parameters.getGain();
-    if (gainValue != 1.0f)
-    {
-        for (int channel = 0; channel < totalNumInputChannels; ++channel)
-            buffer.applyGain (channel, 0, buffer.getNumSamples(), gainValue);
-    }
-    
     
+    stageProfiler_.end (Stage::InputMeters, stageStart);
+    stageStart = stageProfiler_.begin();
+
     // Update analyzer parameters from APVTS (audio thread, real-time safe)
     // Note: Mode is UI-only, handled on message thread
-    auto* fftSizeParam = apvts.getRawParameterValue ("FftSize");
-    auto* avgParam     = apvts.getRawParameterValue ("Averaging");
-    auto* decayParam   = apvts.getRawParameterValue ("PeakDecay");
+    // Cached pointers: the string-keyed lookup builds a juce::String (allocates)
+    auto* fftSizeParam = pFftSize_;
+    auto* avgParam     = pAveraging_;
+    auto* decayParam   = pPeakDecay_;
     
     if (fftSizeParam != nullptr)
     {
-        constexpr int sizes[] = { 1024, 2048, 4096, 8192 };
+        constexpr int sizes[] = { 1024, 2048, 4096, 8192, 16384, 32768, 65536 };
         constexpr int kNumSizes = static_cast<int> (std::size (sizes));
 
         const float raw = fftSizeParam->load();
@@ -416,6 +439,19 @@ void AnalayzerProAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
         }
     }
     
+    if (pFftOverlap_ != nullptr)
+    {
+        // Choice index == AnalyzerEngine::Overlap value (0%, 50%, 75%, 87.5%, Auto)
+        constexpr int kNumOverlaps = static_cast<int> (AnalyzerEngine::Overlap::Auto) + 1;
+        const int index = juce::jlimit (0, kNumOverlaps - 1, static_cast<int> (pFftOverlap_->load()));
+
+        if (index != lastOverlapIndex_)
+        {
+            lastOverlapIndex_ = index;
+            analyzerEngine.setOverlap (static_cast<AnalyzerEngine::Overlap> (index));
+        }
+    }
+    
         // Map index to octave bandwidth
         // 0: Off, 1: 1/24, 2: 1/12, 3: 1/6, 4: 1/3, 5: 1.0
         constexpr float octaves[] = { 0.0f, 1.0f/24.0f, 1.0f/12.0f, 1.0f/6.0f, 1.0f/3.0f, 1.0f };
@@ -448,6 +484,50 @@ void AnalayzerProAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
         }
     }
     
+    if (pMultiRes_ != nullptr)
+    {
+        const bool multiRes = (pMultiRes_->load() > 0.5f);
+        if (multiRes != lastMultiRes_)
+        {
+            lastMultiRes_ = multiRes;
+            analyzerEngine.setMultiResolutionEnabled (multiRes);
+        }
+    }
+    
+    if (pFilterBank_ != nullptr)
+    {
+        const bool filterBank = (pFilterBank_->load() > 0.5f);
+        if (filterBank != lastFilterBank_)
+        {
+            lastFilterBank_ = filterBank;
+            analyzerEngine.setFilterBankEnabled (filterBank);
+        }
+    }
+    
+    if (pBandResolution_ != nullptr)
+    {
+        // Index -> bands per octave (1/1, 1/3, 1/6, 1/12)
+        constexpr int bandsPerOctave[] = { 1, 3, 6, 12 };
+        constexpr int kNumResolutions = static_cast<int> (std::size (bandsPerOctave));
+        const int index = juce::jlimit (0, kNumResolutions - 1, static_cast<int> (pBandResolution_->load()));
+
+        if (index != lastBandResolutionIndex_)
+        {
+            lastBandResolutionIndex_ = index;
+            analyzerEngine.setFilterBankBandsPerOctave (bandsPerOctave[index]);
+        }
+    }
+    
+    if (pLtas_ != nullptr)
+    {
+        const bool ltas = (pLtas_->load() > 0.5f);
+        if (ltas != lastLtas_)
+        {
+            lastLtas_ = ltas;
+            analyzerEngine.setLtasEnabled (ltas);
+        }
+    }
+    
     if (decayParam != nullptr)
     {
         const float ms = decayParam->load();
@@ -462,6 +542,8 @@ void AnalayzerProAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
             analyzerEngine.setReleaseTimeMs (ms);
         }
     }
+    stageProfiler_.end (Stage::ParameterSync, stageStart);
+    
     // IMPORTANT: AnalyzerEngine must be fed from the input signal (pre-mute, pre-gain, pre-output).
     // Feed analyzer (audio thread, real-time safe)
         if (pBypass_ && *pBypass_ > 0.5f)
@@ -471,10 +553,50 @@ void AnalayzerProAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
         }
         else
         {
-             analyzerEngine.processBlock (analysisBuffer); // Feed transformed buffer
-             loudnessAnalyzer.process (analysisBuffer);    // Feed transformed buffer
+             // Oversized host blocks (offline renders can hand over 65536 samples) go through the
+             // preallocated scratch in chunks: nothing is resized on the audio thread. The engine's
+             // hop budget spans the whole callback, not each chunk.
+             const int numAnalChannels = juce::jmin (2, buffer.getNumChannels());
+             const int chunkCapacity = analysisBuffer.getNumSamples();
+             analyzerEngine.beginCallback();
+
+             for (int offset = 0; offset < n; offset += chunkCapacity)
+             {
+                 const int chunkSize = juce::jmin (chunkCapacity, n - offset);
+
+                 stageStart = stageProfiler_.begin();
+                 for (int ch = 0; ch < numAnalChannels; ++ch)
+                     analysisBuffer.copyFrom (ch, 0, buffer, ch, offset, chunkSize);
+                 for (int ch = numAnalChannels; ch < analysisBuffer.getNumChannels(); ++ch)
+                     analysisBuffer.clear (ch, 0, chunkSize);
+                 stageProfiler_.end (Stage::AnalysisCopy, stageStart);
+
+                 // Non-owning view of the chunk (channel pointers live in the buffer itself, no allocation)
+                 const juce::AudioBuffer<float> chunk (analysisBuffer.getArrayOfWritePointers(), analysisBuffer.getNumChannels(), chunkSize);
+                 stageStart = stageProfiler_.begin();
+                 analyzerEngine.processBlock (chunk); // Feed transformed buffer
+                 stageProfiler_.end (Stage::Analyzer, stageStart);
+
+                 stageStart = stageProfiler_.begin();
+                 loudnessAnalyzer.process (chunk);    // Feed transformed buffer
+                 stageProfiler_.end (Stage::Loudness, stageStart);
+             }
         }
-        
+
+    // Clear any output channels that don't contain input data
+    for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
+        buffer.clear (i, 0, buffer.getNumSamples());
+
+    stageStart = stageProfiler_.begin();
+
+    // Apply gain (to OUTPUT buffer, NOT analysis buffer). After the analyzer feed, which reads the
+    // input chunk by chunk straight from this buffer.
+    const auto gainValue = parameters.getGain();
+    if (gainValue != 1.0f)
+    {
+        for (int channel = 0; channel < totalNumInputChannels; ++channel)
+            buffer.applyGain (channel, 0, buffer.getNumSamples(), gainValue);
+    }
 
     // --- Output Metering Path ---
     // Decoupled from analyzer mode. Meters read RAW output buffer (post-gain).
@@ -528,9 +650,12 @@ void AnalayzerProAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
         if (clipped)
             outputMeters_[ch].clipLatched.store (true, std::memory_order_relaxed);
     }
+    
+    stageProfiler_.end (Stage::OutputMeters, stageStart);
 
     // Hardware meter mapping (RT-safe): convert current meter states to LED-friendly levels.
     {
+        StageProfiler::Scope profile (&stageProfiler_, Stage::HardwareMapping);
         HardwareMeterLevelsFrame frame;
         frame.input.channelCount = inChCount;
         frame.output.channelCount = outChCount;
@@ -641,6 +766,27 @@ void AnalayzerProAudioProcessor::setBypassState (bool bypassed)
 }
 
 //==============================================================================
+int AnalayzerProAudioProcessor::getBandwidthIndex() const noexcept
+{
+    return (pAnalysisBandwidth_ != nullptr) ? juce::jlimit (0, 3, static_cast<int> (pAnalysisBandwidth_->load())) : 0;
+}
+
+void AnalayzerProAudioProcessor::timerCallback()
+{
+    // Bandwidth changes rebuild rate-dependent analysis state (resampler matrices, side analysers),
+    // which allocates: re-prepare here with the audio callback held off instead of in processBlock.
+    // Only the engine is re-prepared - loudness, meters and clip latches do not depend on it.
+    // Offline renders keep the bandwidth they were prepared with.
+    if (! isPrepared_.load (std::memory_order_acquire) || isNonRealtime() || getBandwidthIndex() == preparedBandwidthIndex_)
+        return;
+
+    suspendProcessing (true);
+    preparedBandwidthIndex_ = getBandwidthIndex();
+    analyzerEngine.setAnalysisBandwidthHz (kAnalysisBandwidthsHz[preparedBandwidthIndex_]);
+    analyzerEngine.prepare (getSampleRate(), getBlockSize());
+    suspendProcessing (false);
+}
+
 void AnalayzerProAudioProcessor::parameterChanged (const juce::String& parameterID, float newValue)
 {
     // No-op: analyzer parameters are polled and applied in processBlock.
@@ -684,13 +830,28 @@ juce::AudioProcessorValueTreeState::ParameterLayout AnalayzerProAudioProcessor::
     // Channel Mode REMOVED in favor of granular trace toggles
     // params.push_back (std::make_unique<juce::AudioParameterChoice> ("ChannelMode"...));
     
-    // Analyzer FFT Size (choice: 1024, 2048, 4096, 8192)
+    // Analyzer FFT Size (choice: 1024 .. 65536; new sizes appended so saved indices stay valid)
     params.push_back (std::make_unique<juce::AudioParameterChoice> (
         "FftSize", "FFT Size",
-        juce::StringArray { "1024", "2048", "4096", "8192" },
+        juce::StringArray { "1024", "2048", "4096", "8192", "16384", "32768", "65536" },
         2,  // Default: 4096 (index 2)
         "FFT Size"));
     
+    // Analyzer FFT Overlap (Auto: one frame per UI refresh instead of a fixed fraction of the FFT size)
+    params.push_back (std::make_unique<juce::AudioParameterChoice> (
+        "FftOverlap", "FFT Overlap",
+        juce::StringArray { "0%", "50%", "75%", "87.5%", "Auto" },
+        2,  // Default: 75% (index 2, previous fixed behaviour)
+        "FFT Overlap"));
+    
+    // Analysis Bandwidth (decimating front end: 20 kHz analyses 96/192 kHz at 48 kHz and 176.4 kHz
+    // at 88.2 kHz, 10 and 5 kHz also decimate lower rates, for cheaper FFTs and finer bins). Not automatable: a change re-prepares the analyzer.
+    params.push_back (std::make_unique<juce::AudioParameterChoice> (
+        "AnalysisBandwidth", "Analysis Bandwidth",
+        juce::StringArray { "Full", "20 kHz", "10 kHz", "5 kHz" },
+        0,  // Default: Full (host rate, previous behaviour)
+        juce::AudioParameterChoiceAttributes().withLabel ("Analysis Bandwidth").withAutomatable (false)));
+    
     // Analyzer Smoothing (Fractional Octave)
     params.push_back (std::make_unique<juce::AudioParameterChoice> (
         "Averaging", "Smoothing",
@@ -784,6 +945,38 @@ juce::AudioProcessorValueTreeState::ParameterLayout AnalayzerProAudioProcessor::
         "analyzerShowRMS", "Show RMS",
         false,   // Default: Off
         "Show RMS"));
+
+    // Multi-Resolution (LOG mode: per-octave decimated FFTs instead of one long FFT)
+    params.push_back (std::make_unique<juce::AudioParameterBool> (
+        "analyzerMultiRes", "Multi-Resolution",
+        false,   // Default: Off
+        "Multi-Resolution"));
+
+    // Filter-Bank RTA (BANDS mode: IEC 61260 style IIR filter bank instead of FFT bins)
+    params.push_back (std::make_unique<juce::AudioParameterBool> (
+        "analyzerFilterBank", "Filter Bank RTA",
+        false,   // Default: Off (FFT bands)
+        "Filter Bank RTA"));
+
+    // Band Resolution (filter-bank RTA)
+    params.push_back (std::make_unique<juce::AudioParameterChoice> (
+        "analyzerBandResolution", "Band Resolution",
+        juce::StringArray { "1/1 Oct", "1/3 Oct", "1/6 Oct", "1/12 Oct" },
+        1,  // Default: 1/3 Oct (same grid as the FFT bands)
+        "Band Resolution"));
+
+    // Long-Term Average Spectrum (accumulates while on, cleared by the rail's LTAS Reset button)
+    params.push_back (std::make_unique<juce::AudioParameterBool> (
+        "analyzerShowLTAS", "Show LTAS",
+        false,   // Default: Off
+        "Show LTAS"));
+
+    // Spectrogram (UI only: shows the view, whose Product::Spectrogram consumer gates recording -
+    // the engine writes history only while the view is visible, nothing is recorded while hidden)
+    params.push_back (std::make_unique<juce::AudioParameterBool> (
+        "analyzerShowSpectrogram", "Show Spectrogram",
+        false,   // Default: Off
+        "Show Spectrogram"));
         
     // Weighting
     params.push_back (std::make_unique<juce::AudioParameterChoice> (
@@ -19,7 +19,8 @@
     Analyzes audio input and displays FFT/BANDS/LOG spectrum.
 */
 class AnalayzerProAudioProcessor : public juce::AudioProcessor,
-                                    public juce::AudioProcessorValueTreeState::Listener
+                                    public juce::AudioProcessorValueTreeState::Listener,
+                                    private juce::Timer
 {
 public:
     struct MeterState
@@ -109,6 +110,9 @@ public:
 
     AnalyzerPro::dsp::LoudnessAnalyzer& getLoudnessAnalyzer() { return loudnessAnalyzer; }
     
+    /** Per-stage callback timing (off until a reader enables it, e.g. the profiler overlay). */
+    StageProfiler& getStageProfiler() noexcept { return stageProfiler_; }
+    
     //==============================================================================
     // Bypass Helpers
     bool getBypassState() const;
@@ -117,12 +121,25 @@ public:
 private:
     //==============================================================================
     Parameters parameters;
+    StageProfiler stageProfiler_;   // Declared before the engine, which holds a pointer to it
     AnalyzerEngine analyzerEngine;
     // Cached analyzer parameter values (to avoid calling setters every block)
     int   lastFftSizeIndex_ = -1;
     int   lastAveragingIndex_ = -1;
+    int   lastOverlapIndex_ = -1;
     bool  lastHold_ = false;
+    bool  lastMultiRes_ = false;
+    bool  lastFilterBank_ = false;
+    int   lastBandResolutionIndex_ = -1;
+    bool  lastLtas_ = false;
     float lastPeakDecayDbPerSec_ = std::numeric_limits<float>::quiet_NaN();
+    
+    // Analysis bandwidth sets the engine's analysis rate, which only prepare() can change:
+    // a message-thread timer re-prepares the engine (processing suspended) when the choice differs
+    int   preparedBandwidthIndex_ = 0;
+    std::atomic<bool> isPrepared_ { false };   // Set by prepareToPlay(), cleared by releaseResources()
+    void timerCallback() override;
+    int getBandwidthIndex() const noexcept;
         
     // APVTS for analyzer controls
     juce::AudioProcessorValueTreeState apvts;
@@ -148,7 +165,9 @@ private:
     HardwareMeterMapper hardwareMeterMapper_ { HardwareMeterMapper::Config { 16, false } };
     SoftwareMeterSink softwareMeterSink_;
     
-    // Scratch buffer for analysis (avoids modifying output buffer for visualization)
+    // Scratch buffer for analysis (avoids modifying output buffer for visualization).
+    // Sized in prepareToPlay only; larger host blocks are fed through it in chunks.
+    static constexpr int kMinAnalysisChunkSamples = 4096;
     juce::AudioBuffer<float> analysisBuffer;
     juce::AudioBuffer<float> outputAnalysisBuffer; // Added for V2 Output Metering
     
@@ -158,6 +177,12 @@ private:
     std::atomic<float>* pHoldPeaks_ = nullptr;
     std::atomic<float>* pPeakDecay_ = nullptr;
     std::atomic<float>* pBypass_ = nullptr;
+    std::atomic<float>* pMultiRes_ = nullptr;
+    std::atomic<float>* pFftOverlap_ = nullptr;
+    std::atomic<float>* pAnalysisBandwidth_ = nullptr;
+    std::atomic<float>* pFilterBank_ = nullptr;
+    std::atomic<float>* pBandResolution_ = nullptr;
+    std::atomic<float>* pLtas_ = nullptr;
     
     // Trace Config Parameters
     std::atomic<float>* pTraceShowLR_ = nullptr;
@@ -0,0 +1,183 @@
+#include "AnalysisScheduler.h"
+#include "../diagnostics/RealtimeGuard.h"
+
+//==============================================================================
+class AnalysisScheduler::Worker final : public juce::Thread
+{
+public:
+    Worker (AnalysisScheduler& s, int workerIndex)
+        : juce::Thread ("AnalyzerPro Analysis " + juce::String (workerIndex)),
+          scheduler (s), index (workerIndex)
+    {
+    }
+
+    void run() override
+    {
+        // Worker 0 polls the registry; the others stay parked on their event until it (or a
+        // client posting a batch) finds them work, then run passes until one comes back empty
+        const bool isPoller = (index == 0);
+
+        while (! threadShouldExit())
+        {
+            int numServiced = 0;
+            {
+                // Client pipelines must be real-time clean too; waking and waiting lock, so they stay outside
+                RealtimeGuard::ScopedRealtimeThread realtimeScope;
+                numServiced = scheduler.runPass (index);
+            }
+
+            if (numServiced > 0)
+            {
+                // More than one client had queued work: bring in helpers for the next pass
+                if (isPoller && numServiced > 1)
+                    scheduler.wakeWorkers (numServiced - 1);
+                continue;
+            }
+
+            wait (isPoller ? kPollIntervalMs : -1);
+        }
+    }
+
+private:
+    static constexpr int kPollIntervalMs = 2;
+    AnalysisScheduler& scheduler;
+    const int index;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Worker)
+};
+
+//==============================================================================
+AnalysisScheduler::AnalysisScheduler() = default;
+
+AnalysisScheduler::~AnalysisScheduler()
+{
+    for (auto& w : workers_)
+    {
+        w->signalThreadShouldExit();
+        w->notify();    // Parked helpers wait without a timeout
+    }
+    for (auto& w : workers_)
+        w->stopThread (1000);
+}
+
+bool AnalysisScheduler::add (Client& client)
+{
+    const std::lock_guard<std::mutex> lock (registryLock_);
+
+    if (workers_.empty())
+    {
+        // One core stays free for the host's audio threads
+        const int numWorkers = juce::jlimit (1, 16, juce::SystemStats::getNumCpus() - 1);
+        for (int i = 0; i < numWorkers; ++i)
+            workers_.push_back (std::make_unique<Worker> (*this, i));
+        // Normal priority: analysis must not compete with the host's own audio worker threads
+        for (auto& w : workers_)
+            w->startThread (juce::Thread::Priority::normal);
+    }
+
+    for (int i = 0; i < kMaxClients; ++i)
+    {
+        auto& slot = slots_[static_cast<std::size_t> (i)];
+        if (slot.client.load() != nullptr)
+            continue;
+
+        slot.nextDueMs.store (0, std::memory_order_relaxed);
+        slot.client.store (&client);
+        if (i >= numSlotsUsed_.load())
+            numSlotsUsed_.store (i + 1);
+        return true;
+    }
+
+    return false;
+}
+
+void AnalysisScheduler::remove (Client& client)
+{
+    const std::lock_guard<std::mutex> lock (registryLock_);
+
+    for (auto& slot : slots_)
+    {
+        if (slot.client.load() != &client)
+            continue;
+
+        // Workers re-check the pointer after raising users, so once both are seen cleared
+        // nobody can enter the client again (sequentially consistent on purpose)
+        slot.client.store (nullptr);
+        while (slot.users.load() > 0)
+            juce::Thread::yield();
+        return;
+    }
+}
+
+void AnalysisScheduler::wakeWorkers (int maxWorkers)
+{
+    // Helpers only: the poller (worker 0) wakes on its own interval
+    const int numWorkers = static_cast<int> (workers_.size());
+    for (int i = 1; i < numWorkers && i <= maxWorkers; ++i)
+        workers_[static_cast<std::size_t> (i)]->notify();
+}
+
+AnalysisScheduler::Client* AnalysisScheduler::acquire (Slot& slot) noexcept
+{
+    if (slot.client.load (std::memory_order_relaxed) == nullptr)
+        return nullptr;
+
+    slot.users.fetch_add (1);
+    Client* client = slot.client.load();
+    if (client == nullptr)
+        release (slot);
+    return client;
+}
+
+int AnalysisScheduler::runPass (int workerIndex) noexcept
+{
+    const int numSlots = numSlotsUsed_.load (std::memory_order_acquire);
+    if (numSlots == 0)
+        return 0;
+
+    int numServiced = 0;
+
+    // Foreground clients, then Background clients that are due. Each worker starts at its own
+    // offset so concurrent passes spread over different clients. Posted parallel jobs are
+    // helped with on the same visit (their poster is waiting on them), so an idle pass costs
+    // two acquire / release pairs per registered client.
+    const uint32_t nowMs = juce::Time::getMillisecondCounter();
+    const int start = (workerIndex * 7) % numSlots;
+
+    for (const auto priority : { Priority::Foreground, Priority::Background })
+    {
+        for (int n = 0; n < numSlots; ++n)
+        {
+            auto& slot = slots_[static_cast<std::size_t> ((start + n) % numSlots)];
+            auto* client = acquire (slot);
+            if (client == nullptr)
+                continue;
+
+            bool didWork = false;
+            while (client->runParallelJob())
+                didWork = true;
+
+            const bool background = (priority == Priority::Background);
+            const bool eligible = client->getPriority() == priority
+                               && (! background || static_cast<int32_t> (nowMs - slot.nextDueMs.load (std::memory_order_relaxed)) >= 0);
+
+            if (eligible && ! slot.running.exchange (true, std::memory_order_acquire))
+            {
+                if (client->runPendingAnalysis())
+                {
+                    didWork = true;
+                    if (background)
+                        slot.nextDueMs.store (nowMs + kBackgroundIntervalMs, std::memory_order_relaxed);
+                }
+                slot.running.store (false, std::memory_order_release);
+            }
+
+            release (slot);
+
+            if (didWork)
+                ++numServiced;
+        }
+    }
+
+    return numServiced;
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+//==============================================================================
+/**
+    Process-wide pool that runs the analysis of every AnalyzerPro instance.
+
+    Shared through juce::SharedResourcePointer, so 30 inserted instances use one fixed set of
+    worker threads (cores - 1, at most 16) instead of one analysis thread each. Engines register
+    a Client when they prepare in worker mode; its runPendingAnalysis() drains whatever the audio
+    thread queued (never concurrently for one client). Clients may also post parallel jobs for
+    the duration of one runPendingAnalysis() call (runParallelJob()), which any idle worker helps
+    with - the multichannel analyser splits its channel pairs this way.
+
+    Scheduling: every pass visits the Foreground clients (open editors) before the Background
+    ones, and a Background client is serviced at most every kBackgroundIntervalMs, so closed
+    editors catch up in a few large batches instead of competing with the visible ones. Workers
+    start their scan at different offsets and claim clients with a flag: an idle worker takes
+    whichever client has queued work (claim-based stealing from one shared registry).
+
+    Producers stay wait-free: nobody signals from the audio thread. One worker polls the
+    registry every kPollIntervalMs; the others stay parked on their event and are only woken
+    when the poller finds more than one client with queued work, or a client posts parallel
+    jobs, so idle CPU does not grow with the number of workers. The pool runs at normal
+    priority to leave the host's audio worker threads alone. add()/remove() run on the message
+    thread; remove() returns once no worker is inside the client any more.
+*/
+class AnalysisScheduler
+{
+public:
+    enum class Priority
+    {
+        Foreground = 0,     // Editor open: serviced first, every pass
+        Background          // No editor: throttled to kBackgroundIntervalMs
+    };
+
+    /** One registered analysis context. */
+    class Client
+    {
+    public:
+        virtual ~Client() = default;
+
+        /** Drains queued input and runs the pipeline; false when there was nothing to do.
+            Never called concurrently for the same client. */
+        virtual bool runPendingAnalysis() = 0;
+
+        /** Runs one job of a batch posted from runPendingAnalysis(); false when none is left.
+            Called concurrently from any worker. */
+        virtual bool runParallelJob() { return false; }
+
+        void setPriority (Priority p) noexcept { priority_.store (static_cast<int> (p), std::memory_order_relaxed); }
+        Priority getPriority() const noexcept { return static_cast<Priority> (priority_.load (std::memory_order_relaxed)); }
+
+    private:
+        std::atomic<int> priority_ { static_cast<int> (Priority::Background) };
+    };
+
+    static constexpr int kMaxClients = 256;
+    static constexpr uint32_t kBackgroundIntervalMs = 100;
+
+    AnalysisScheduler();
+    ~AnalysisScheduler();
+
+    /** Registers a client (starts the workers on first use). False when the registry is full:
+        the caller should then analyse inline. */
+    bool add (Client& client);
+
+    /** Unregisters and waits until no worker runs the client. No-op if it was not added. */
+    void remove (Client& client);
+
+    /** Wakes up to maxWorkers parked helpers, e.g. after posting parallel jobs (locks: not for
+        the audio thread). */
+    void wakeWorkers (int maxWorkers);
+
+    int getNumWorkers() const noexcept { return static_cast<int> (workers_.size()); }
+
+private:
+    class Worker;
+
+    struct Slot
+    {
+        std::atomic<Client*> client { nullptr };
+        std::atomic<int> users { 0 };               // Workers currently holding the pointer
+        std::atomic<bool> running { false };        // runPendingAnalysis() claimed
+        std::atomic<uint32_t> nextDueMs { 0 };      // Background throttle
+    };
+
+    /** One pass over the registry; returns the number of clients that had work. */
+    int runPass (int workerIndex) noexcept;
+    Client* acquire (Slot& slot) noexcept;
+    static void release (Slot& slot) noexcept { slot.users.fetch_sub (1); }
+
+    std::array<Slot, kMaxClients> slots_;
+    std::atomic<int> numSlotsUsed_ { 0 };          // High-water mark: passes scan [0, numSlotsUsed_)
+    std::mutex registryLock_;                       // add / remove (message thread)
+    std::vector<std::unique_ptr<Worker>> workers_;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AnalysisScheduler)
+};
@@ -1,178 +1,364 @@
 #include "AnalyzerEngine.h"
+#include "../dsp/simd/SpectrumKernels.h"
 #include <cmath>
 #include <algorithm>
+#include <cstring>
 #include <juce_events/juce_events.h>
 
+//==============================================================================
+/**
+    Worker-mode registration with the shared AnalysisScheduler.
+    Drains the SPSC ring filled by the audio thread and runs the regular hop pipeline on
+    whichever pool worker claims it (never two at once).
+*/
+class AnalyzerEngine::AnalysisClient final : public AnalysisScheduler::Client
+{
+public:
+    explicit AnalysisClient (AnalyzerEngine& e) : engine (e) {}
+
+    bool runPendingAnalysis() override { return engine.drainAnalysisFifo(); }
+
+private:
+    AnalyzerEngine& engine;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AnalysisClient)
+};
+
 //==============================================================================
 AnalyzerEngine::AnalyzerEngine()
-    : currentFFTSize (2048), currentHopSize (512)
+    : currentFFTSize (2048), currentHopSize (512),
+      analysisClient_ (std::make_unique<AnalysisClient> (*this))
 {
-    // Buffers will be resized in prepare()
+    // Buffers are carved from the arena in prepare()
+    // Snapshot slots are reserved here (message thread, before any consumer exists) for the
+    // worst case; each frame only writes the traces it produces at the active bin count.
+    snapshots_.reserve (AnalyzerSnapshot::kMaxPackedFloats);
     peakHoldEnabled_ = false;
     peakHoldMode_ = PeakHoldMode::HoldThenDecay;
 }
 
-AnalyzerEngine::~AnalyzerEngine() = default;
+AnalyzerEngine::~AnalyzerEngine()
+{
+    stopAnalysisThread();
+}
+
+void AnalyzerEngine::stopAnalysisThread()
+{
+    // Returns once no pool worker is inside the pipeline any more
+    if (analysisClientAdded_)
+        scheduler_->remove (*analysisClient_);
+    analysisClientAdded_ = false;
+}
+
+void AnalyzerEngine::setAnalysisPriority (AnalysisScheduler::Priority priority) noexcept
+{
+    analysisClient_->setPriority (priority);
+    multichannel_.setPriority (priority);
+}
 
-void AnalyzerEngine::prepare (double sampleRate, int /* samplesPerBlock */)
+void AnalyzerEngine::prepare (double sampleRate, int samplesPerBlock)
 {
-    currentSampleRate = sampleRate;
+    // The analysis thread owns the FFT state while running: stop it before touching buffers.
+    stopAnalysisThread();
+
+    // Decimating front end: halve only while the requested bandwidth sits inside the flat,
+    // alias-free passband of the stage doing it. Only the last stage is that tight - it gets the
+    // steep design (0.21 x its input rate); earlier stages run at 2x+ the rate and stay cheap.
+    numDecimationStages_ = 0;
+    if (analysisBandwidthRequestedHz_ > 0.0)
+        while (numDecimationStages_ < kMaxDecimationStages
+               && static_cast<double> (HalfbandDecimator::getPassbandEdge (HalfbandDecimator::Response::Steep))
+                      * sampleRate / static_cast<double> (1 << numDecimationStages_) >= analysisBandwidthRequestedHz_)
+            ++numDecimationStages_;
+    
+    for (auto& cascade : decimators_)
+    {
+        for (int stage = 0; stage < kMaxDecimationStages; ++stage)
+        {
+            auto& decimator = cascade[static_cast<std::size_t> (stage)];
+            decimator.setResponse (stage == numDecimationStages_ - 1 ? HalfbandDecimator::Response::Steep
+                                                                     : HalfbandDecimator::Response::Standard);
+            decimator.reset();
+        }
+    }
+    
+    currentSampleRate = sampleRate / static_cast<double> (1 << numDecimationStages_);
     peakHoldEnabled_ = false; // AC1: Ensure enabled on prepare
     
-    // Initialize FFT size (use currentFFTSize, default 2048)
-    initializeFFT (currentFFTSize);
+    // Plan every FFT size and carve all buffers once (no-op after the first prepare)
+    if (arena_ == nullptr)
+        allocateArena();
     
-    // CRITICAL: Keep sequence monotonic - do NOT reset to 0 (prevents UI "blink" detection issues)
-    // Only initialize to 1 if this is the very first prepare (sequence is 0)
-    if (published_.sequence.load (std::memory_order_relaxed) == 0)
-    {
-        published_.sequence.store (1, std::memory_order_relaxed);  // Start at 1, not 0
-    }
-    published_.data.isValid = false;
+    // Reset stream state and select the requested size (RT-safe path, also used for live swaps)
+    fifoWritePos = 0;
+    samplesCollected = 0;
+    silentSamples_ = 0;
+    tracesAtFloor_ = false;
+    silenceIdle_ = false;
+    idleSamplesSinceFrame_ = 0;
+    std::fill (fifoBufferL_.begin(), fifoBufferL_.end(), 0.0f);
+    std::fill (fifoBufferR_.begin(), fifoBufferR_.end(), 0.0f);
+    // Bands/Log matrices depend on the sample rate: rebuild for every size (allocating, prepare only)
+    for (int i = 0; i < kNumFFTSizes; ++i)
+        resamplers_[static_cast<std::size_t> (i)].prepare (currentSampleRate, 1 << (kMinFFTOrder + i));
+    
+    currentOverlap_ = static_cast<Overlap> (requestedOverlap_.load (std::memory_order_relaxed));
+    selectFftOrder (requestedFftOrder_.load (std::memory_order_acquire));
+    
+    // Multi-resolution tiers depend on the sample rate (fixed-size state, no allocation)
+    multiRes_.prepare (currentSampleRate);
+    multiResActive_ = false;
+    applyPendingMultiResolution();
+    
+    // Filter-bank RTA: all resolutions are designed here, switching later is an index swap
+    filterBank_.prepare (currentSampleRate);
+    filterBankActive_ = false;
+    applyPendingFilterBank();
+    
+    // Spectrogram rows are per second of audio, not per hop
+    spectrogram_.prepare (currentSampleRate);
+    
+    // LTAS durations are in samples of the old rate: start over
+    ltas_.reset();
+    
+    // Snapshot transport is NOT reset: the UI keeps showing the last published frame until the
+    // first hop after prepare (prevents "blink" to floor).
+    // M_2026_01_19_PEAK_HOLD_INIT_VALUE_FIX: no stale 0 dB peak arrays - absent traces are not published.
     
     // Initialize smoothing
     // averagingMs_ removed. Ballistics default in header.
     // updateSmoothingCoeff removed.
     
+    // Worker-thread (or bounded inline) mode: ring sized for ~0.5 s (or several host blocks) of
+    // scheduling slack, and at least one 64k offline-render block.
+    // Independent of the FFT size: the ring only queues input, the FIFOs hold the analysis history.
+    useAnalysisThread_ = analysisThreadRequested_;
+    hopBudgetEnabled_ = hopBudgetRequested_;
+    hopBudgetBlockSamples_ = juce::jmax (1, samplesPerBlock) >> numDecimationStages_;
+    hopBudget_ = -1;
+    if (useAnalysisThread_ || hopBudgetEnabled_)
+    {
+        const int ringSize = juce::jmax (8 * juce::jmax (1, samplesPerBlock),
+                                         static_cast<int> (sampleRate * 0.5),
+                                         kMinRingSamples) + 1;
+        analysisRingL_.assign (static_cast<std::size_t> (ringSize), 0.0f);
+        analysisRingR_.assign (static_cast<std::size_t> (ringSize), 0.0f);
+        analysisFifo_.setTotalSize (ringSize);
+        analysisFifo_.reset();
+    }
+    
     prepared = true;
+
+    multichannel_.setFftSize (1 << requestedFftOrder_.load (std::memory_order_relaxed));
+    multichannel_.prepare (sampleRate, samplesPerBlock, numInputChannelsRequested_);
+
+    // Registry full (hundreds of instances): this one analyses inline
+    if (useAnalysisThread_)
+    {
+        analysisClientAdded_ = scheduler_->add (*analysisClient_);
+        useAnalysisThread_ = analysisClientAdded_;
+    }
 }
 
-void AnalyzerEngine::initializeFFT (int fftSize)
+namespace
 {
-    currentFFTSize = fftSize;
-    currentHopSize = fftSize / 4;  // 25% overlap
-    
-    // Create FFT
-    const int fftOrder = static_cast<int> (std::log2 (fftSize));
-    fft = std::make_unique<juce::dsp::FFT> (fftOrder);
-    
-    // Resize buffers
-    const std::size_t fftSizeSz = static_cast<std::size_t> (fftSize);
-    fftOutput.resize (fftSizeSz * 2, 0.0f);
-    window.resize (fftSizeSz, 1.0f);
-    fifoBuffer.resize (fftSizeSz, 0.0f);
-    const int numBins = fftSize / 2 + 1;
-    smoothedMagnitude.resize (static_cast<size_t> (numBins), 0.0f);
+    /** Bump allocator over one block. A pass with base == nullptr only measures the layout. */
+    struct ArenaCarver
+    {
+        static constexpr std::size_t kAlignment = 64;  // Cache line / widest SIMD register
+        
+        char* base = nullptr;
+        std::size_t used = 0;
+        
+        template <typename T>
+        T* take (std::size_t count) noexcept
+        {
+            used = (used + kAlignment - 1) & ~(kAlignment - 1);
+            T* p = (base != nullptr) ? reinterpret_cast<T*> (base + used) : nullptr;
+            used += count * sizeof (T);
+            return p;
+        }
+    };
+}
+
+void AnalyzerEngine::allocateArena()
+{
+    // Message thread (prepare). Everything the hop pipeline touches is carved from ONE block,
+    // sized for the largest FFT, so a size change never allocates.
+    const std::size_t maxSize = static_cast<std::size_t> (kMaxFFTSize);
+    const std::size_t maxBins = static_cast<std::size_t> (kMaxFFTBins);
     
-    // Resize smoothing buffers
-    smoothedMagnitude.resize(static_cast<size_t> (numBins), 0.0f);
-    smoothedPeak.resize(static_cast<size_t> (numBins), 0.0f); // Restored
+    auto carve = [this, maxSize, maxBins] (ArenaCarver& c)
+    {
+        fftInput_.ptr = c.take<juce::dsp::Complex<float>> (maxSize);
+        fftSpectrum_.ptr = c.take<juce::dsp::Complex<float>> (maxSize);
+        fifoBufferL_.ptr = c.take<float> (maxSize * 2);
+        fifoBufferR_.ptr = c.take<float> (maxSize * 2);
+        
+        for (int i = 0; i < kNumFFTSizes; ++i)
+            windows_[static_cast<std::size_t> (i)] = c.take<float> (std::size_t (1) << (kMinFFTOrder + i));
+        
+        for (auto* b : { &freqSmoothed_, &smoothedMagnitude, &smoothedPeak, &powerL_, &powerR_, &powerSide_,
+                         &peakHold, &magnitudes_, &dbValues_, &dbRaw_, &dbInstant_ })
+            b->ptr = c.take<float> (maxBins);
+        
+        prefixSumMag.ptr = c.take<float> (maxBins + 1);
+        smoothLowBounds.ptr = c.take<int> (maxBins);
+        smoothHighBounds.ptr = c.take<int> (maxBins);
+        peakHoldFramesRemaining_.ptr = c.take<int> (maxBins);
+    };
     
-    smoothLowBounds.resize (static_cast<size_t> (numBins), 0);
-    smoothHighBounds.resize (static_cast<size_t> (numBins), 0);
-    updateSmoothingBounds();
-    prefixSumMag.resize (static_cast<size_t> (numBins + 1), 0.0f);
-    
-    peakHold.resize (static_cast<size_t> (numBins), kDbFloor);
-    
-    peakHoldFramesRemaining_.resize (static_cast<size_t> (numBins), 0);
-    
-    // Resize per-frame computation buffers (eliminates allocations in computeFFT)
-    magnitudes_.resize (static_cast<size_t> (numBins), 0.0f);
-    dbValues_.resize (static_cast<size_t> (numBins), 0.0f);
-    dbRaw_.resize (static_cast<size_t> (numBins), 0.0f);
-    dbInstant_.resize (static_cast<size_t> (numBins), 0.0f);
-    
-    // Multi-trace: Preallocate L/R-channel FIFOs
-    fifoBufferL_.resize (fftSizeSz, 0.0f);
-    fifoWritePosL_ = 0;
-    samplesCollectedL_ = 0;
-    
-    fifoBufferR_.resize (fftSizeSz, 0.0f);
-    fifoWritePosR_ = 0;
-    samplesCollectedR_ = 0;
-    
-    // Multi-trace: Preallocate power spectrum buffers for all 5 traces
-    const size_t numBinsSz = static_cast<size_t>(numBins);
-    powerL_.resize (numBinsSz, 0.0f);
-    powerR_.resize (numBinsSz, 0.0f);
-    powerMono_.resize (numBinsSz, 0.0f);
-    powerMid_.resize (numBinsSz, 0.0f);
-    powerSide_.resize (numBinsSz, 0.0f);
-    
-    // Multi-trace: Preallocate smoothed buffers
-    smoothedL_.resize (numBinsSz, 0.0f);
-    smoothedR_.resize (numBinsSz, 0.0f);
-    smoothedMono_.resize (numBinsSz, 0.0f);
-    smoothedMid_.resize (numBinsSz, 0.0f);
-    smoothedSide_.resize (numBinsSz, 0.0f);
-    
-    // Multi-trace: Preallocate peak buffers
-    peakL_.resize (numBinsSz, kDbFloor);
-    peakR_.resize (numBinsSz, kDbFloor);
-    peakMono_.resize (numBinsSz, kDbFloor);
-    peakMid_.resize (numBinsSz, kDbFloor);
-    peakSide_.resize (numBinsSz, kDbFloor);
-    
-    
-    // Initialize window (Hann)
+    ArenaCarver measure;
+    carve (measure);
+    arenaBytes_ = measure.used + ArenaCarver::kAlignment;
+    arena_.calloc (arenaBytes_);
+    
+    const auto raw = reinterpret_cast<std::uintptr_t> (arena_.get());
+    const auto aligned = (raw + ArenaCarver::kAlignment - 1) & ~(std::uintptr_t (ArenaCarver::kAlignment - 1));
+    ArenaCarver carver;
+    carver.base = arena_.get() + (aligned - raw);
+    carve (carver);
+    
+    fifoBufferL_.count = maxSize * 2;
+    fifoBufferR_.count = maxSize * 2;
+    
+    // Plan every size + its Hann window
     const float pi = juce::MathConstants<float>::pi;
-    for (int i = 0; i < fftSize; ++i)
+    for (int i = 0; i < kNumFFTSizes; ++i)
     {
-        const std::size_t idx = static_cast<std::size_t> (i);
-        window[idx] = 0.5f * (1.0f - std::cos (2.0f * pi * static_cast<float> (i) / static_cast<float> (fftSize - 1)));
+        const int order = kMinFFTOrder + i;
+        const int size = 1 << order;
+        fftPlans_[static_cast<std::size_t> (i)] = std::make_unique<juce::dsp::FFT> (order);
+        
+        float* w = windows_[static_cast<std::size_t> (i)];
+        for (int n = 0; n < size; ++n)
+            w[n] = 0.5f * (1.0f - std::cos (2.0f * pi * static_cast<float> (n) / static_cast<float> (size - 1)));
     }
+}
+
+void AnalyzerEngine::selectFftOrder (int fftOrder)
+{
+    // RT-safe: pointer/index swap + O(bins) state reset, no allocation.
+    fftOrder = juce::jlimit (kMinFFTOrder, kMaxFFTOrder, fftOrder);
+    const std::size_t planIndex = static_cast<std::size_t> (fftOrder - kMinFFTOrder);
     
-    // Reset state
-    fifoWritePos = 0;
-    samplesCollected = 0;
-    std::fill (fifoBuffer.begin(), fifoBuffer.end(), 0.0f);
-    std::fill (fftOutput.begin(), fftOutput.end(), 0.0f);
+    currentFFTOrder = fftOrder;
+    currentFFTSize = 1 << fftOrder;
+    fft = fftPlans_[planIndex].get();
+    window = windows_[planIndex];
+    resampler_ = &resamplers_[planIndex];
+    
+    const std::size_t fftSizeSz = static_cast<std::size_t> (currentFFTSize);
+    const std::size_t numBinsSz = fftSizeSz / 2 + 1;
+    fftInput_.count = fftSizeSz;
+    fftSpectrum_.count = fftSizeSz;
+    
+    for (auto* b : { &freqSmoothed_, &smoothedMagnitude, &smoothedPeak, &powerL_, &powerR_, &powerSide_,
+                     &peakHold, &magnitudes_, &dbValues_, &dbRaw_, &dbInstant_ })
+        b->count = numBinsSz;
+    
+    prefixSumMag.count = numBinsSz + 1;
+    smoothLowBounds.count = numBinsSz;
+    smoothHighBounds.count = numBinsSz;
+    peakHoldFramesRemaining_.count = numBinsSz;
+    
+    // Bin layout changed: restart per-bin state. Ballistics are seeded from the first frame
+    // at the new size (no dip to floor), and the mirrored FIFO keeps full history.
     std::fill (smoothedMagnitude.begin(), smoothedMagnitude.end(), 0.0f);
-    resetPeaks();
-    
-    // Safety guard: ensure numBins doesn't exceed array capacity
-    jassert (numBins <= static_cast<int> (published_.data.fftDb.size()));
-    jassert (numBins <= static_cast<int> (published_.data.fftPeakDb.size()));
-    
-    // CRITICAL: Mark snapshot as invalid on FFT size change to prevent "blink to floor"
-    // Only publish valid snapshots after first real FFT computation
-    // Do NOT fill arrays to floor here - UI will hold last valid frame
-    published_.data.isValid = false;
-    published_.data.fftSize = fftSize;
-    published_.data.numBins = numBins;
-    published_.data.fftBinCount = numBins;
-    
-    // M_2026_01_19_PEAK_HOLD_INIT_VALUE_FIX: Explicitly initialize snapshot peak arrays to floor
-    // AnalyzerSnapshot uses std::array which defaults to 0.0f, causing startup glitch (-0dB white line).
-    std::fill (stagingSnapshot_.fftPeakDb.begin(), stagingSnapshot_.fftPeakDb.end(), kDbFloor);
-    std::fill (stagingSnapshot_.fftPeakHoldDb.begin(), stagingSnapshot_.fftPeakHoldDb.end(), kDbFloor);
-    
-    std::fill (stagingSnapshot_.fftPeakDbL.begin(), stagingSnapshot_.fftPeakDbL.end(), kDbFloor);
-    std::fill (stagingSnapshot_.fftPeakDbR.begin(), stagingSnapshot_.fftPeakDbR.end(), kDbFloor);
-    std::fill (stagingSnapshot_.fftPeakDbMono.begin(), stagingSnapshot_.fftPeakDbMono.end(), kDbFloor);
-    std::fill (stagingSnapshot_.fftPeakDbMid.begin(), stagingSnapshot_.fftPeakDbMid.end(), kDbFloor);
-    std::fill (stagingSnapshot_.fftPeakDbSide.begin(), stagingSnapshot_.fftPeakDbSide.end(), kDbFloor);
-    
-    std::fill (stagingSnapshot_.fftPeakHoldDbL.begin(), stagingSnapshot_.fftPeakHoldDbL.end(), kDbFloor);
-    std::fill (stagingSnapshot_.fftPeakHoldDbR.begin(), stagingSnapshot_.fftPeakHoldDbR.end(), kDbFloor);
-    std::fill (stagingSnapshot_.fftPeakHoldDbMono.begin(), stagingSnapshot_.fftPeakHoldDbMono.end(), kDbFloor);
-    std::fill (stagingSnapshot_.fftPeakHoldDbMid.begin(), stagingSnapshot_.fftPeakHoldDbMid.end(), kDbFloor);
-    std::fill (stagingSnapshot_.fftPeakHoldDbSide.begin(), stagingSnapshot_.fftPeakHoldDbSide.end(), kDbFloor);
+    std::fill (smoothedPeak.begin(), smoothedPeak.end(), 0.0f);
+    seedBallistics_ = true;
+    updateSmoothingBounds();
+    clearPeakState();
+    
+    updateHopSize();
+}
+
+void AnalyzerEngine::updateHopSize()
+{
+    // Ballistics and peak decay are derived from the hop duration every frame, so a hop change
+    // needs no per-bin reset - the time constants stay the same, only the frame rate moves.
+    switch (currentOverlap_)
+    {
+        case Overlap::None:          currentHopSize = currentFFTSize;     break;
+        case Overlap::Half:          currentHopSize = currentFFTSize / 2; break;
+        case Overlap::SevenEighths:  currentHopSize = currentFFTSize / 8; break;
+        case Overlap::Auto:
+        {
+            // One frame per UI refresh; never sparser than no overlap, never denser than 87.5%
+            const int targetHop = static_cast<int> (currentSampleRate / kAutoTargetFrameRateHz);
+            currentHopSize = juce::jlimit (currentFFTSize / 8, currentFFTSize, targetHop);
+            break;
+        }
+        case Overlap::ThreeQuarter:
+        default:                     currentHopSize = currentFFTSize / 4; break;
+    }
+    
+    // Keep the hop counter inside the new hop so the next chunk length stays positive
+    samplesCollected = juce::jmin (samplesCollected, currentHopSize - 1);
+}
+
+void AnalyzerEngine::applyPendingFftSize()
+{
+    // Analysis context (audio thread inline, or analysis thread). RT-safe.
+    const int requested = requestedFftOrder_.load (std::memory_order_acquire);
+    if (requested != currentFFTOrder)
+        selectFftOrder (requested);
+    
+    const auto overlap = static_cast<Overlap> (requestedOverlap_.load (std::memory_order_relaxed));
+    if (overlap != currentOverlap_)
+    {
+        currentOverlap_ = overlap;
+        updateHopSize();
+    }
+}
+
+void AnalyzerEngine::applyPendingMultiResolution()
+{
+    // Analysis context. RT-safe: enabling restarts the tiers so no stale frame is stitched in.
+    const bool requested = multiResRequested_.load (std::memory_order_relaxed);
+    if (requested == multiResActive_)
+        return;
+    
+    multiResActive_ = requested;
+    if (multiResActive_)
+    {
+        multiRes_.reset();
+        seedMultiRes_ = true;
+    }
+}
+
+void AnalyzerEngine::applyPendingFilterBank()
+{
+    // Analysis context. RT-safe: enabling or changing the resolution restarts the bank's filters
+    if (! filterBankRequested_.load (std::memory_order_relaxed))
+    {
+        filterBankActive_ = false;
+        return;
+    }
+    
+    const int bandsPerOctave = requestedBandsPerOctave_.load (std::memory_order_relaxed);
+    if (filterBankActive_ && bandsPerOctave == filterBank_.getBandsPerOctave())
+        return;
+    
+    filterBank_.setBandsPerOctave (bandsPerOctave);
+    filterBank_.reset();
+    filterBankActive_ = true;
+    seedFilterBank_ = true;
 }
 
 void AnalyzerEngine::reset()
 {
+    stopAnalysisThread();
+    multichannel_.release();
     prepared = false;
-    fft.reset();
     fifoWritePos = 0;
     samplesCollected = 0;
-    fftOutput.clear();
-    window.clear();
-    fifoBuffer.clear();
-    fifoBuffer.clear();
-    smoothedMagnitude.clear();
-    smoothedPeak.clear(); // Restored
-    peakHold.clear();
-    magnitudes_.clear();
-    dbValues_.clear();
-    dbRaw_.clear();
-    dbInstant_.clear();
+    // Arena and FFT plans stay allocated: the next prepare() reuses them.
 }
 
 void AnalyzerEngine::processBlock (const juce::AudioBuffer<float>& buffer)
 {
-    if (!prepared || fft == nullptr)
+    if (!prepared)
         return;
     
     const int numSamples = buffer.getNumSamples();
@@ -181,107 +367,300 @@ void AnalyzerEngine::processBlock (const juce::AudioBuffer<float>& buffer)
     if (numChannels == 0)
         return;
     
-    // Mono sum (or use left channel if mono)
-    const float* inputChannel = buffer.getReadPointer (0);
+    // Mono input duplicates L into R so the packed transform still yields valid L/R/Mid/Side
+    const float* left = buffer.getReadPointer (0);
+    const float* right = (numChannels > 1) ? buffer.getReadPointer (1) : left;
     
-    // Accumulate into FIFO buffer
-    for (int i = 0; i < numSamples; ++i)
+    if (useAnalysisThread_)
     {
-        const float sampleL = inputChannel[i];
-        const float sampleR = (numChannels > 1) ? buffer.getReadPointer (1)[i] : sampleL;
-        const float sampleMono = (sampleL + sampleR) * 0.5f;
-        
-        // 1. Mono Sum FIFO (Legacy)
-        fifoBuffer[static_cast<std::size_t> (fifoWritePos)] = sampleMono;
-        fifoWritePos = (fifoWritePos + 1) % currentFFTSize;
-        samplesCollected++;
-
-        // 2. Multi-trace True L/R FIFOs
-        if (enableMultiTrace_ && numChannels > 1)
+        // Worker mode: wait-free SPSC push only, the analysis thread does the rest.
+        pushToAnalysisRing (left, right, numSamples);
+    }
+    else if (fft != nullptr)
+    {
+        if (hopBudgetEnabled_)
+        {
+            // Bounded: queue first, then analyse what this callback's budget allows; the rest
+            // stays in the ring for the next callback
+            pushToAnalysisRing (left, right, numSamples);
+            drainAnalysisFifo();
+        }
+        else
         {
-            // L FIFO
-            fifoBufferL_[static_cast<std::size_t>(fifoWritePosL_)] = sampleL;
-            fifoWritePosL_ = (fifoWritePosL_ + 1) % currentFFTSize;
-            samplesCollectedL_++;
-
-            // R FIFO
-            fifoBufferR_[static_cast<std::size_t>(fifoWritePosR_)] = sampleR;
-            fifoWritePosR_ = (fifoWritePosR_ + 1) % currentFFTSize;
-            samplesCollectedR_++;
+            processSamples (left, right, numSamples);
         }
+    }
+
+    // Push samples to Stereo Scope (Audio thread lock-free), only while a scope displays them
+    if (hasConsumer (Product::StereoScope))
+        stereoScopeAnalyzer.pushSamples (left, right, numSamples);
+}
+
+void AnalyzerEngine::beginCallback() noexcept
+{
+    // Pool mode never budgets (hopBudget_ belongs to the worker then), lockstep inline stays unlimited
+    if (hopBudgetEnabled_ && ! useAnalysisThread_)
+        hopBudget_ = kHopBudgetHeadroom * (hopBudgetBlockSamples_ / juce::jmax (1, currentHopSize) + 1);
+}
+
+void AnalyzerEngine::pushToAnalysisRing (const float* left, const float* right, int numSamples) noexcept
+{
+    // Own stage: in worker mode FifoFill is written by the pool, and every stage has one writer
+    StageProfiler::Scope profile (profiler_, StageProfiler::Stage::RingPush);
+    int start1 = 0, size1 = 0, start2 = 0, size2 = 0;
+    analysisFifo_.prepareToWrite (numSamples, start1, size1, start2, size2);
+    
+    if (size1 > 0)
+    {
+        juce::FloatVectorOperations::copy (analysisRingL_.data() + start1, left, size1);
+        juce::FloatVectorOperations::copy (analysisRingR_.data() + start1, right, size1);
+    }
+    if (size2 > 0)
+    {
+        juce::FloatVectorOperations::copy (analysisRingL_.data() + start2, left + size1, size2);
+        juce::FloatVectorOperations::copy (analysisRingR_.data() + start2, right + size1, size2);
+    }
+    
+    analysisFifo_.finishedWrite (size1 + size2);
+    
+    if (size1 + size2 < numSamples)
+        analysisOverruns_.fetch_add (1, std::memory_order_relaxed);
+}
+
+int AnalyzerEngine::processSamples (const float* left, const float* right, int numSamples)
+{
+    // Fixed-size passes. The hop budget is checked between passes, so a bounded callback stops
+    // at most one pass past its budget and the caller keeps the unconsumed samples queued.
+    // Decimating front end: each pass runs through the halfband cascades (first stage out of the
+    // input, the rest in place). Both channels always run so their decimation phases stay
+    // aligned; mono input simply feeds the same samples twice.
+    int offset = 0;
+    while (offset < numSamples && hopBudget_ != 0)
+    {
+        const int numIn = juce::jmin (kDecimationChunk, numSamples - offset);
         
-        // When we have enough samples, compute FFT
-        if (samplesCollected >= currentHopSize)
+        if (numDecimationStages_ == 0)
         {
-            samplesCollected = 0;
+            processAnalysisRateSamples (left + offset, right + offset, numIn);
+        }
+        else
+        {
+            const float* inputs[] = { left + offset, right + offset };
+            int numOut = 0;
             
-            if (!enableMultiTrace_)
+            for (std::size_t ch = 0; ch < 2; ++ch)
             {
-                // Legacy path: single FFT on mono mix
-                computeFFT();
+                auto& cascade = decimators_[ch];
+                float* out = decimated_[ch].data();
+                int n = cascade[0].process (inputs[ch], out, numIn);
+                for (int stage = 1; stage < numDecimationStages_; ++stage)
+                    n = cascade[static_cast<std::size_t> (stage)].process (out, out, n);
+                numOut = n;
             }
-            else
+            
+            if (numOut > 0)
+                processAnalysisRateSamples (decimated_[0].data(), decimated_[1].data(), numOut);
+        }
+        
+        offset += numIn;
+    }
+    
+    return offset;
+}
+
+void AnalyzerEngine::processAnalysisRateSamples (const float* left, const float* right, int numSamples)
+{
+    // Accumulate into the L/R FIFOs in hop-bounded chunks (bulk copies, no per-sample wrap).
+    // Hops are counted in samples, so frame positions do not depend on how the host
+    // (or the worker ring) partitions the stream.
+    int offset = 0;
+    while (offset < numSamples)
+    {
+        // FFT size change requested? Swap to the preplanned engine (RT-safe, no blackout)
+        applyPendingFftSize();
+        applyPendingMultiResolution();
+        applyPendingFilterBank();
+        
+        const int chunk = juce::jmin (numSamples - offset, currentHopSize - samplesCollected);
+        const int64_t fifoStart = profileBegin();
+        appendToFifo (left + offset, right + offset, chunk);
+        profileEnd (StageProfiler::Stage::FifoFill, fifoStart);
+        
+        // Silence detection (exits at the first audible vector, so live audio costs almost nothing)
+        if (AnalyzerPro::dsp::SpectrumKernels::isSilent (left + offset, chunk, kSilenceThreshold)
+            && (right == left || AnalyzerPro::dsp::SpectrumKernels::isSilent (right + offset, chunk, kSilenceThreshold)))
+        {
+            silentSamples_ += chunk;
+        }
+        else
+        {
+            silentSamples_ = 0;
+            tracesAtFloor_ = false;
+            if (silenceIdle_)
             {
-                // Multi-trace path: compute L and R FFTs
-                const int numBins = currentFFTSize / 2 + 1;
-                
-                // L channel: Use fifoBufferL_
-                samplesCollectedL_ = 0;
-                applyWindow(fifoBufferL_, fifoWritePosL_);
-                fft->performRealOnlyForwardTransform (fftOutput.data(), false);
-                extractMagnitudes(powerL_.data(), numBins);
-                
-                // R channel: Use fifoBufferR_
-                if (numChannels > 1)
-                {
-                    samplesCollectedR_ = 0;
-                    applyWindow(fifoBufferR_, fifoWritePosR_);
-                    fft->performRealOnlyForwardTransform (fftOutput.data(), false);
-                    extractMagnitudes(powerR_.data(), numBins);
-                }
-                
-                // Finally, do the Legacy FFT (Mono) to populate fftDb for the main traces
-                computeFFT();
+                // Signal is back. The ballistics were left at the floor snapshot, so they attack from
+                // there exactly as if every silent hop had run; the side analysers were not fed while
+                // idle and restart from silence (which is what their history held).
+                silenceIdle_ = false;
+                multiRes_.reset();
+                filterBank_.reset();
             }
         }
+        
+        // Multi-res tiers run their own hops; feeding them per chunk keeps them in step with the main FFT
+        // (they only feed snapshot traces: skipped while nobody consumes the spectrum or while idle on silence)
+        if ((multiResActive_ || filterBankActive_) && hasConsumer (Product::Spectrum) && ! silenceIdle_)
+        {
+            StageProfiler::Scope profile (profiler_, StageProfiler::Stage::SideAnalysers);
+            if (multiResActive_)
+                multiRes_.process (left + offset, right + offset, chunk);
+            if (filterBankActive_)
+                filterBank_.process (left + offset, right + offset, chunk);
+        }
+        samplesCollected += chunk;
+        offset += chunk;
+        
+        // When we have enough samples, compute FFT (single packed transform for both channels)
+        if (samplesCollected >= currentHopSize)
+        {
+            samplesCollected = 0;
+            computeFFT();
+            
+            if (hopBudget_ > 0)
+                --hopBudget_;
+        }
     }
+}
 
-    // Push samples to Stereo Scope (Audio thread lock-free)
-    const float* left = buffer.getReadPointer (0);
-    const float* right = (numChannels > 1) ? buffer.getReadPointer (1) : left;
-    stereoScopeAnalyzer.pushSamples (left, right, numSamples);
+bool AnalyzerEngine::drainAnalysisFifo()
+{
+    const int ready = analysisFifo_.getNumReady();
+    if (ready <= 0 || fft == nullptr)
+        return false;
+    
+    int start1 = 0, size1 = 0, start2 = 0, size2 = 0;
+    analysisFifo_.prepareToRead (ready, start1, size1, start2, size2);
+    
+    // Only what was consumed is released: a spent hop budget leaves the rest for the next callback
+    int consumed = 0;
+    if (size1 > 0)
+        consumed = processSamples (analysisRingL_.data() + start1, analysisRingR_.data() + start1, size1);
+    if (size2 > 0 && consumed == size1)
+        consumed += processSamples (analysisRingL_.data() + start2, analysisRingR_.data() + start2, size2);
+    
+    analysisFifo_.finishedRead (consumed);
+    return consumed > 0;
 }
 
 void AnalyzerEngine::computeFFT()
 {
-    // If a resize is pending, hold publishing until the resize is applied on the message thread.
-    if (fftResizeRequested_.load (std::memory_order_acquire))
-        return;
-
     if (!prepared || fft == nullptr || currentFFTSize == 0)
         return;
     
-    // Apply window and write directly to FFT output buffer
-    applyWindow(fifoBuffer, fifoWritePos);
+    // Apply deferred parameter changes here so only the analysis context touches the buffers
+    const bool peaksReset = peakResetRequested_.exchange (false, std::memory_order_acq_rel);
+    if (peaksReset)
+        clearPeakState();
     
-    // Perform real-only forward FFT (fftOutput now contains valid time-domain samples)
-    fft->performRealOnlyForwardTransform (fftOutput.data(), false);
+    enableMultiTrace_ = multiTraceRequested_.load (std::memory_order_relaxed);
+    
+    const float requestedOctaves = requestedSmoothingOctaves_.load (std::memory_order_relaxed);
+    if (std::abs (smoothingOctaves_ - requestedOctaves) >= 1e-4f)
+    {
+        smoothingOctaves_ = requestedOctaves;
+        updateSmoothingBounds();
+    }
+    
+    // Consumer gating: products nobody reads are skipped. The FIFOs are always filled, so the
+    // first hop after a consumer registers transforms a complete, current frame.
+    const bool spectrumWanted = hasConsumer (Product::Spectrum);
+    const bool spectrogramWanted = hasConsumer (Product::Spectrogram);
+    const bool ltasActive = ltasRequested_.load (std::memory_order_relaxed);   // Integrates: keeps running
+    
+    if (! spectrumWanted)
+        spectrumGated_ = true;
+    
+    if (! spectrumWanted && ! spectrogramWanted && ! ltasActive)
+        return;
+    
+    // Digital silence: once the whole window is silent and the traces have decayed to the floor
+    // (or kSilenceIdleMaxSeconds have passed), one last frame runs with seeded ballistics - a floor
+    // snapshot - and the transform stops. The FIFOs keep filling, so the first hop with signal
+    // transforms a correct window. While idle, spectrogram rows and LTAS weights still advance
+    // (both are time axes), and a frame still runs when something needs a fresh snapshot
+    // (size swap, peak reset, new consumer). With LTAS on, a full frame also runs every
+    // kSilenceLtasRefreshSeconds, so the published average and span keep up with the silence
+    // diluting them. Peak hold keeps its last value between those frames.
+    const bool ltasRefreshDue = ltasActive
+                             && idleSamplesSinceFrame_ + currentHopSize > static_cast<int64_t> (kSilenceLtasRefreshSeconds * currentSampleRate);
+    
+    if (silenceIdle_ && ! seedBallistics_ && ! peaksReset && ! (spectrumWanted && spectrumGated_) && ! ltasRefreshDue)
+    {
+        idleSamplesSinceFrame_ += currentHopSize;
+        
+        if (spectrogramWanted)
+        {
+            spectrogramRow_.fill (kDbFloor);
+            spectrogram_.addFrame (spectrogramRow_.data(), currentHopSize);
+        }
+        
+        if (ltasResetRequested_.exchange (false, std::memory_order_acq_rel))
+            ltas_.reset();
+        
+        if (ltasActive)
+            ltas_.addSilentFrame (currentFFTSize / 2 + 1, currentHopSize);
+        
+        return;
+    }
+    
+    idleSamplesSinceFrame_ = 0;
+    
+    const int64_t silentAfterWindow = silentSamples_ - currentFFTSize;
+    if (! silenceIdle_ && silentAfterWindow >= 0
+        && (tracesAtFloor_ || silentAfterWindow >= static_cast<int64_t> (kSilenceIdleMaxSeconds * currentSampleRate)))
+    {
+        silenceIdle_ = true;
+        seedBallistics_ = true;
+        seedFilterBank_ = true;
+        seedMultiRes_ = true;
+    }
+    
+    // One complex FFT for both channels: fills powerL_/powerR_/powerSide_ and magnitudes_ (Mono/Mid)
+    const int64_t fftStart = profileBegin();
+    performStereoFFT();
+    profileEnd (StageProfiler::Stage::Fft, fftStart);
+    const int64_t smoothingStart = profileBegin();
     
-    // Compute magnitudes and convert to dB
     const int numBins = currentFFTSize / 2 + 1;
     
-    // Extract power spectrum using helper (same math, now reusable for dual-FFT)
-    extractMagnitudes(magnitudes_.data(), numBins);
+    // Spectrogram takes the raw frame (no frequency smoothing or ballistics: the history IS the time axis)
+    if (spectrogramWanted)
+        writeSpectrogramRow();
+    
+    // LTAS also averages the raw frame (its own reset, untouched by peak hold / ballistics)
+    if (ltasResetRequested_.exchange (false, std::memory_order_acq_rel))
+        ltas_.reset();
+    
+    if (ltasActive)
+        accumulateLtas (numBins);
+    
+    if (! spectrumWanted)
+        return;
+    
+    if (spectrumGated_)
+    {
+        // Resuming: start every ballistic at this frame instead of the state from before the gap
+        spectrumGated_ = false;
+        seedBallistics_ = true;
+        seedFilterBank_ = true;
+        seedMultiRes_ = true;
+    }
     
     // -------------------------------------------------------------------------
     // Frequency Smoothing (Fractional Octave) - Applied to POWER
     // -------------------------------------------------------------------------
-    // -------------------------------------------------------------------------
-    // Frequency Smoothing (Fractional Octave) - Applied to POWER
-    // -------------------------------------------------------------------------
-    // We reuse fftOutput as a scratch buffer for spectrally smoothed power.
-    // This serves as the "Instantaneous Smoothed Power" (pre-ballistics).
-    float* freqSmoothed = fftOutput.data();
+    // freqSmoothed_ holds the "Instantaneous Smoothed Power" (pre-ballistics).
+    float* freqSmoothed = freqSmoothed_.data();
     
     int binsProcessed = 0;
     int binsFilled = 0;
@@ -290,9 +669,6 @@ void AnalyzerEngine::computeFFT()
     if (smoothingOctaves_ > 0.0f && static_cast<int>(smoothLowBounds.size()) == numBins)
     {
         // 1. Compute Prefix Sum of magnitudes (Power) (O(N))
-        if(static_cast<int>(prefixSumMag.size()) != numBins + 1)
-             prefixSumMag.resize(static_cast<std::size_t>(numBins + 1), 0.0f);
-
         prefixSumMag[0] = 0.0f;
         for (int i = 0; i < numBins; ++i)
         {
@@ -341,9 +717,13 @@ void AnalyzerEngine::computeFFT()
     };
 
     const float rmsAttCoeff = calcCoeff(rmsAttackMs_);
-    const float rmsRelCoeff = calcCoeff(rmsReleaseMs_);
+    const float rmsRelCoeff = calcCoeff(rmsReleaseMs_.load (std::memory_order_relaxed));
     const float peakAttCoeff = calcCoeff(peakAttackMs_);
-    const float peakRelCoeff = calcCoeff(peakReleaseMs_);
+    const float peakRelCoeff = calcCoeff(peakReleaseMs_.load (std::memory_order_relaxed));
+
+    // First frame after prepare/size swap: start the ballistics at the input (no ramp up from zero)
+    const bool seed = seedBallistics_;
+    seedBallistics_ = false;
 
     for (int i = 0; i < numBins; ++i)
     {
@@ -352,7 +732,7 @@ void AnalyzerEngine::computeFFT()
 
         // RMS Ballistics
         float& rmsState = smoothedMagnitude[idx];
-        const float rmsCoeff = (inputPower > rmsState) ? rmsAttCoeff : rmsRelCoeff;
+        const float rmsCoeff = seed ? 0.0f : ((inputPower > rmsState) ? rmsAttCoeff : rmsRelCoeff);
         rmsState = rmsCoeff * rmsState + (1.0f - rmsCoeff) * inputPower;
 
         // Peak Ballistics (M_2026_01_19_PEAK_MAXIMUM_ENVELOPE)
@@ -366,7 +746,7 @@ void AnalyzerEngine::computeFFT()
         }
         
         float& peakState = smoothedPeak[idx];
-        const float peakCoeff = (maxPower > peakState) ? peakAttCoeff : peakRelCoeff;
+        const float peakCoeff = seed ? 0.0f : ((maxPower > peakState) ? peakAttCoeff : peakRelCoeff);
         peakState = peakCoeff * peakState + (1.0f - peakCoeff) * maxPower;
     }
     
@@ -375,21 +755,20 @@ void AnalyzerEngine::computeFFT()
     static uint32_t smoothDebugCounter = 0;
     if ((++smoothDebugCounter % 100) == 0)
     {
-        DBG ("FFT Smoothing: oct=" << smoothingOctaves_ << " rmsAtt=" << rmsAttackMs_ << " rmsRel=" << rmsReleaseMs_);
+        DBG ("FFT Smoothing: oct=" << smoothingOctaves_ << " rmsAtt=" << rmsAttackMs_ << " rmsRel=" << rmsReleaseMs_.load());
     }
 #endif
     
-    // Convert Time-Smoothed POWER to dB for display (Main Trace / RMS)
-    convertToDb (smoothedMagnitude.data(), dbValues_.data(), numBins);
-    
-    // Convert Fast-Peak Smoothed POWER to dB (Ballistic Peak Trace)
-    // Feeds into the Peak Hold logic for decay tracking AND Display
-    convertToDb (smoothedPeak.data(), dbRaw_.data(), numBins);
-    // std::copy(dbInstant_.begin(), dbInstant_.end(), dbRaw_.begin()); // Removed instant copy
-    
-    // Peak Pipeline: Calculate Instantaneous dB from RAW magnitudes (no octave smoothing)
-    // This ensures Peak latches the TRUE session max, independent from RMS smoothing.
-    convertToDb (magnitudes_.data(), dbInstant_.data(), numBins);
+    // POWER -> dB for all three traces in ONE vectorised pass:
+    //  - Time-Smoothed power -> dbValues_ (Main Trace / RMS)
+    //  - Fast-Peak Smoothed power -> dbRaw_ (Ballistic Peak: feeds Peak Hold decay tracking AND Display)
+    //  - RAW magnitudes (no octave smoothing) -> dbInstant_, so Peak latches the TRUE session max,
+    //    independent from RMS smoothing.
+    {
+        const float* powers[] = { smoothedMagnitude.data(), smoothedPeak.data(), magnitudes_.data() };
+        float* dbs[] = { dbValues_.data(), dbRaw_.data(), dbInstant_.data() };
+        AnalyzerPro::dsp::SpectrumKernels::powerToDb (powers, dbs, 3, numBins, kDbFloor);
+    }
     
     // Update peak hold
     // Pass dbInstant_ for Latching, dbRaw_ for Release tracking
@@ -445,33 +824,16 @@ void AnalyzerEngine::computeFFT()
     }
 
     // SANITIZATION (Fix 2: HF Spikes / NaN / Overflow protection)
-    // Ensure no invalid values leak into the snapshot
-    // SANITIZATION (Fix 2: HF Spikes / NaN / Overflow protection)
-    // Ensure no invalid values leak into the snapshot
-    for (std::size_t i = 0; i < numBinsSz; ++i)
-    {
-        // Clamp Peak Hold
-        if (!std::isfinite(peakHold[i])) 
-            peakHold[i] = kDbFloor;
-        else
-            peakHold[i] = juce::jlimit(kDbFloor, 12.0f, peakHold[i]);
-
-        // Clamp Ballistic Peak (dbRaw_)
-        if (!std::isfinite(dbRaw_[i])) 
-            dbRaw_[i] = kDbFloor;
-        else
-            dbRaw_[i] = juce::jlimit(kDbFloor, 12.0f, dbRaw_[i]);
-            
-        // Clamp RMS (dbValues_)
-        if (!std::isfinite(dbValues_[i])) 
-            dbValues_[i] = kDbFloor;
-        else
-            dbValues_[i] = juce::jlimit(kDbFloor, 12.0f, dbValues_[i]);
-    }
+    // Ensure no invalid values leak into the snapshot: NaN -> floor, +/-inf and overflow clamp to [floor, +12 dB]
+    for (auto* trace : { &peakHold, &dbRaw_, &dbValues_ })
+        AnalyzerPro::dsp::SpectrumKernels::sanitizeDb (trace->data(), numBins, kDbFloor, 12.0f);
 
-    // Use pre-allocated staging snapshot to prevent stack overflow (AC5, AC7)
+    profileEnd (StageProfiler::Stage::Smoothing, smoothingStart);
+    const int64_t publishStart = profileBegin();
+    
+    // Fill the triple buffer's back slot in place (preallocated, never on the stack: AC5, AC7)
     // Ref: M_2026_01_19_PEAK_HOLD_PROFESSIONAL_BEHAVIOR_RETRY
-    AnalyzerSnapshot& snapshot = stagingSnapshot_; 
+    AnalyzerSnapshot& snapshot = snapshots_.getWriteSlot();
     
     snapshot.fftBinCount = numBins;
     snapshot.numBins = 0; // Legacy
@@ -481,43 +843,78 @@ void AnalyzerEngine::computeFFT()
     snapshot.displayTopDb = 0.0f;
     snapshot.isValid = true;
     snapshot.isHoldOn = freezePeaks_.load (std::memory_order_relaxed);
+    snapshot.ltasFrameCount = 0;
+    snapshot.ltasDurationSec = 0.0;
+    snapshot.ltasBinDurationSec = 0.0;
+    
+    // Packed SoA layout: only the traces produced this frame, each numBins long
+    using Trace = AnalyzerSnapshot::Trace;
+    jassert (numBins <= static_cast<int> (AnalyzerSnapshot::kMaxFFTBins));  // Hard runtime check
+    snapshot.resetLayout();
     
-    // Safety guard: ensure numBins doesn't exceed array capacity
-    jassert (numBins <= static_cast<int> (snapshot.fftDb.size()));
-    jassert (numBins <= static_cast<int> (snapshot.fftPeakDb.size()));
+    float* outDb = snapshot.addTrace (Trace::FftDb, numBins);
+    float* outPeakDb = snapshot.addTrace (Trace::FftPeakDb, numBins);
+    float* outPeakHoldDb = (peakHoldEnabled_ && peakHoldMode_ != PeakHoldMode::Off)
+                               ? snapshot.addTrace (Trace::FftPeakHoldDb, numBins)
+                               : nullptr;
+    
+    if (outDb == nullptr || outPeakDb == nullptr)
+    {
+        jassertfalse;  // Snapshot storage not reserved (prepare() not called?)
+        return;
+    }
     
     // Copy dB values with floor clamping (-120.0f floor for dB values)
-    // CRITICAL: Use copyBins to prevent OOB writes
     constexpr float dbFloor = -120.0f;
-    const int maxBins = static_cast<int> (snapshot.fftDb.size());
-    const int copyBins = juce::jmin (numBins, maxBins);
-    jassert (numBins <= static_cast<int> (AnalyzerSnapshot::kMaxFFTBins));  // Hard runtime check
     
-    for (int i = 0; i < copyBins; ++i)
+    for (int i = 0; i < numBins; ++i)
     {
         const std::size_t idx = static_cast<std::size_t> (i);
-        snapshot.fftDb[idx] = juce::jmax (dbFloor, dbValues_[idx]);
+        outDb[i] = juce::jmax (dbFloor, dbValues_[idx]);
         
         // Populate snapshot with Ballistic Peak (dbRaw_)
         // Previously used peakHold, now peakHold is separate
-        snapshot.fftPeakDb[idx] = juce::jmax (dbFloor, dbRaw_[idx]);
-        
-        // Populate snapshot with Peak Hold (AC1 - Existing Buffer)
-        snapshot.fftPeakHoldDb[idx] = juce::jmax (dbFloor, peakHold[idx]);
+        outPeakDb[i] = juce::jmax (dbFloor, dbRaw_[idx]);
+    }
+    
+    // Silence fast path: only checked while the input is silent (free on live audio)
+    if (silentSamples_ > 0)
+    {
+        tracesAtFloor_ = true;
+        for (int i = 0; i < numBins && tracesAtFloor_; ++i)
+            tracesAtFloor_ = (outDb[i] <= dbFloor && outPeakDb[i] <= dbFloor);
+    }
+    
+    // Peak Hold (AC1 - Existing Buffer)
+    if (outPeakHoldDb != nullptr)
+    {
+        for (int i = 0; i < numBins; ++i)
+            outPeakHoldDb[i] = juce::jmax (dbFloor, peakHold[static_cast<std::size_t> (i)]);
     }
     
     // Multi-trace: Copy power domain arrays for UI-side derivation
+    // Mid/Side come straight from the complex bins (phase-correct), Mid == Mono == magnitudes_.
     snapshot.multiTraceEnabled = enableMultiTrace_;
     if (enableMultiTrace_)
     {
-        for (int i = 0; i < copyBins; ++i)
-        {
-            const std::size_t idx = static_cast<std::size_t> (i);
-            snapshot.powerL[idx] = powerL_[idx];
-            snapshot.powerR[idx] = powerR_[idx];
-        }
+        const std::size_t bytes = static_cast<std::size_t> (numBins) * sizeof (float);
+        std::memcpy (snapshot.addTrace (Trace::PowerL, numBins), powerL_.data(), bytes);
+        std::memcpy (snapshot.addTrace (Trace::PowerR, numBins), powerR_.data(), bytes);
+        std::memcpy (snapshot.addTrace (Trace::PowerMid, numBins), magnitudes_.data(), bytes);
+        std::memcpy (snapshot.addTrace (Trace::PowerSide, numBins), powerSide_.data(), bytes);
     }
     
+    writeResampledTraces (snapshot, ! filterBankActive_);
+    
+    if (filterBankActive_)
+        writeFilterBankTraces (snapshot, rmsAttCoeff, rmsRelCoeff, peakAttCoeff, peakRelCoeff);
+    
+    if (multiResActive_ && multiRes_.hasOutput())
+        writeMultiResolutionTraces (snapshot, rmsAttCoeff, rmsRelCoeff, peakAttCoeff, peakRelCoeff);
+    
+    if (ltasActive)
+        writeLtasTraces (snapshot, numBins);
+    
 #if JUCE_DEBUG
     // DEBUG: Log FFT data range once per second (throttled)
     static uint32_t debugLogCounter = 0;
@@ -539,77 +936,277 @@ void AnalyzerEngine::computeFFT()
     }
 #endif
     
-    // Publish snapshot (audio thread, lock-free)
-    publishSnapshot (snapshot);
+    // Publish snapshot (one atomic exchange, no copy)
+    snapshots_.publish();
+    publishedFrames_.store (publishedFrames_.load (std::memory_order_relaxed) + 1, std::memory_order_release);
+    profileEnd (StageProfiler::Stage::Publish, publishStart);
 }
 
-void AnalyzerEngine::applyWindow(const std::vector<float>& fifoIn, int writePosIn)
+void AnalyzerEngine::writeResampledTraces (AnalyzerSnapshot& snapshot, bool includeBands)
 {
-    // Write windowed time-domain samples into the SAME buffer we pass to JUCE FFT.
-    // JUCE real-only FFT expects first N floats to contain the real samples.
-    for (int i = 0; i < currentFFTSize; ++i)
+    // Sparse bin -> series multiply in the POWER domain (mean power per band/point), then one
+    // vectorised dB pass; peaks take the per-row maximum of the ballistic peak (already dB).
+    using Trace = AnalyzerSnapshot::Trace;
+    if (resampler_ == nullptr || resampler_->getNumBins() != currentFFTSize / 2 + 1)
+        return;
+    
+    constexpr int numBands = SpectrumResampler::kNumBands;
+    constexpr int numLog = SpectrumResampler::kNumLogPoints;
+    
+    if (includeBands)
     {
-        const int fifoIndex = (writePosIn + i) % currentFFTSize;
-        const std::size_t idx = static_cast<std::size_t> (i);
-        const std::size_t fifoIdx = static_cast<std::size_t> (fifoIndex);
-        fftOutput[idx] = fifoIn[fifoIdx] * window[idx];
+        float* bandsDb = snapshot.addTrace (Trace::BandsDb, numBands);
+        float* bandsPeakDb = snapshot.addTrace (Trace::BandsPeakDb, numBands);
+        if (bandsDb != nullptr && bandsPeakDb != nullptr)
+        {
+            resampler_->applyBandsPower (smoothedMagnitude.data(), bandsDb);
+            AnalyzerPro::dsp::SpectrumKernels::powerToDb (bandsDb, bandsDb, numBands, kDbFloor);
+            resampler_->applyBandsMax (dbRaw_.data(), bandsPeakDb, kDbFloor);
+            snapshot.bandsPerOctave = 3;  // ISO 1/3-octave set
+        }
     }
+    
+    float* logDb = snapshot.addTrace (Trace::LogDb, numLog);
+    float* logPeakDb = snapshot.addTrace (Trace::LogPeakDb, numLog);
+    if (logDb == nullptr || logPeakDb == nullptr)
+        return;
+    
+    resampler_->applyLogPower (smoothedMagnitude.data(), logDb);
+    AnalyzerPro::dsp::SpectrumKernels::powerToDb (logDb, logDb, numLog, kDbFloor);
+    resampler_->applyLogMax (dbRaw_.data(), logPeakDb, kDbFloor);
+}
 
-    // Zero-pad the remainder (JUCE uses this buffer in-place for output too)
-    const std::size_t fftSizeSz = static_cast<std::size_t> (currentFFTSize);
-    std::fill (fftOutput.begin() + static_cast<std::ptrdiff_t> (fftSizeSz), fftOutput.end(), 0.0f);
+void AnalyzerEngine::writeSpectrogramRow() noexcept
+{
+    if (resampler_ == nullptr || resampler_->getNumBins() != currentFFTSize / 2 + 1)
+        return;
+    
+    constexpr int numColumns = SpectrogramHistory::kNumColumns;
+    static_assert (numColumns == SpectrumResampler::kNumSpectrogramColumns, "Spectrogram grid mismatch");
+    resampler_->applySpectrogramPower (magnitudes_.data(), spectrogramRow_.data());
+    AnalyzerPro::dsp::SpectrumKernels::powerToDb (spectrogramRow_.data(), spectrogramRow_.data(), numColumns, kDbFloor);
+    spectrogram_.addFrame (spectrogramRow_.data(), currentHopSize);
+}
+
+void AnalyzerEngine::accumulateLtas (int numBins) noexcept
+{
+    // Bands/log are resampled from the raw frame every hop so they survive FFT size changes
+    if (resampler_ == nullptr || resampler_->getNumBins() != numBins)
+        return;
+    
+    resampler_->applyBandsPower (magnitudes_.data(), ltasBandPower_.data());
+    resampler_->applyLogPower (magnitudes_.data(), ltasLogPower_.data());
+    ltas_.addFrame (magnitudes_.data(), numBins, ltasBandPower_.data(), ltasLogPower_.data(), currentHopSize);
 }
 
-void AnalyzerEngine::extractMagnitudes(float* powerOut, int numBins)
+void AnalyzerEngine::writeLtasTraces (AnalyzerSnapshot& snapshot, int numBins) noexcept
 {
-    // Extract power spectrum from fftOutput (assumes FFT already performed)
-    // Real-only FFT output format: [DC, Nyquist, real1, imag1, real2, imag2, ...]
+    using Trace = AnalyzerSnapshot::Trace;
+    constexpr int numBands = LtasAccumulator::kNumBands;
+    constexpr int numLog = LtasAccumulator::kNumLogPoints;
+    
+    float* binsDb = snapshot.addTrace (Trace::LtasDb, numBins);
+    float* bandsDb = snapshot.addTrace (Trace::LtasBandsDb, numBands);
+    float* logDb = snapshot.addTrace (Trace::LtasLogDb, numLog);
+    if (binsDb == nullptr || bandsDb == nullptr || logDb == nullptr)
+        return;
     
-    // DC bin (real only)
-    powerOut[0] = fftOutput[0] * fftOutput[0];
+    ltas_.readBinPower (binsDb, numBins);
+    ltas_.readBandPower (bandsDb);
+    ltas_.readLogPower (logDb);
     
-    // Middle bins (complex)
-    for (int i = 1; i < numBins - 1; ++i)
+    AnalyzerPro::dsp::SpectrumKernels::powerToDb (binsDb, binsDb, numBins, kDbFloor);
+    AnalyzerPro::dsp::SpectrumKernels::powerToDb (bandsDb, bandsDb, numBands, kDbFloor);
+    AnalyzerPro::dsp::SpectrumKernels::powerToDb (logDb, logDb, numLog, kDbFloor);
+    
+    snapshot.ltasFrameCount = ltas_.getFrameCount();
+    snapshot.ltasDurationSec = ltas_.getWeightSamples() / currentSampleRate;
+    snapshot.ltasBinDurationSec = ltas_.getBinWeightSamples() / currentSampleRate;
+}
+
+double AnalyzerEngine::readLtasPower (float* bandPower, float* logPower) const noexcept
+{
+    // A pending reset is applied at the next hop: until then the sums still hold the old span
+    if (ltasResetRequested_.load (std::memory_order_acquire))
     {
-        const std::size_t fftIdx1 = static_cast<std::size_t> (2 * i);
-        const std::size_t fftIdx2 = static_cast<std::size_t> (2 * i + 1);
-        const float real = fftOutput[fftIdx1];
-        const float imag = fftOutput[fftIdx2];
-        powerOut[i] = real * real + imag * imag;
+        std::fill (bandPower, bandPower + LtasAccumulator::kNumBands, 0.0f);
+        std::fill (logPower, logPower + LtasAccumulator::kNumLogPoints, 0.0f);
+        return 0.0;
     }
     
-    // Nyquist bin (real only, stored at index 1)
-    const float nyquistVal = fftOutput[1];
-    powerOut[numBins - 1] = nyquistVal * nyquistVal;
+    ltas_.readBandPower (bandPower);
+    ltas_.readLogPower (logPower);
+    return ltas_.getWeightSamples() / currentSampleRate;
+}
+
+void AnalyzerEngine::writeFilterBankTraces (AnalyzerSnapshot& snapshot, float rmsAttCoeff, float rmsRelCoeff,
+                                            float peakAttCoeff, float peakRelCoeff)
+{
+    // The bank integrates energy continuously between frames; each frame takes the mean power
+    // since the previous one and runs it through the same RMS/Peak ballistics as the FFT bands.
+    using Trace = AnalyzerSnapshot::Trace;
+    const int numBands = filterBank_.getNumBands();
+    
+    float* outDb = snapshot.addTrace (Trace::BandsDb, numBands);
+    float* outPeakDb = snapshot.addTrace (Trace::BandsPeakDb, numBands);
+    if (outDb == nullptr || outPeakDb == nullptr)
+        return;
     
-    // Apply FFT normalization
-    const float scale = 2.0f / static_cast<float> (currentFFTSize);
-    const float powerScale = (scale * scale) * 4.0f;  // Hann window correction
+    // Idle on silence the bank is not fed: its floor is exact zero power
+    if (silenceIdle_)
+        filterBankPower_.fill (0.0f);
+    else
+        filterBank_.readBandPower (filterBankPower_.data());
     
-    for (int i = 0; i < numBins; ++i)
+    applyPowerBallistics (filterBankPower_.data(), filterBankRms_.data(), filterBankPeak_.data(), numBands,
+                          seedFilterBank_, rmsAttCoeff, rmsRelCoeff, peakAttCoeff, peakRelCoeff);
+    seedFilterBank_ = false;
+    
+    AnalyzerPro::dsp::SpectrumKernels::powerToDb (filterBankRms_.data(), outDb, numBands, kDbFloor);
+    AnalyzerPro::dsp::SpectrumKernels::powerToDb (filterBankPeak_.data(), outPeakDb, numBands, kDbFloor);
+    
+    for (int i = 0; i < numBands; ++i)
+        outPeakDb[i] = juce::jmax (outPeakDb[i], outDb[i]);
+    
+    snapshot.bandsPerOctave = filterBank_.getBandsPerOctave();
+}
+
+void AnalyzerEngine::applyPowerBallistics (const float* power, float* rms, float* peak, int numPoints, bool seed,
+                                           float rmsAttCoeff, float rmsRelCoeff, float peakAttCoeff, float peakRelCoeff) noexcept
+{
+    // Per-point attack/release in the power domain; seed jumps straight to the input
+    for (int i = 0; i < numPoints; ++i)
     {
-        powerOut[i] *= powerScale;
+        const float inputPower = power[i];
+        
+        const float rmsCoeff = seed ? 0.0f : ((inputPower > rms[i]) ? rmsAttCoeff : rmsRelCoeff);
+        rms[i] = rmsCoeff * rms[i] + (1.0f - rmsCoeff) * inputPower;
+        
+        const float peakCoeff = seed ? 0.0f : ((inputPower > peak[i]) ? peakAttCoeff : peakRelCoeff);
+        peak[i] = peakCoeff * peak[i] + (1.0f - peakCoeff) * inputPower;
     }
+}
+
+void AnalyzerEngine::writeMultiResolutionTraces (AnalyzerSnapshot& snapshot, float rmsAttCoeff, float rmsRelCoeff,
+                                                 float peakAttCoeff, float peakRelCoeff)
+{
+    // Same RMS/Peak ballistics as the FFT traces, stepped at the main hop rate so both
+    // LOG sources respond identically. Tiers keep their latest frame between their own hops.
+    using Trace = AnalyzerSnapshot::Trace;
+    constexpr int numPoints = MultiResolutionAnalyzer::kNumLogPoints;
+    
+    float* outDb = snapshot.addTrace (Trace::MultiResDb, numPoints);
+    float* outPeakDb = snapshot.addTrace (Trace::MultiResPeakDb, numPoints);
+    if (outDb == nullptr || outPeakDb == nullptr)
+        return;
     
-    // Correct DC and Nyquist (factor of 0.25)
-    powerOut[0] *= 0.25f;
-    powerOut[numBins - 1] *= 0.25f;
+    if (silenceIdle_)
+        multiResPower_.fill (0.0f);
+    else
+        multiRes_.renderLogPower (multiResPower_.data());
+    
+    applyPowerBallistics (multiResPower_.data(), multiResRms_.data(), multiResPeak_.data(), numPoints,
+                          seedMultiRes_, rmsAttCoeff, rmsRelCoeff, peakAttCoeff, peakRelCoeff);
+    seedMultiRes_ = false;
+    
+    convertToDb (multiResRms_.data(), outDb, numPoints);
+    convertToDb (multiResPeak_.data(), outPeakDb, numPoints);
+    
+    // Peak never reads below RMS (mirrors the FFT trace clamping)
+    for (int i = 0; i < numPoints; ++i)
+        outPeakDb[i] = juce::jmax (outPeakDb[i], outDb[i]);
 }
 
-void AnalyzerEngine::convertToDb (const float* magnitudes, float* dbOut, int numBins)
+void AnalyzerEngine::appendToFifo (const float* left, const float* right, int numSamples)
 {
-    // Convert POWER to dB
-    // Use -120.0f floor for consistency (matches snapshot clamping)
-    constexpr float dbFloor = -120.0f;
-    constexpr float powerFloor = 1e-12f;  // 10*log10(1e-12) = -120dB
+    jassert (numSamples <= kMaxFFTSize);
     
-    for (int i = 0; i < numBins; ++i)
+    // Write each run twice (primary + mirror half) so reads never need to wrap.
+    // The ring is always kMaxFFTSize long, independent of the active FFT size.
+    const int fftSize = kMaxFFTSize;
+    const int firstRun = juce::jmin (numSamples, fftSize - fifoWritePos);
+    const int secondRun = numSamples - firstRun;
+    
+    float* dstL = fifoBufferL_.data();
+    float* dstR = fifoBufferR_.data();
+    
+    juce::FloatVectorOperations::copy (dstL + fifoWritePos, left, firstRun);
+    juce::FloatVectorOperations::copy (dstL + fifoWritePos + fftSize, left, firstRun);
+    juce::FloatVectorOperations::copy (dstR + fifoWritePos, right, firstRun);
+    juce::FloatVectorOperations::copy (dstR + fifoWritePos + fftSize, right, firstRun);
+    
+    if (secondRun > 0)
     {
-        const std::size_t idx = static_cast<std::size_t> (i);
-        const float power = juce::jmax (powerFloor, magnitudes[idx]);
-        const float db = 10.0f * std::log10 (power); // 10*log10 for Power
-        dbOut[i] = juce::jmax (dbFloor, db);
+        juce::FloatVectorOperations::copy (dstL, left + firstRun, secondRun);
+        juce::FloatVectorOperations::copy (dstL + fftSize, left + firstRun, secondRun);
+        juce::FloatVectorOperations::copy (dstR, right + firstRun, secondRun);
+        juce::FloatVectorOperations::copy (dstR + fftSize, right + firstRun, secondRun);
     }
+    
+    fifoWritePos += numSamples;
+    if (fifoWritePos >= fftSize)
+        fifoWritePos -= fftSize;
+}
+
+void AnalyzerEngine::performStereoFFT()
+{
+    // Pack windowed L into the real part and windowed R into the imaginary part.
+    // Mirrored FIFO: the latest fftSize samples are contiguous and end at fifoWritePos + kMaxFFTSize
+    // (oldest first), so windowing is a single straight multiply with no modulo gather.
+    const int fftSize = currentFFTSize;
+    const int readStart = fifoWritePos + kMaxFFTSize - fftSize;
+    const float* srcL = fifoBufferL_.data() + readStart;
+    const float* srcR = fifoBufferR_.data() + readStart;
+    const float* win = window;
+    juce::dsp::Complex<float>* packed = fftInput_.data();
+    
+    for (int i = 0; i < fftSize; ++i)
+        packed[i] = { srcL[i] * win[i], srcR[i] * win[i] };
+
+    fft->perform (fftInput_.data(), fftSpectrum_.data(), false);
+
+    // Split via conjugate symmetry (Z = FFT(l + j*r)):
+    //   L[k] = (Z[k] + conj(Z[N-k])) / 2
+    //   R[k] = (Z[k] - conj(Z[N-k])) / 2j
+    // Mono/Mid and Side follow by linearity: (L +/- R) / 2, so they keep the true inter-channel phase.
+    const int numBins = fftSize / 2 + 1;
+    const float scale = 2.0f / static_cast<float> (fftSize);
+    const float powerScale = (scale * scale) * 4.0f;  // Hann window correction
+    const juce::dsp::Complex<float> minusHalfJ { 0.0f, -0.5f };
+
+    for (int k = 0; k < numBins; ++k)
+    {
+        const std::size_t idx = static_cast<std::size_t> (k);
+        const std::size_t mirrorIdx = static_cast<std::size_t> ((fftSize - k) & (fftSize - 1));
+        const auto z = fftSpectrum_[idx];
+        const auto zMirror = std::conj (fftSpectrum_[mirrorIdx]);
+
+        const auto binL = 0.5f * (z + zMirror);
+        const auto binR = minusHalfJ * (z - zMirror);
+        const auto binMid = 0.5f * (binL + binR);
+        const auto binSide = 0.5f * (binL - binR);
+
+        powerL_[idx] = std::norm (binL) * powerScale;
+        powerR_[idx] = std::norm (binR) * powerScale;
+        magnitudes_[idx] = std::norm (binMid) * powerScale;
+        powerSide_[idx] = std::norm (binSide) * powerScale;
+    }
+
+    // Correct DC and Nyquist (factor of 0.25)
+    const std::size_t dc = 0;
+    const std::size_t nyquist = static_cast<std::size_t> (numBins - 1);
+    for (auto* p : { &powerL_, &powerR_, &magnitudes_, &powerSide_ })
+    {
+        (*p)[dc] *= 0.25f;
+        (*p)[nyquist] *= 0.25f;
+    }
+}
+
+void AnalyzerEngine::convertToDb (const float* magnitudes, float* dbOut, int numBins)
+{
+    // Convert POWER to dB (vectorised fast log)
+    // Use -120.0f floor for consistency (matches snapshot clamping): power floor 1e-12
+    AnalyzerPro::dsp::SpectrumKernels::powerToDb (magnitudes, dbOut, numBins, kDbFloor);
 }
 
 void AnalyzerEngine::updatePeakHold (const float* dbInstant, const float* dbBallistic, float* peakOut, int numBins)
@@ -622,15 +1219,13 @@ void AnalyzerEngine::updatePeakHold (const float* dbInstant, const float* dbBall
         return;
     }
 
-    // Ensure timer vector matches bins (defensive; initializeFFT should size this).
-    if (static_cast<int> (peakHoldFramesRemaining_.size()) != numBins)
-        peakHoldFramesRemaining_.assign (static_cast<std::size_t> (numBins), 0);
+    jassert (static_cast<int> (peakHoldFramesRemaining_.size()) == numBins);
 
     // Decay per FFT frame: (dB/s) * (hopSec)
     const float hopSec = static_cast<float> (currentHopSize) / static_cast<float> (currentSampleRate);
     const float decayDbPerSec = (peakDecayCurve_ == PeakDecayCurve::TimeConstant60dB)
                                   ? (60.0f / juce::jmax (0.01f, peakDecayTimeConstantSec_))
-                                  : peakDecayDbPerSec;
+                                  : peakDecayDbPerSec.load (std::memory_order_relaxed);
     const float decayPerFrame = (decayDbPerSec * hopSec);
 
     // Hold time expressed in FFT frames (only used for HoldThenDecay)
@@ -710,88 +1305,35 @@ void AnalyzerEngine::setFftSize (int fftSize)
 {
     // Validate FFT size (must be power of 2, within range)
     // Do NOT clamp 1024 to 2048 - user explicitly chose 1024, respect it
+    const int minSize = 1 << kMinFFTOrder;
+    const int maxSize = 1 << kMaxFFTOrder;
     int validSize = 2048;
-    if (fftSize == 1024 || fftSize == 2048 || fftSize == 4096 || fftSize == 8192)
-        validSize = fftSize;
-    else if (fftSize < 1024)
-        validSize = 1024;  // Clamp to minimum 1024 (not 2048)
-    else if (fftSize > 8192)
-        validSize = 8192;
+    if (fftSize < minSize)
+        validSize = minSize;
+    else if (fftSize > maxSize)
+        validSize = maxSize;
     else
     {
-        // Round to nearest power of 2
+        // Round up to a power of 2
         validSize = 1 << static_cast<int> (std::ceil (std::log2 (fftSize)));
-        validSize = juce::jlimit (1024, 8192, validSize);
+        validSize = juce::jlimit (minSize, maxSize, validSize);
     }
 
-    // Always route through requestFftSize (RT-safe, centralizes metadata invalidation).
-    // requestFftSize will handle prepared/not-prepared state.
-    if (validSize != currentFFTSize)
-        requestFftSize (validSize);
+    requestFftSize (validSize);
 }
 
 void AnalyzerEngine::requestFftSize (int fftSize)
 {
-    // Micro-polish: avoid re-requesting the same FFT size
-    const int pending = pendingFftSize_.load (std::memory_order_acquire);
-    if ((pending == fftSize && fftResizeRequested_.load (std::memory_order_acquire)) ||
-        (pending == 0 && fftSize == currentFFTSize))
-    {
+    // RT-safe: only records the target order. The analysis context swaps plan/window/buffer
+    // views at the next chunk (see applyPendingFftSize), so there is no resize gap to mask.
+    if (! juce::isPowerOfTwo (fftSize))
         return;
-    }
-
-    pendingFftSize_.store (fftSize, std::memory_order_release);
-    fftResizeRequested_.store (true, std::memory_order_release);
-
-    // Metadata invalidation (no allocations)
-    const int numBins = fftSize / 2 + 1;
-
-    jassert (numBins <= static_cast<int> (published_.data.fftDb.size()));
-    jassert (numBins <= static_cast<int> (published_.data.fftPeakDb.size()));
 
-    published_.data.isValid = false;
-    published_.data.fftSize = fftSize;
-    published_.data.sampleRate = currentSampleRate;
-    published_.data.numBins = numBins;      // legacy/compat
-    published_.data.fftBinCount = numBins;
+    const int order = juce::jlimit (kMinFFTOrder, kMaxFFTOrder, static_cast<int> (std::log2 (fftSize)));
+    requestedFftOrder_.store (order, std::memory_order_release);
+    multichannel_.setFftSize (fftSize);
 }
 
-    void AnalyzerEngine::applyPendingFftSizeIfNeeded()
-    {
-    #if JUCE_DEBUG
-        jassert (juce::MessageManager::getInstance()->isThisTheMessageThread());
-    #endif
-
-        if (! fftResizeRequested_.load (std::memory_order_acquire))
-            return;
-
-        const int requested = pendingFftSize_.load (std::memory_order_acquire);
-
-        // Nothing meaningful pending: clear the request state.
-        if (requested <= 0 || requested == currentFFTSize)
-        {
-            pendingFftSize_.store (0, std::memory_order_release);
-            fftResizeRequested_.store (false, std::memory_order_release);
-            return;
-        }
-
-        // Apply the resize on the message thread (allocations/resizes are allowed here).
-        initializeFFT (requested);
-        // updateSmoothingCoeff removed
-
-        // If a newer request arrived while we were resizing, keep the flag set.
-        const int nowPending = pendingFftSize_.load (std::memory_order_acquire);
-        if (nowPending > 0 && nowPending != currentFFTSize)
-        {
-            fftResizeRequested_.store (true, std::memory_order_release);
-            return;
-        }
-
-        // No newer request: clear state.
-        pendingFftSize_.store (0, std::memory_order_release);
-        fftResizeRequested_.store (false, std::memory_order_release);
-    }
-
     void AnalyzerEngine::setAveragingMs (float averagingMs)
     {
         // Removed in favor of Attack/Release. 
@@ -802,16 +1344,15 @@ void AnalyzerEngine::requestFftSize (int fftSize)
     }
 
 void AnalyzerEngine::resetPeaks()
+{
+    // May be called from the message thread: defer the actual clear to the analysis context.
+    peakResetRequested_.store (true, std::memory_order_release);
+}
+
+void AnalyzerEngine::clearPeakState()
 {
     std::fill (peakHold.begin(), peakHold.end(), kDbFloor);
     std::fill (peakHoldFramesRemaining_.begin(), peakHoldFramesRemaining_.end(), 0);
-    
-    // Multi-trace Peak Reset
-    std::fill (peakL_.begin(), peakL_.end(), kDbFloor);
-    std::fill (peakR_.begin(), peakR_.end(), kDbFloor);
-    std::fill (peakMono_.begin(), peakMono_.end(), kDbFloor);
-    std::fill (peakMid_.begin(), peakMid_.end(), kDbFloor);
-    std::fill (peakSide_.begin(), peakSide_.end(), kDbFloor);
 }
 
 void AnalyzerEngine::setPeakHoldMode (PeakHoldMode mode)
@@ -882,11 +1423,8 @@ void AnalyzerEngine::setPeakDecayTimeConstantSec (float seconds)
 
 void AnalyzerEngine::setSmoothingOctaves (float octaves)
 {
-    if (std::abs(smoothingOctaves_ - octaves) < 1e-4f)
-        return;
-        
-    smoothingOctaves_ = octaves;
-    updateSmoothingBounds();
+    // Bounds are rebuilt by the analysis context at the next hop (no allocation: sized in the arena)
+    requestedSmoothingOctaves_.store (octaves, std::memory_order_relaxed);
 }
 
 void AnalyzerEngine::updateSmoothingBounds()
@@ -895,11 +1433,8 @@ void AnalyzerEngine::updateSmoothingBounds()
         return;
 
     const int numBins = currentFFTSize / 2 + 1;
-    if (static_cast<int>(smoothLowBounds.size()) != numBins)
-        smoothLowBounds.resize (static_cast<size_t> (numBins));
-    if (static_cast<int>(smoothHighBounds.size()) != numBins)
-        smoothHighBounds.resize (static_cast<size_t> (numBins));
-        
+    jassert (static_cast<int> (smoothLowBounds.size()) == numBins);
+
     // Standard octave bandwidth calculation:
     // f_upper = f_center * 2^(oct/2)
     // f_lower = f_center * 2^(-oct/2)
@@ -933,137 +1468,22 @@ void AnalyzerEngine::updateSmoothingBounds()
 
 // Wave smoothing update removed.
 
-void AnalyzerEngine::publishSnapshot (const AnalyzerSnapshot& source)
+const AnalyzerSnapshot* AnalyzerEngine::acquireLatestSnapshot() noexcept
 {
-    // CRITICAL: Never publish invalid or "floor-only" snapshots
-    // Only publish valid snapshots with actual FFT data
-    // Prefer fftBinCount for FFT bin counts; fallback to numBins exists for legacy snapshots only.
-    const int binCount = (source.fftBinCount > 0) ? source.fftBinCount : source.numBins;
-    if (!source.isValid || binCount <= 0 || binCount > static_cast<int> (AnalyzerSnapshot::kMaxFFTBins))
-    {
-        // Do not publish invalid snapshot - UI will hold last valid frame
-        return;
-    }
-    
-    // Copy ALL fields into published snapshot (deep copy arrays)
-    published_.data.isValid = source.isValid;
-    published_.data.fftBinCount = binCount;
-    published_.data.numBins = source.numBins;
-    published_.data.sampleRate = source.sampleRate;
-    published_.data.fftSize = source.fftSize;
-    published_.data.displayBottomDb = source.displayBottomDb;
-    published_.data.displayBottomDb = source.displayBottomDb;
-    published_.data.displayTopDb = source.displayTopDb;
-    published_.data.isHoldOn = source.isHoldOn;
-    
-    // Deep copy arrays (fixed-size, but copy only used portion)
-    const int numBins = binCount;
-    
-    // Safety guard: ensure numBins doesn't exceed array capacity
-    jassert (numBins <= static_cast<int> (published_.data.fftDb.size()));
-    jassert (numBins <= static_cast<int> (published_.data.fftPeakDb.size()));
-    jassert (numBins <= static_cast<int> (source.fftDb.size()));
-    jassert (numBins <= static_cast<int> (source.fftPeakDb.size()));
-    
-    const int copyBins = juce::jmin (numBins, static_cast<int> (published_.data.fftDb.size()));
-    for (int i = 0; i < copyBins; ++i)
-    {
-        const std::size_t idx = static_cast<std::size_t> (i);
-        published_.data.fftDb[idx] = source.fftDb[idx];
-        published_.data.fftPeakDb[idx] = source.fftPeakDb[idx];
-    }
-    
-    // Multi-trace: Copy power domain arrays
-    published_.data.multiTraceEnabled = source.multiTraceEnabled;
-    if (source.multiTraceEnabled)
-    {
-        jassert (numBins <= static_cast<int> (published_.data.powerL.size()));
-        jassert (numBins <= static_cast<int> (published_.data.powerR.size()));
-        
-        for (int i = 0; i < copyBins; ++i)
-        {
-            const std::size_t idx = static_cast<std::size_t> (i);
-            published_.data.powerL[idx] = source.powerL[idx];
-            published_.data.powerR[idx] = source.powerR[idx];
-        }
-    }
+    if (!prepared)
+        return nullptr;
     
-    // Increment sequence AFTER data copy completes (release fence ensures visibility)
-    // CRITICAL: Keep sequence monotonic - never reset to 0
-    const uint32_t currentSeq = published_.sequence.load (std::memory_order_relaxed);
-    const uint32_t next = (currentSeq == 0) ? 1 : (currentSeq + 1);  // Ensure we never stay at 0
-    published_.sequence.store (next, std::memory_order_release);
+    // Only valid frames are ever published (computeFFT bails out before publish otherwise)
+    return snapshots_.acquireLatest();
 }
 
-bool AnalyzerEngine::getLatestSnapshot (AnalyzerSnapshot& dest) const
+bool AnalyzerEngine::getLatestSnapshot (AnalyzerSnapshot& dest)
 {
-    if (!prepared)
+    const AnalyzerSnapshot* latest = acquireLatestSnapshot();
+    if (latest == nullptr)
         return false;
     
-    // Retry loop to handle seqlock-style reads: if sequence changes during copy,
-    // retry up to 3 times to catch the next stable frame. This prevents dropped
-    // frames that cause UI stutter when the timer only calls once per tick.
-    for (int attempt = 0; attempt < 3; ++attempt)
-    {
-        // First read: get sequence (acquire barrier ensures we see published data)
-        const uint32_t seq1 = published_.sequence.load (std::memory_order_acquire);
-        
-        if (seq1 == 0)
-            return false;  // No data published yet
-        
-        // Copy published data into destination
-        dest.isValid = published_.data.isValid;
-        dest.fftBinCount = published_.data.fftBinCount;
-        dest.numBins = published_.data.numBins;
-        dest.sampleRate = published_.data.sampleRate;
-        dest.fftSize = published_.data.fftSize;
-        dest.displayBottomDb = published_.data.displayBottomDb;
-        dest.displayBottomDb = published_.data.displayBottomDb;
-        dest.displayTopDb = published_.data.displayTopDb;
-        dest.isHoldOn = published_.data.isHoldOn;
-        
-        // Deep copy arrays
-        // Prefer fftBinCount for FFT bin counts; fallback to numBins exists for legacy snapshots only.
-        const int numBins = (published_.data.fftBinCount > 0) ? published_.data.fftBinCount
-                                                              : published_.data.numBins;
-        
-        // Safety guard: ensure numBins doesn't exceed array capacity
-        jassert (numBins <= static_cast<int> (dest.fftDb.size()));
-        jassert (numBins <= static_cast<int> (dest.fftPeakDb.size()));
-        jassert (numBins <= static_cast<int> (published_.data.fftDb.size()));
-        jassert (numBins <= static_cast<int> (published_.data.fftPeakDb.size()));
-        
-        const int copyBins = juce::jmin (numBins, static_cast<int> (dest.fftDb.size()));
-        for (int i = 0; i < copyBins; ++i)
-        {
-            const std::size_t idx = static_cast<std::size_t> (i);
-            dest.fftDb[idx] = published_.data.fftDb[idx];
-            dest.fftPeakDb[idx] = published_.data.fftPeakDb[idx];
-        }
-
-        // Multi-trace: Copy power domain arrays
-        dest.multiTraceEnabled = published_.data.multiTraceEnabled;
-        if (dest.multiTraceEnabled)
-        {
-            for (int i = 0; i < copyBins; ++i)
-            {
-                const std::size_t idx = static_cast<std::size_t> (i);
-                dest.powerL[idx] = published_.data.powerL[idx];
-                dest.powerR[idx] = published_.data.powerR[idx];
-            }
-        }
-        
-        // Second read to verify stability
-        const uint32_t seq2 = published_.sequence.load (std::memory_order_acquire);
-        
-        // Return true only if sequence didn't change during copy (stable read)
-        if (seq1 == seq2 && seq1 != 0)
-            return true;
-        
-        // Sequence changed during copy (torn read) - retry to catch next stable frame
-        // Continue loop to retry
-    }
-    
-    // After retries, return false (sequence kept changing, likely high update rate)
-    return false;
+    // UI thread: grow the destination once to the engine's worst case (no-op afterwards)
+    dest.reserve (latest->capacity());
+    return dest.copyFrom (*latest);
 }
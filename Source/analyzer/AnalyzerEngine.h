@@ -1,10 +1,11 @@
 #pragma once
 
 #include <juce_dsp/juce_dsp.h>
-#include <juce_audio_processors/juce_audio_processors.h>
+#include <juce_audio_basics/juce_audio_basics.h>
 #include "AnalyzerSnapshot.h"
 #include <array>
 #include <atomic>
+#include <complex>
 #include <memory>
 
 //==============================================================================
@@ -13,6 +14,15 @@
     Runs on audio thread, produces snapshots for UI consumption.
 */
 #include "StereoScopeAnalyzer.h"
+#include "MultiResolutionAnalyzer.h"
+#include "FilterBankAnalyzer.h"
+#include "SpectrumResampler.h"
+#include "SpectrogramHistory.h"
+#include "LtasAccumulator.h"
+#include "MultichannelAnalyzer.h"
+#include "AnalysisScheduler.h"
+#include "../diagnostics/StageProfiler.h"
+#include "../dsp/resampling/HalfbandDecimator.h"
 
 class AnalyzerEngine
 {
@@ -25,27 +35,161 @@ public:
 
     StereoScopeAnalyzer& getStereoScopeAnalyzer() noexcept { return stereoScopeAnalyzer; }
     const StereoScopeAnalyzer& getStereoScopeAnalyzer() const noexcept { return stereoScopeAnalyzer; }
+
+    /** What a consumer (view, hardware sink, tool) reads from the engine. Products nobody has
+        registered for are not computed: with no editor open the engine only keeps its FIFOs
+        filled, so a consumer that registers gets a complete frame at the next hop. LTAS keeps
+        accumulating while enabled (it integrates over time, like the loudness meter). */
+    enum class Product
+    {
+        Spectrum = 0,   // Snapshots: FFT, smoothing, ballistics, peak hold, Bands/Log/side-analyser traces
+        StereoScope,    // StereoScopeAnalyzer samples
+        Spectrogram,    // SpectrogramHistory rows
+        NumProducts
+    };
+
+    /** Reference-counted registration (any thread; takes effect at the next hop). */
+    void addConsumer (Product product) noexcept    { consumers_[static_cast<std::size_t> (product)].fetch_add (1, std::memory_order_relaxed); }
+    void removeConsumer (Product product) noexcept { consumers_[static_cast<std::size_t> (product)].fetch_sub (1, std::memory_order_relaxed); }
+    bool hasConsumer (Product product) const noexcept { return consumers_[static_cast<std::size_t> (product)].load (std::memory_order_relaxed) > 0; }
     
     /** Release resources */
     void reset();
     
-    /** Process audio block and update FFT if ready */
+    /** Process audio block and update FFT if ready.
+        In worker-thread mode this only queues L/R for the analysis thread (wait-free). */
     void processBlock (const juce::AudioBuffer<float>& buffer);
+
+    /** Stage timing (ring push, FIFO fill, side analysers, FFT, smoothing/ballistics, publish). Set before
+        prepare(); nullptr (default) disables it. The profiler must outlive the engine's use of it. */
+    void setStageProfiler (StageProfiler* profiler) noexcept { profiler_ = profiler; }
+
+    /** Optional worker-thread analysis: the audio thread only pushes L/R into an SPSC ring and
+        the process-wide AnalysisScheduler pool runs the hop/FFT/publish pipeline. Hops land on
+        the same sample positions as in inline mode. Takes effect on the next prepare(). */
+    void setAnalysisThreadEnabled (bool shouldUseThread) noexcept { analysisThreadRequested_ = shouldUseThread; }
+    bool isAnalysisThreadEnabled() const noexcept { return useAnalysisThread_; }
+
+    /** Bounded callbacks for inline mode (no effect while the pool analyses). processBlock() then
+        queues L/R in the analysis ring and computes at most kHopBudgetHeadroom x the hops a
+        prepared-size block needs per callback; the rest (an oversized host block, a burst) carries
+        over to the next callbacks, which catch up at the headroom rate. Hop positions do not change,
+        frames only land later. Off (default) keeps inline analysis in lockstep with the stream,
+        which offline renders and the CLI tools rely on. Takes effect on the next prepare(). */
+    void setHopBudgetEnabled (bool shouldLimit) noexcept { hopBudgetRequested_ = shouldLimit; }
+
+    /** Audio thread, once per host callback before the processBlock() call(s) feeding it:
+        refills the hop budget (no-op unless the budget is active). */
+    void beginCallback() noexcept;
+
+    /** Scheduling priority in worker mode: Foreground while an editor shows this instance,
+        Background (default, throttled) otherwise. Any thread. */
+    void setAnalysisPriority (AnalysisScheduler::Priority priority) noexcept;
+
+    /** Per-channel spectra for multichannel buses (3 .. 12 channels, e.g. 5.1 or 7.1.4) on their
+        own worker pool, see MultichannelAnalyzer. The main pipeline keeps analysing L/R; mono and
+        stereo inputs leave the multichannel analyser idle. Takes effect on the next prepare(). */
+    void setNumInputChannels (int numChannels) noexcept { numInputChannelsRequested_ = numChannels; }
+    MultichannelAnalyzer& getMultichannelAnalyzer() noexcept { return multichannel_; }
+
+    /** Optional decimating front end for high sample rates. The L/R input runs through a cascade
+        of polyphase halfband stages (HalfbandDecimator) before the FIFOs, halving the rate while
+        bandwidthHz stays inside the last stage's flat, alias-free passband. That stage uses the
+        steep design (flat to 0.21 x its input rate, -90 dB from 0.29), the earlier ones the cheap
+        one. 20 kHz takes 96 and 192 kHz to 48 kHz and 176.4 kHz to 88.2 kHz; 88.2 kHz (20 kHz is
+        0.227 of it) and 44.1/48 kHz stay untouched. Lower bandwidths go further: 10 kHz takes
+        48 kHz to 24 kHz, 5 kHz to 12 kHz. Everything downstream - FFT, side analysers, spectrogram,
+        LTAS - then runs at the analysis rate, which snapshots publish as sampleRate, so bin
+        frequencies stay correct. Same FFT size: 2 - 4x cheaper per second of audio and 2 - 4x finer
+        bins. 0 (default) analyses at the host rate. The stereo scope and multichannel analyser
+        keep the full rate. Takes effect on the next prepare(). */
+    void setAnalysisBandwidthHz (double bandwidthHz) noexcept { analysisBandwidthRequestedHz_ = bandwidthHz; }
+
+    /** Rate the FFT pipeline runs at (host rate / 2^stages). */
+    double getAnalysisSampleRate() const noexcept { return currentSampleRate; }
+
+    /** Audio thread: queues every channel of the raw input for the multichannel analyser
+        (wait-free; a no-op while it is idle or nothing displays it). */
+    void processMultichannel (const juce::AudioBuffer<float>& buffer) noexcept
+    {
+        multichannel_.push (buffer.getArrayOfReadPointers(), buffer.getNumChannels(), buffer.getNumSamples());
+    }
+
+    /** Multi-resolution LOG spectrum: decimated short FFTs per octave tier, published as the
+        MultiResDb/MultiResPeakDb snapshot traces alongside the normal FFT. RT-safe toggle,
+        applied at the next chunk. */
+    void setMultiResolutionEnabled (bool shouldBeEnabled) noexcept { multiResRequested_.store (shouldBeEnabled, std::memory_order_relaxed); }
+
+    /** Per-channel power traces (PowerL/PowerR/PowerMid/PowerSide) for the multi-trace display.
+        On by default; RT-safe, applied at the next hop. */
+    void setMultiTraceEnabled (bool shouldBeEnabled) noexcept { multiTraceRequested_.store (shouldBeEnabled, std::memory_order_relaxed); }
+
+    /** Filter-bank RTA: the BandsDb/BandsPeakDb traces come from the IEC 61260 style filter bank
+        (FilterBankAnalyzer) instead of the FFT bins, at 1/bandsPerOctave octave resolution
+        (1, 3, 6 or 12; AnalyzerSnapshot::bandsPerOctave tells the UI which grid a frame carries).
+        RT-safe, applied at the next chunk. */
+    void setFilterBankEnabled (bool shouldBeEnabled) noexcept { filterBankRequested_.store (shouldBeEnabled, std::memory_order_relaxed); }
+    void setFilterBankBandsPerOctave (int bandsPerOctave) noexcept
+    {
+        const bool supported = (bandsPerOctave == 1 || bandsPerOctave == 6 || bandsPerOctave == 12);
+        requestedBandsPerOctave_.store (supported ? bandsPerOctave : 3, std::memory_order_relaxed);
+    }
+
+    /** Spectrogram history: one row of raw (unsmoothed) Mid power per 1/32 s on a 512-column
+        log grid, recorded while a Product::Spectrogram consumer is registered. Readers keep their own cursor (SpectrogramHistory::readRows). */
+    const SpectrogramHistory& getSpectrogramHistory() const noexcept { return spectrogram_; }
+
+    /** Long-term average spectrum: hop-weighted mean power of every frame since the last
+        resetLtas(), published as LtasDb/LtasBandsDb/LtasLogDb with the span in the snapshot header.
+        Disabling pauses it (sums are kept); resetLtas() is independent of resetPeaks().
+        RT-safe, applied at the next hop. */
+    void setLtasEnabled (bool shouldBeEnabled) noexcept { ltasRequested_.store (shouldBeEnabled, std::memory_order_relaxed); }
+    void resetLtas() noexcept { ltasResetRequested_.store (true, std::memory_order_release); }
+
+    /** Current LTAS straight from the accumulator, for offline callers that need the exact span
+        at the end of a range (snapshots lag by up to a hop, more while idle on silence).
+        Analysis context only: inline mode, between processBlock() calls. Fills kNumBands band and
+        kNumLogPoints log values of linear mean power and returns the seconds covered (0 while a
+        resetLtas() is still pending). */
+    double readLtasPower (float* bandPower, float* logPower) const noexcept;
+
+    /** Number of audio callbacks that found the analysis ring full (samples were dropped). */
+    uint32_t getAnalysisOverrunCount() const noexcept { return analysisOverruns_.load (std::memory_order_relaxed); }
+
+    /** Samples queued in the analysis ring that the analysis context has not taken yet (worker /
+        bounded mode, 0 otherwise). Any thread; test drivers wait on it between blocks. */
+    int getNumQueuedAnalysisSamples() const noexcept { return analysisFifo_.getNumReady(); }
+
+    /** Frames published since construction (wraps). Any thread. */
+    uint32_t getNumPublishedFrames() const noexcept { return publishedFrames_.load (std::memory_order_acquire); }
     
-    /** Publish a new snapshot (audio thread only, after computing FFT) */
-    void publishSnapshot (const AnalyzerSnapshot& source);
+    /** Latest published snapshot, read in place without copying (UI thread only, single consumer).
+        The frame stays unchanged until the next call. Returns nullptr if nothing was published yet. */
+    const AnalyzerSnapshot* acquireLatestSnapshot() noexcept;
     
-    /** Get latest snapshot (non-blocking, UI thread only) */
-    bool getLatestSnapshot (AnalyzerSnapshot& dest) const;
+    /** Copying variant of acquireLatestSnapshot() (same single-consumer rule). */
+    bool getLatestSnapshot (AnalyzerSnapshot& dest);
     
     /** Update parameters from APVTS (call from UI thread or parameter change callback) */
     void setFftSize (int fftSize);
 
-    // RT-safe: request an FFT size change (no allocations here)
+    // RT-safe: request an FFT size change (no allocations here).
+    // Every size is preplanned in prepare(); the analysis context swaps to it at the next chunk.
     void requestFftSize (int fftSize);
 
-    // Called on a non-audio thread (message thread) to apply pending resize
-    void applyPendingFftSizeIfNeeded();
+    /** Frame overlap. Fixed modes derive the hop from the FFT size; Auto derives it from
+        kAutoTargetFrameRateHz (the UI refresh rate), clamped to 0..87.5% overlap, so frames
+        nobody displays are never computed. RT-safe, applied at the next chunk. */
+    enum class Overlap
+    {
+        None = 0,       // hop = N
+        Half,           // hop = N / 2
+        ThreeQuarter,   // hop = N / 4 (default)
+        SevenEighths,   // hop = N / 8
+        Auto
+    };
+
+    void setOverlap (Overlap overlap) noexcept { requestedOverlap_.store (static_cast<int> (overlap), std::memory_order_relaxed); }
 
     void setAveragingMs (float averagingMs);
     void setSmoothingOctaves (float octaves);
@@ -78,117 +222,264 @@ public:
     void setReleaseTimeMs (float ms);
     
 private:
-    static constexpr int kMaxFFTSize = 8192;
+    // Supported FFT sizes: 2^kMinFFTOrder .. 2^kMaxFFTOrder (1024 .. 65536), all planned once in prepare().
+    // Sizes above 8192 are meant for the worker-thread mode: a 64k transform per 16k-sample hop
+    // then never lands inside an audio callback (inline mode is only used for offline rendering).
+    static constexpr int kMinFFTOrder = 10;
+    static constexpr int kMaxFFTOrder = 16;
+    static constexpr int kNumFFTSizes = kMaxFFTOrder - kMinFFTOrder + 1;
+    static constexpr int kMaxFFTSize = 1 << kMaxFFTOrder;
+    static constexpr int kMaxFFTBins = kMaxFFTSize / 2 + 1;
+    static_assert (kMaxFFTBins <= AnalyzerSnapshot::kMaxFFTBins, "Snapshot must hold the largest FFT");
     static constexpr float kDbFloor = -120.0f;
+    static constexpr double kAutoTargetFrameRateHz = 60.0;  // Matches the UI timer
+    static constexpr float kSilenceThreshold = 1.0e-15f;    // ~ -300 dBFS: zeros, denormals, anti-denormal noise
+    static constexpr double kSilenceIdleMaxSeconds = 10.0;  // Idle even if long releases have not reached the floor
+    static constexpr double kSilenceLtasRefreshSeconds = 0.1; // Idle with LTAS on: publish its diluted average this often
+    
+    static constexpr int kMaxDecimationStages = 5;           // 384 kHz -> 12 kHz (5 kHz bandwidth)
+    static constexpr int kDecimationChunk = 1024;            // Input samples per front-end pass
+    static constexpr int kHopBudgetHeadroom = 2;             // Bounded inline mode: 2 x a prepared block's hops
+    static constexpr int kMinRingSamples = 65536;            // Largest host block the ring takes whole (offline renders)
     
     int currentFFTSize = 2048;
     int currentHopSize = 512;
+    int currentFFTOrder = 11;
+    
+    /** Non-owning view into the preallocated arena (capacity is always kMaxFFTSize-based).
+        size() tracks the active FFT size, so per-bin loops stay bounded to the current size. */
+    template <typename T>
+    struct ArenaBuffer
+    {
+        T* ptr = nullptr;
+        std::size_t count = 0;
+        
+        T* data() const noexcept { return ptr; }
+        std::size_t size() const noexcept { return count; }
+        bool empty() const noexcept { return count == 0; }
+        T* begin() const noexcept { return ptr; }
+        T* end() const noexcept { return ptr + count; }
+        T& operator[] (std::size_t i) const noexcept { return ptr[i]; }
+    };
     
-    // FFT (dynamically sized, max kMaxFFTSize)
-    std::unique_ptr<juce::dsp::FFT> fft;
-    std::vector<float> fftOutput;  // In-place buffer: input (first fftSize) + complex output (2*fftSize)
-    std::vector<float> window;
-    std::vector<float> fifoBuffer;
-    int fifoWritePos = 0;
-    int samplesCollected = 0;
+    // Single aligned arena holding every per-size and per-bin buffer (allocated once in prepare)
+    juce::HeapBlock<char> arena_;
+    std::size_t arenaBytes_ = 0;
     
-    // Published snapshot for lock-free transport (audio thread writes, UI thread reads)
-    PublishedAnalyzerSnapshot published_;
+    // FFT plans for every supported size + matching Hann windows (all live in/alongside the arena)
+    std::array<std::unique_ptr<juce::dsp::FFT>, kNumFFTSizes> fftPlans_;
+    std::array<float*, kNumFFTSizes> windows_ {};
+    
+    // Bin -> bands/log matrices for every supported size (rebuilt in prepare, swapped with the plan)
+    std::array<SpectrumResampler, kNumFFTSizes> resamplers_;
+    const SpectrumResampler* resampler_ = nullptr;
+    
+    // Active FFT (points into fftPlans_/windows_; swapped by index, never reallocated)
+    // Stereo is analysed with ONE complex transform per hop: L is packed into the real part,
+    // R into the imaginary part, and the two spectra are separated via conjugate symmetry.
+    juce::dsp::FFT* fft = nullptr;
+    const float* window = nullptr;
+    ArenaBuffer<juce::dsp::Complex<float>> fftInput_;     // Windowed L + jR (fftSize)
+    ArenaBuffer<juce::dsp::Complex<float>> fftSpectrum_;  // Complex transform output (fftSize)
+    ArenaBuffer<float> freqSmoothed_;                     // Scratch: octave-smoothed mono power (numBins)
+    int fifoWritePos = 0;      // Shared write position for the L/R FIFOs (0..kMaxFFTSize-1)
+    int samplesCollected = 0;  // Samples since last hop
+    
+    // Triple-buffered snapshot transport: the analysis context fills the back slot in place and
+    // publishes it with one atomic exchange, the UI reads the front slot in place.
+    AnalyzerSnapshotTripleBuffer snapshots_;
     
     // State
-    AnalyzerSnapshot stagingSnapshot_; // Pre-allocated scratch snapshot (avoids stack allocation)
-    double currentSampleRate = 44100.0;
+    double currentSampleRate = 44100.0;   // Analysis rate (after the decimating front end)
+    
+    // Decimating front end (analysis context): per-channel halfband cascades into fixed scratch
+    using HalfbandDecimator = AnalyzerPro::dsp::HalfbandDecimator;
+    std::array<std::array<HalfbandDecimator, kMaxDecimationStages>, 2> decimators_;
+    std::array<std::array<float, kDecimationChunk / 2 + 1>, 2> decimated_ {};
+    int numDecimationStages_ = 0;
+    double analysisBandwidthRequestedHz_ = 0.0;   // Applied on next prepare()
     bool prepared = false;
     
     
     // Smoothing buffers (Power domain) - Legacy single-channel
-    std::vector<float> smoothedMagnitude; // RMS State
-    std::vector<float> smoothedPeak;      // Peak State (Restored for Ballistics)
-
-    // Multi-trace complex bin storage (for L/R channels)
-    std::vector<float> fftOutputL;  // Complex FFT output for Left channel
-    std::vector<float> fftOutputR;  // Complex FFT output for Right channel
-    
-    // Multi-trace power spectrum storage (derived from complex bins)
-    std::vector<float> powerL_;      // Power spectrum for Left
-    std::vector<float> powerR_;      // Power spectrum for Right
-    std::vector<float> powerMono_;   // Power spectrum for Mono (L+R)/2
-    std::vector<float> powerMid_;    // Power spectrum for Mid (L+R)/2
-    std::vector<float> powerSide_;   // Power spectrum for Side (L-R)/2
-    
-    // Multi-trace smoothed power (RMS ballistics)
-    std::vector<float> smoothedL_;
-    std::vector<float> smoothedR_;
-    std::vector<float> smoothedMono_;
-    std::vector<float> smoothedMid_;
-    std::vector<float> smoothedSide_;
-    
-    // Multi-trace peak hold
-    std::vector<float> peakL_;
-    std::vector<float> peakR_;
-    std::vector<float> peakMono_;
-    std::vector<float> peakMid_;
-    std::vector<float> peakSide_;
-
-    std::vector<int> smoothLowBounds;
-    std::vector<int> smoothHighBounds;
-    std::vector<float> prefixSumMag; 
-    std::vector<float> peakHold;
-
-    // Per-frame computation buffers (resized in initializeFFT, reused to avoid allocations)
-    std::vector<float> magnitudes_;
-    std::vector<float> dbValues_;
-    std::vector<float> dbRaw_;  // Ballistic (smoothed) Peak dB
-    std::vector<float> dbInstant_; // Instantaneous (raw) Peak dB
+    ArenaBuffer<float> smoothedMagnitude; // RMS State
+    ArenaBuffer<float> smoothedPeak;      // Peak State (Restored for Ballistics)
+    bool seedBallistics_ = true;          // After a size swap: start ballistics from the first frame
+    bool spectrumGated_ = false;          // No Spectrum consumer at the last hop (reseed on resume)
+
+    // Digital-silence fast path (analysis context): once the window is silent and the ballistics have
+    // decayed, one floor snapshot is published and the transform stops until signal returns
+    int64_t silentSamples_ = 0;           // Consecutive input samples at or below kSilenceThreshold
+    bool tracesAtFloor_ = false;          // Last published RMS and peak traces were entirely at kDbFloor
+    bool silenceIdle_ = false;            // Transform stopped (FIFOs still filled)
+    int64_t idleSamplesSinceFrame_ = 0;   // Analysis-rate samples of skipped hops since the last full frame
+    std::array<std::atomic<int>, static_cast<std::size_t> (Product::NumProducts)> consumers_ {};
+
+    // Multi-trace power spectrum storage (derived from the split complex bins)
+    // Mono/Mid (L+R)/2 lives in magnitudes_ (it feeds the main RMS/Peak pipeline).
+    ArenaBuffer<float> powerL_;      // Power spectrum for Left
+    ArenaBuffer<float> powerR_;      // Power spectrum for Right
+    ArenaBuffer<float> powerSide_;   // Power spectrum for Side (L-R)/2 (phase-correct, from complex bins)
+
+    ArenaBuffer<int> smoothLowBounds;
+    ArenaBuffer<int> smoothHighBounds;
+    ArenaBuffer<float> prefixSumMag;  // numBins + 1
+    ArenaBuffer<float> peakHold;
+
+    // Per-frame computation buffers (carved from the arena, reused to avoid allocations)
+    ArenaBuffer<float> magnitudes_;
+    ArenaBuffer<float> dbValues_;
+    ArenaBuffer<float> dbRaw_;  // Ballistic (smoothed) Peak dB
+    ArenaBuffer<float> dbInstant_; // Instantaneous (raw) Peak dB
 
     // Ballistics Parameters (ms)
+    // Setters may run on the audio or message thread while the analysis context reads them,
+    // so the runtime-adjustable values are atomics.
     float rmsAttackMs_ = 80.0f;
-    float rmsReleaseMs_ = 250.0f;
+    std::atomic<float> rmsReleaseMs_ { 250.0f };
     
     float peakAttackMs_ = 10.0f;   // Fast attack for peaks
-    float peakReleaseMs_ = 80.0f;  // Default release (will be overridden by setReleaseTimeMs)
+    std::atomic<float> peakReleaseMs_ { 80.0f };  // Default release (will be overridden by setReleaseTimeMs)
     
-    float smoothingOctaves_ = 1.0f; // 0 = Off
-    float peakDecayDbPerSec = 1.0f;
+    float smoothingOctaves_ = 1.0f; // 0 = Off (analysis context copy)
+    std::atomic<float> requestedSmoothingOctaves_ { 1.0f };  // Applied at the next hop
+    std::atomic<float> peakDecayDbPerSec { 1.0f };
     bool peakHoldEnabled_ = true;  // Always enabled now (toggled by Hold logic)
     std::atomic<bool> freezePeaks_{ false };      // Atomic for thread safety
+    std::atomic<bool> peakResetRequested_{ false }; // resetPeaks() is consumed at the next hop
 
     PeakDecayCurve peakDecayCurve_ = PeakDecayCurve::DbPerSec;
     float peakDecayTimeConstantSec_ = 1.0f;
 
-    // Pending FFT resize request (RT-safe)
-    std::atomic<int> pendingFftSize_{ 0 };
-    std::atomic<bool> fftResizeRequested_{ false };
+    // Requested FFT order (RT-safe index swap, applied by the analysis context)
+    std::atomic<int> requestedFftOrder_{ 11 };
+    // Requested/active overlap (Overlap enum value); only the hop length depends on it
+    std::atomic<int> requestedOverlap_ { static_cast<int> (Overlap::ThreeQuarter) };
+    Overlap currentOverlap_ = Overlap::ThreeQuarter;
     // shouldResetHoldToLive_ removed in V2 (using local edge detection)
 
     // Peak hold mode/timer (used by updatePeakHold)
     PeakHoldMode peakHoldMode_ = PeakHoldMode::HoldThenDecay;
     float peakHoldTimeMs_ = 0.0f;
-    std::vector<int> peakHoldFramesRemaining_;
+    ArenaBuffer<int> peakHoldFramesRemaining_;
     
 
     
     StereoScopeAnalyzer stereoScopeAnalyzer;
     
+    // Multi-resolution LOG spectrum (fixed-size state, prepared alongside the arena)
+    MultiResolutionAnalyzer multiRes_;
+    std::atomic<bool> multiResRequested_ { false };
+    bool multiResActive_ = false;    // Analysis context copy
+    bool seedMultiRes_ = true;       // Start the multi-res ballistics from the first frame
+    std::array<float, MultiResolutionAnalyzer::kNumLogPoints> multiResPower_ {};
+    std::array<float, MultiResolutionAnalyzer::kNumLogPoints> multiResRms_ {};
+    std::array<float, MultiResolutionAnalyzer::kNumLogPoints> multiResPeak_ {};
+    
+    // Filter-bank RTA (fixed-size state, every resolution designed in prepare)
+    FilterBankAnalyzer filterBank_;
+    std::atomic<bool> filterBankRequested_ { false };
+    std::atomic<int> requestedBandsPerOctave_ { 3 };
+    bool filterBankActive_ = false;  // Analysis context copy
+    bool seedFilterBank_ = true;     // Start the band ballistics from the first frame
+    std::array<float, FilterBankAnalyzer::kMaxBands> filterBankPower_ {};
+    std::array<float, FilterBankAnalyzer::kMaxBands> filterBankRms_ {};
+    std::array<float, FilterBankAnalyzer::kMaxBands> filterBankPeak_ {};
+    
+    // Spectrogram history (ring allocated once in the SpectrogramHistory constructor)
+    SpectrogramHistory spectrogram_;
+    std::array<float, SpectrogramHistory::kNumColumns> spectrogramRow_ {};
+    
+    // Long-term average spectrum (sums allocated once in the LtasAccumulator constructor)
+    LtasAccumulator ltas_ { kMaxFFTBins };
+    std::atomic<bool> ltasRequested_ { false };
+    std::atomic<bool> ltasResetRequested_ { false };
+    std::array<float, LtasAccumulator::kNumBands> ltasBandPower_ {};
+    std::array<float, LtasAccumulator::kNumLogPoints> ltasLogPower_ {};
+    
+    void applyPendingMultiResolution();
+    void applyPendingFilterBank();
+    void writeSpectrogramRow() noexcept;
+    void accumulateLtas (int numBins) noexcept;
+    void writeLtasTraces (AnalyzerSnapshot& snapshot, int numBins) noexcept;
+    // Bands (unless the filter bank provides them) and Log series from the RMS power and ballistic peak
+    // (called from computeFFT)
+    void writeResampledTraces (AnalyzerSnapshot& snapshot, bool includeBands);
+    // Ballistics + dB conversion of the filter-bank band powers into BandsDb/BandsPeakDb (called from computeFFT)
+    void writeFilterBankTraces (AnalyzerSnapshot& snapshot, float rmsAttCoeff, float rmsRelCoeff,
+                                float peakAttCoeff, float peakRelCoeff);
+    // Attack/release ballistics shared by the multi-res and filter-bank series (power domain)
+    static void applyPowerBallistics (const float* power, float* rms, float* peak, int numPoints, bool seed,
+                                      float rmsAttCoeff, float rmsRelCoeff, float peakAttCoeff, float peakRelCoeff) noexcept;
+    // Ballistics + dB conversion of the multi-res spectrum into the snapshot (called from computeFFT)
+    void writeMultiResolutionTraces (AnalyzerSnapshot& snapshot, float rmsAttCoeff, float rmsRelCoeff,
+                                     float peakAttCoeff, float peakRelCoeff);
+    
+    StageProfiler* profiler_ = nullptr;
+    int64_t profileBegin() const noexcept { return profiler_ != nullptr ? profiler_->begin() : 0; }
+    void profileEnd (StageProfiler::Stage stage, int64_t start) noexcept { if (profiler_ != nullptr) profiler_->end (stage, start); }
+    
     // Multi-trace feature flag (ENABLED for L/R/Mono/Mid/Side traces)
-    bool enableMultiTrace_ = true;
+    bool enableMultiTrace_ = true;              // Analysis context copy, latched per hop
+    std::atomic<bool> multiTraceRequested_ { true };
     
-    // L/R-channel FIFOs for dual-FFT processing (Phase 4 True L/R)
-    std::vector<float> fifoBufferL_;
-    int fifoWritePosL_ = 0;
-    int samplesCollectedL_ = 0;
+    // L/R-channel FIFOs (mono input duplicates L into R). Mono/Mid/Side are derived from
+    // the split spectra by linearity, so no separate mono FIFO is needed.
+    // Mirrored layout at the MAX size: 2 * kMaxFFTSize floats, every sample is written at [pos] and
+    // [pos + kMaxFFTSize], so the latest N samples (any planned N) are contiguous and end at
+    // fifoWritePos + kMaxFFTSize. History survives FFT size swaps (no blackout).
+    ArenaBuffer<float> fifoBufferL_;
+    ArenaBuffer<float> fifoBufferR_;
     
-    std::vector<float> fifoBufferR_;
-    int fifoWritePosR_ = 0;
-    int samplesCollectedR_ = 0;
+    // Worker-thread analysis
+    class AnalysisClient;
+    juce::SharedResourcePointer<AnalysisScheduler> scheduler_;   // One pool for every instance
+    std::unique_ptr<AnalysisClient> analysisClient_;
+    bool analysisClientAdded_ = false;
+    bool analysisThreadRequested_ = false;  // Applied on next prepare()
+    bool useAnalysisThread_ = false;        // Active mode (fixed between prepare() calls)
+    juce::AbstractFifo analysisFifo_ { 1 };
+    std::vector<float> analysisRingL_;
+    std::vector<float> analysisRingR_;
+    std::atomic<uint32_t> analysisOverruns_ { 0 };
+    std::atomic<uint32_t> publishedFrames_ { 0 };    // Single writer (analysis context)
     
-    void initializeFFT (int fftSize);
+    // Per-callback hop budget (bounded inline mode), -1 = unlimited (pool and lockstep inline)
+    bool hopBudgetRequested_ = false;       // Applied on next prepare()
+    bool hopBudgetEnabled_ = false;
+    int hopBudgetBlockSamples_ = 0;         // Prepared block size at the analysis rate
+    int hopBudget_ = -1;
+
+    // Multichannel buses (own rings and worker pool, idle for mono/stereo)
+    MultichannelAnalyzer multichannel_;
+    int numInputChannelsRequested_ = 2;     // Applied on next prepare()
+
+    void stopAnalysisThread();
+    void pushToAnalysisRing (const float* left, const float* right, int numSamples) noexcept;
+    bool drainAnalysisFifo();    // Analysis context: consume queued samples (within the hop budget), false if idle
+
+    // Front end shared by inline and worker modes (analysis context only): decimates when enabled,
+    // then runs the hop loop at the analysis rate. Returns the samples consumed (fewer once the
+    // hop budget is spent).
+    int processSamples (const float* left, const float* right, int numSamples);
+    void processAnalysisRateSamples (const float* left, const float* right, int numSamples);
+    void clearPeakState();
+
+    // Allocation (prepare only): plan every size and carve all buffers from one aligned arena
+    void allocateArena();
+    // RT-safe: point the active FFT/window/buffer views at a preplanned size and reset state
+    void selectFftOrder (int fftOrder);
+    void applyPendingFftSize();
+    // RT-safe: derive currentHopSize from the active FFT size, overlap mode and sample rate
+    void updateHopSize();
     // void updateSmoothingCoeff (float averagingMs, double sampleRate); // Removed in favor of Attack/Release ballistics
     void updateSmoothingBounds();
     
     void computeFFT();
-    void applyWindow(const std::vector<float>& fifoIn, int writePos);  // Parameterized for dual-FFT
-    void extractMagnitudes(float* powerOut, int numBins);  // Extract power from fftOutput
+    // Bulk-append numSamples (<= kMaxFFTSize) to the mirrored L/R FIFOs
+    void appendToFifo (const float* left, const float* right, int numSamples);
+    // Window + pack L/R, run one complex FFT and split into powerL_/powerR_/magnitudes_/powerSide_
+    void performStereoFFT();
     void convertToDb (const float* magnitudes, float* dbOut, int numBins);
     // V1 Strict: dbInstant for Latch, dbBallistic (dbRaw_) for Release floor
     void updatePeakHold (const float* dbInstant, const float* dbBallistic, float* peakOut, int numBins);
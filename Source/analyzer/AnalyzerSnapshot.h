@@ -3,51 +3,68 @@
 #include <array>
 #include <atomic>
 #include <cstdint>
-#include <vector>
+#include <cstring>
+#include <memory>
 
 //==============================================================================
 /**
     Snapshot of analyzer data for transport from audio thread to UI thread.
-    Pure data structure (no atomics) - trivially copyable.
+
+    Compact layout: a small header plus ONE packed structure-of-arrays block.
+    Only the traces actually produced for a frame are present, each sized to its
+    real length (fftBinCount for FFT traces), so copies and cache traffic scale
+    with the active FFT size instead of the maximum.
+
+    Storage is reserved once (reserve(), allocating); resetLayout()/addTrace()/copyFrom()
+    never allocate and are safe on the audio thread. The reservation is left uninitialised,
+    so pages beyond the active FFT size are never touched (no cold worst-case footprint).
 */
 struct AnalyzerSnapshot
 {
-    static constexpr int kMaxFFTSize = 8192;
-    static constexpr int kMaxFFTBins = 8192;  // Headroom for 8192 FFT (4097 bins) + future expansion
-    
-    // Multi-trace FFT data (dB values)
-    // Each trace has its own spectrum for independent rendering
-    std::array<float, kMaxFFTBins> fftDbL{};      // Left channel
-    std::array<float, kMaxFFTBins> fftDbR{};      // Right channel
-    std::array<float, kMaxFFTBins> fftDbMono{};   // Mono (L+R)/2
-    std::array<float, kMaxFFTBins> fftDbMid{};    // Mid (L+R)/2 (same as Mono, different label)
-    std::array<float, kMaxFFTBins> fftDbSide{};   // Side (L-R)/2
-    
-    // Peak hold versions for each trace
-    std::array<float, kMaxFFTBins> fftPeakDbL{};
-    std::array<float, kMaxFFTBins> fftPeakDbR{};
-    std::array<float, kMaxFFTBins> fftPeakDbMono{};
-    std::array<float, kMaxFFTBins> fftPeakDbMid{};
-    std::array<float, kMaxFFTBins> fftPeakDbSide{};
-    
-    // Peak Hold versions (Maximum envelope, slow/no decay)
-    std::array<float, kMaxFFTBins> fftPeakHoldDbL{};
-    std::array<float, kMaxFFTBins> fftPeakHoldDbR{};
-    std::array<float, kMaxFFTBins> fftPeakHoldDbMono{};
-    std::array<float, kMaxFFTBins> fftPeakHoldDbMid{};
-    std::array<float, kMaxFFTBins> fftPeakHoldDbSide{};
-    
-    // Legacy/Main Peak Hold (corresponding to fftDb)
-    std::array<float, kMaxFFTBins> fftPeakHoldDb{};
-    
-    // Power domain arrays for UI-side derivation of Mono/Mid/Side
-    // These are in linear power (NOT dB), enabling proper spectral math
-    std::array<float, kMaxFFTBins> powerL{};
-    std::array<float, kMaxFFTBins> powerR{};
-    
-    // Legacy single-spectrum arrays (kept for backward compatibility, will be populated with Mono)
-    std::array<float, kMaxFFTBins> fftDb{};
-    std::array<float, kMaxFFTBins> fftPeakDb{};
+    static constexpr int kMaxFFTSize = 65536;
+    static constexpr int kMaxFFTBins = kMaxFFTSize / 2 + 1;
+
+    /** Trace ids in the packed block. A frame only carries the traces that were produced. */
+    enum class Trace : int
+    {
+        FftDb = 0,       // Main (Mono/Mid) RMS spectrum, dB
+        FftPeakDb,       // Ballistic peak, dB
+        FftPeakHoldDb,   // Peak hold (maximum envelope), dB - only present when peak hold is active
+
+        // Power domain traces for the multi-trace display (linear power, NOT dB)
+        // Mid/Side are derived from the complex bins in the engine, so they keep inter-channel phase.
+        PowerL,
+        PowerR,
+        PowerMid,        // (L+R)/2, also used for Mono
+        PowerSide,       // (L-R)/2
+
+        // Multi-resolution LOG spectrum (MultiResolutionAnalyzer::kNumLogPoints log-spaced points, dB)
+        // Only present while multi-resolution mode is active.
+        MultiResDb,
+        MultiResPeakDb,
+
+        // Engine-resampled display series (SpectrumResampler), dB:
+        // 1/3-octave bands (SpectrumResampler::kNumBands) and log points (SpectrumResampler::kNumLogPoints).
+        // With the filter-bank RTA active, BandsDb/BandsPeakDb come from FilterBankAnalyzer instead
+        // (grid given by bandsPerOctave).
+        BandsDb,         // Mean power of the RMS spectrum per band
+        BandsPeakDb,     // Max of the ballistic peak per band (filter bank: ballistic band peak)
+        LogDb,
+        LogPeakDb,
+
+        // Long-term average spectrum (LtasAccumulator), dB: per FFT bin, per 1/3-octave band
+        // (SpectrumResampler grid) and per log point. Only present while LTAS is enabled.
+        LtasDb,
+        LtasBandsDb,
+        LtasLogDb,
+
+        NumTraces
+    };
+
+    static constexpr int kNumTraces = static_cast<int> (Trace::NumTraces);
+
+    /** Worst case packed size: every trace at the maximum bin count. */
+    static constexpr int kMaxPackedFloats = kNumTraces * kMaxFFTBins;
 
     // FFT: authoritative bin count for all spectra
     // Contract: fftBinCount == (fftSize / 2 + 1).
@@ -58,27 +75,197 @@ struct AnalyzerSnapshot
     // exclusively. numBins is reserved for non-FFT series (Bands/Log) if/when those are ever stored
     // in the snapshot directly.
     int numBins = 0;
-    
+
     // Metadata
     double sampleRate = 48000.0;
     int fftSize = 2048;
+    // Band grid of BandsDb/BandsPeakDb: 1/bandsPerOctave octave (FilterBankAnalyzer numbering;
+    // 3 is also the FFT resampler's ISO 1/3-octave set)
+    int bandsPerOctave = 3;
+    // LTAS span: frames and seconds averaged into LtasBandsDb/LtasLogDb, and seconds in LtasDb
+    // (the per-bin average restarts when the FFT size changes). 0 while LTAS is off.
+    uint64_t ltasFrameCount = 0;
+    double ltasDurationSec = 0.0;
+    double ltasBinDurationSec = 0.0;
     float displayBottomDb = -90.0f;
     float displayTopDb = 0.0f;
     // Validity flag (set to true after first valid FFT)
     bool isValid = false;
-    
+
     // Debug / Status
     bool isHoldOn = false;
     bool multiTraceEnabled = false;
+
+    //==============================================================================
+    AnalyzerSnapshot() noexcept { resetLayout(); }
+
+    /** Allocates packed storage (message thread / prepare only). Never shrinks. */
+    void reserve (int numFloats)
+    {
+        if (numFloats <= capacity_)
+            return;
+
+        std::unique_ptr<float[]> grown (new float[static_cast<std::size_t> (numFloats)]);
+        if (usedFloats_ > 0)
+            std::memcpy (grown.get(), storage_.get(), static_cast<std::size_t> (usedFloats_) * sizeof (float));
+
+        storage_ = std::move (grown);
+        capacity_ = numFloats;
+    }
+
+    int capacity() const noexcept { return capacity_; }
+
+    /** Number of floats in use by the current layout (what copyFrom() actually moves). */
+    int getPackedSize() const noexcept { return usedFloats_; }
+
+    /** Drops all traces (keeps storage). */
+    void resetLayout() noexcept
+    {
+        offsets_.fill (-1);
+        lengths_.fill (0);
+        usedFloats_ = 0;
+    }
+
+    /** Appends a trace of the given length and returns its (uninitialised) data,
+        or nullptr if the reserved storage is too small. Each trace may only be added once per layout. */
+    float* addTrace (Trace t, int length) noexcept
+    {
+        const auto i = index (t);
+        if (length <= 0 || offsets_[i] >= 0 || usedFloats_ + length > capacity())
+            return nullptr;
+
+        offsets_[i] = usedFloats_;
+        lengths_[i] = length;
+        usedFloats_ += length;
+        return storage_.get() + offsets_[i];
+    }
+
+    bool hasTrace (Trace t) const noexcept { return offsets_[index (t)] >= 0; }
+    int getTraceLength (Trace t) const noexcept { return lengths_[index (t)]; }
+
+    /** Trace data, or nullptr if the trace is not present in this frame. */
+    const float* getTrace (Trace t) const noexcept
+    {
+        const int offset = offsets_[index (t)];
+        return offset >= 0 ? storage_.get() + offset : nullptr;
+    }
+
+    float* getTrace (Trace t) noexcept
+    {
+        const int offset = offsets_[index (t)];
+        return offset >= 0 ? storage_.get() + offset : nullptr;
+    }
+
+    /** Copies header + layout + only the used part of the packed block (no allocation).
+        Returns false (and leaves this snapshot invalid) if the source does not fit the reserved storage. */
+    bool copyFrom (const AnalyzerSnapshot& other) noexcept
+    {
+        copyHeaderFrom (other);
+
+        const int used = other.usedFloats_;
+        if (used < 0 || used > capacity() || used > other.capacity())
+        {
+            resetLayout();
+            isValid = false;
+            return false;
+        }
+
+        offsets_ = other.offsets_;
+        lengths_ = other.lengths_;
+        usedFloats_ = used;
+
+        if (used > 0)
+            std::memcpy (storage_.get(), other.storage_.get(), static_cast<std::size_t> (used) * sizeof (float));
+
+        return true;
+    }
+
+private:
+    static std::size_t index (Trace t) noexcept { return static_cast<std::size_t> (t); }
+
+    void copyHeaderFrom (const AnalyzerSnapshot& other) noexcept
+    {
+        fftBinCount = other.fftBinCount;
+        numBins = other.numBins;
+        sampleRate = other.sampleRate;
+        fftSize = other.fftSize;
+        bandsPerOctave = other.bandsPerOctave;
+        ltasFrameCount = other.ltasFrameCount;
+        ltasDurationSec = other.ltasDurationSec;
+        ltasBinDurationSec = other.ltasBinDurationSec;
+        displayBottomDb = other.displayBottomDb;
+        displayTopDb = other.displayTopDb;
+        isValid = other.isValid;
+        isHoldOn = other.isHoldOn;
+        multiTraceEnabled = other.multiTraceEnabled;
+    }
+
+    std::unique_ptr<float[]> storage_;             // Packed SoA block (capacity fixed by reserve())
+    int capacity_ = 0;
+    std::array<int, kNumTraces> offsets_;          // Start of each trace in storage_, -1 = absent
+    std::array<int, kNumTraces> lengths_;
+    int usedFloats_ = 0;
 };
 
 //==============================================================================
 /**
-    Published snapshot wrapper with atomic sequence counter for lock-free transport.
-    Used internally by AnalyzerEngine for thread-safe snapshot publishing.
+    Lock-free triple buffer for snapshot transport (single producer, single consumer).
+
+    The producer fills the back slot in place and publishes it with ONE atomic exchange;
+    the consumer swaps the freshest slot to the front and reads it in place. No deep copies,
+    no torn reads, no retries - the producer never touches the slot the consumer holds.
 */
-struct PublishedAnalyzerSnapshot
+class AnalyzerSnapshotTripleBuffer
 {
-    std::atomic<uint32_t> sequence{0};
-    AnalyzerSnapshot data;
+public:
+    AnalyzerSnapshotTripleBuffer() = default;
+
+    /** Allocates storage for all slots (call before producer/consumer start, e.g. in a constructor). */
+    void reserve (int numFloats)
+    {
+        for (auto& slot : slots_)
+            slot.reserve (numFloats);
+    }
+
+    //==============================================================================
+    /** Producer: slot to fill for the next frame (owned exclusively until publish()). */
+    AnalyzerSnapshot& getWriteSlot() noexcept { return slots_[static_cast<std::size_t> (writeIndex_)]; }
+
+    /** Producer: hands the write slot over as the latest frame (wait-free). */
+    void publish() noexcept
+    {
+        const uint32_t previous = middle_.exchange (static_cast<uint32_t> (writeIndex_) | kFreshBit,
+                                                    std::memory_order_acq_rel);
+        writeIndex_ = static_cast<int> (previous & kIndexMask);
+        publishCount_.fetch_add (1, std::memory_order_relaxed);
+    }
+
+    //==============================================================================
+    /** Consumer: latest published frame, read in place. Stays valid (and unchanged) until the
+        next acquireLatest() call. Returns nullptr before the first publish(). */
+    const AnalyzerSnapshot* acquireLatest() noexcept
+    {
+        if ((middle_.load (std::memory_order_relaxed) & kFreshBit) != 0)
+        {
+            const uint32_t previous = middle_.exchange (static_cast<uint32_t> (readIndex_), std::memory_order_acq_rel);
+            readIndex_ = static_cast<int> (previous & kIndexMask);
+            hasFrame_ = true;
+        }
+
+        return hasFrame_ ? &slots_[static_cast<std::size_t> (readIndex_)] : nullptr;
+    }
+
+    /** Total frames published so far (monotonic, diagnostics only). */
+    uint32_t getPublishCount() const noexcept { return publishCount_.load (std::memory_order_relaxed); }
+
+private:
+    static constexpr uint32_t kIndexMask = 0x3u;
+    static constexpr uint32_t kFreshBit = 0x4u;
+
+    std::array<AnalyzerSnapshot, 3> slots_;
+    std::atomic<uint32_t> middle_ { 1 };   // Slot index (+ fresh bit) shared between the two sides
+    int writeIndex_ = 0;                   // Producer-owned
+    int readIndex_ = 2;                    // Consumer-owned
+    bool hasFrame_ = false;                // Consumer-owned
+    std::atomic<uint32_t> publishCount_ { 0 };
 };
@@ -0,0 +1,370 @@
+#include "FilterBankAnalyzer.h"
+#include <cmath>
+#include <complex>
+
+namespace
+{
+    constexpr double kBaseTenOctave = 0.3;         // log10 (G), G = 10^(3/10)
+    constexpr double kLevelCentreLimit = 0.2;      // Band centre <= 0.2 * fs_level (alias-free tree output up to 0.4)
+    constexpr double kMaxUpperEdge = 0.49;         // Upper band edge must stay below 0.49 * fs
+
+    struct SectionCoeffs
+    {
+        double b0 = 0.0, a1 = 0.0, a2 = 0.0;
+    };
+
+    /** Butterworth band-pass (order 2 * NumSections) via LP -> BP transform of the analog
+        prototype and the bilinear transform with prewarped edges (the -3 dB points land
+        exactly on the band edges). The gain is normalised to unity at the nominal centre,
+        which IEC 61260 uses as the reference for the relative attenuation. */
+    template <std::size_t NumSections>
+    void designButterworthBandPass (double centreHz, double lowerHz, double upperHz, double sampleRate,
+                                    std::array<SectionCoeffs, NumSections>& sections) noexcept
+    {
+        using Complex = std::complex<double>;
+        constexpr int order = static_cast<int> (NumSections);
+        const double pi = juce::MathConstants<double>::pi;
+
+        const double twoFs = 2.0 * sampleRate;
+        const double w1 = twoFs * std::tan (pi * lowerHz / sampleRate);
+        const double w2 = twoFs * std::tan (pi * upperHz / sampleRate);
+        const double w0 = std::sqrt (w1 * w2);
+        const double bandwidth = w2 - w1;
+
+        // Each prototype pole p maps to the two roots of s^2 - p*B*s + w0^2. Complex roots in the
+        // upper half-plane form a section with their (implied) conjugate; real roots - only for
+        // wide bands, B > 2 * w0 - are paired with each other.
+        std::array<std::array<Complex, 2>, NumSections> sectionPoles {};
+        std::size_t numSections = 0;
+        Complex pendingReal {};
+        bool hasPendingReal = false;
+
+        for (int k = 0; k < order; ++k)
+        {
+            const Complex p = std::polar (1.0, pi * static_cast<double> (2 * k + order + 1) / static_cast<double> (2 * order));
+            const Complex root = std::sqrt (p * p * bandwidth * bandwidth - 4.0 * w0 * w0);
+
+            for (const Complex s : { 0.5 * (p * bandwidth + root), 0.5 * (p * bandwidth - root) })
+            {
+                if (numSections >= NumSections)
+                    break;
+
+                const Complex z = (twoFs + s) / (twoFs - s);
+
+                if (std::abs (s.imag()) <= 1.0e-9 * std::abs (s))
+                {
+                    if (hasPendingReal)
+                        sectionPoles[numSections++] = { pendingReal, Complex (z.real(), 0.0) };
+                    else
+                        pendingReal = Complex (z.real(), 0.0);
+
+                    hasPendingReal = ! hasPendingReal;
+                }
+                else if (s.imag() > 0.0)
+                {
+                    sectionPoles[numSections++] = { z, std::conj (z) };
+                }
+            }
+        }
+
+        const Complex e1 = std::polar (1.0, -2.0 * pi * centreHz / sampleRate);
+        const Complex e2 = e1 * e1;
+
+        for (std::size_t i = 0; i < numSections; ++i)
+        {
+            const auto& zp = sectionPoles[i];
+            SectionCoeffs& c = sections[i];
+            c.a1 = -(zp[0] + zp[1]).real();
+            c.a2 = (zp[0] * zp[1]).real();
+
+            // Numerator (1 - z^-2): one zero at DC, one at Nyquist. Sections are normalised one
+            // by one, so the cascade is unity at the centre as well
+            const double gainAtCentre = std::abs (1.0 - e2) / std::abs (1.0 + c.a1 * e1 + c.a2 * e2);
+            c.b0 = gainAtCentre > 0.0 ? 1.0 / gainAtCentre : 0.0;
+        }
+    }
+}
+
+//==============================================================================
+FilterBankAnalyzer::FilterBankAnalyzer()
+{
+    bank_ = &banks_[static_cast<std::size_t> (getResolutionIndex (bandsPerOctave_))];
+}
+
+int FilterBankAnalyzer::getResolutionIndex (int bandsPerOctave) noexcept
+{
+    switch (bandsPerOctave)
+    {
+        case 1:  return 0;
+        case 6:  return 2;
+        case 12: return 3;
+        default: return 1;
+    }
+}
+
+double FilterBankAnalyzer::getBandExponent (int bandsPerOctave, int bandNumber) noexcept
+{
+    // Base-10 octaves relative to 1 kHz: x / b for odd b, (2x + 1) / (2b) for even b
+    const double offset = (bandsPerOctave % 2 == 0) ? 0.5 : 0.0;
+    return (static_cast<double> (bandNumber) + offset) / static_cast<double> (bandsPerOctave);
+}
+
+void FilterBankAnalyzer::getBandRange (int bandsPerOctave, int& first, int& count) noexcept
+{
+    // Every band whose edges overlap [kMinFrequencyHz, kMaxFrequencyHz] by at least half a band
+    const double b = static_cast<double> (bandsPerOctave);
+    const double offset = (bandsPerOctave % 2 == 0) ? 0.5 : 0.0;
+    const double minExponent = std::log10 (kMinFrequencyHz / 1000.0) / kBaseTenOctave - 0.5 / b;
+    const double maxExponent = std::log10 (kMaxFrequencyHz / 1000.0) / kBaseTenOctave + 0.5 / b;
+
+    first = static_cast<int> (std::ceil (minExponent * b - offset));
+    const int last = static_cast<int> (std::floor (maxExponent * b - offset));
+    count = juce::jlimit (0, kMaxBands, last - first + 1);
+}
+
+int FilterBankAnalyzer::getNumBands (int bandsPerOctave) noexcept
+{
+    int first = 0, count = 0;
+    getBandRange (bandsPerOctave, first, count);
+    return count;
+}
+
+double FilterBankAnalyzer::getBandCentreHz (int bandsPerOctave, int index) noexcept
+{
+    int first = 0, count = 0;
+    getBandRange (bandsPerOctave, first, count);
+    return 1000.0 * std::pow (10.0, kBaseTenOctave * getBandExponent (bandsPerOctave, first + index));
+}
+
+int FilterBankAnalyzer::getNumBands() const noexcept
+{
+    return bank_->numBands;
+}
+
+//==============================================================================
+void FilterBankAnalyzer::prepare (double sampleRate)
+{
+    sampleRate_ = sampleRate;
+
+    constexpr int resolutions[kNumResolutions] = { 1, 3, 6, 12 };
+    for (const int bandsPerOctave : resolutions)
+        designBank (banks_[static_cast<std::size_t> (getResolutionIndex (bandsPerOctave))], bandsPerOctave);
+
+    reset();
+}
+
+void FilterBankAnalyzer::designBank (Bank& bank, int bandsPerOctave)
+{
+    bank.bandsPerOctave = bandsPerOctave;
+    bank.numLevels = 0;
+    bank.levelGroupBegin.fill (0);
+    bank.levelGroupEnd.fill (0);
+    bank.bandSlot.fill (-1);
+    bank.bandLevel.fill (0);
+
+    const Register zero = Register::expand (0.0f);
+    for (auto& group : bank.groups)
+    {
+        group.b0.fill (zero);
+        group.b2.fill (zero);
+        group.a1.fill (zero);
+        group.a2.fill (zero);
+    }
+
+    int first = 0;
+    getBandRange (bandsPerOctave, first, bank.numBands);
+    const double halfBand = std::pow (10.0, kBaseTenOctave * 0.5 / static_cast<double> (bandsPerOctave));
+
+    // Bands ascend in frequency, so levels only ever decrease: each level is one contiguous
+    // run of groups, opened on a fresh register whenever the level changes
+    int slot = 0;
+    int currentLevel = -1;
+
+    for (int i = 0; i < bank.numBands; ++i)
+    {
+        const double centre = getBandCentreHz (bandsPerOctave, i);
+        const double upper = centre * halfBand;
+        if (upper >= kMaxUpperEdge * sampleRate_)
+            continue;  // Bands only get higher from here: the rest stay inactive
+
+        int level = 0;
+        while (level + 1 < kMaxLevels
+               && centre <= kLevelCentreLimit * sampleRate_ / static_cast<double> (1 << (level + 1)))
+            ++level;
+
+        if (level != currentLevel)
+        {
+            slot = (slot + kLanes - 1) / kLanes * kLanes;
+            const int group = slot / kLanes;
+            if (group >= kMaxGroups)
+                break;
+
+            if (currentLevel >= 0)
+                bank.levelGroupEnd[static_cast<std::size_t> (currentLevel)] = group;
+
+            bank.levelGroupBegin[static_cast<std::size_t> (level)] = group;
+            bank.numLevels = juce::jmax (bank.numLevels, level + 1);
+            currentLevel = level;
+        }
+
+        std::array<SectionCoeffs, kNumSections> sections;
+        designButterworthBandPass (centre, centre / halfBand, upper, sampleRate_ / static_cast<double> (1 << level), sections);
+
+        Group& group = bank.groups[static_cast<std::size_t> (slot / kLanes)];
+        const auto lane = static_cast<std::size_t> (slot % kLanes);
+        for (std::size_t s = 0; s < sections.size(); ++s)
+        {
+            group.b0[s].set (lane, static_cast<float> (sections[s].b0));
+            group.b2[s].set (lane, static_cast<float> (-sections[s].b0));
+            group.a1[s].set (lane, static_cast<float> (sections[s].a1));
+            group.a2[s].set (lane, static_cast<float> (sections[s].a2));
+        }
+
+        bank.bandSlot[static_cast<std::size_t> (i)] = slot;
+        bank.bandLevel[static_cast<std::size_t> (i)] = level;
+        ++slot;
+    }
+
+    if (currentLevel >= 0)
+        bank.levelGroupEnd[static_cast<std::size_t> (currentLevel)] = (slot + kLanes - 1) / kLanes;
+}
+
+void FilterBankAnalyzer::reset() noexcept
+{
+    const Register zero = Register::expand (0.0f);
+    for (auto& bank : banks_)
+    {
+        for (auto& group : bank.groups)
+        {
+            group.z1.fill (zero);
+            group.z2.fill (zero);
+            group.energy = zero;
+        }
+    }
+
+    for (auto& decimator : decimators_)
+        decimator.reset();
+
+    levelSampleCount_.fill (0);
+    lastPower_.fill (0.0f);
+}
+
+void FilterBankAnalyzer::setBandsPerOctave (int bandsPerOctave) noexcept
+{
+    Bank* requested = &banks_[static_cast<std::size_t> (getResolutionIndex (bandsPerOctave))];
+    if (requested == bank_)
+        return;
+
+    bank_ = requested;
+    bandsPerOctave_ = requested->bandsPerOctave;
+    reset();
+}
+
+//==============================================================================
+void FilterBankAnalyzer::process (const float* left, const float* right, int numSamples) noexcept
+{
+    if (bank_->numLevels == 0)
+        return;
+
+    juce::ScopedNoDenormals noDenormals;  // Decaying IIR state in silence
+
+    int offset = 0;
+    while (offset < numSamples)
+    {
+        const int n = juce::jmin (kChunkSize, numSamples - offset);
+
+        // Mid = (L+R)/2 (same input as the Mono/Mid FFT trace)
+        for (int i = 0; i < n; ++i)
+            chunk_[static_cast<std::size_t> (i)] = 0.5f * (left[offset + i] + right[offset + i]);
+
+        // Level 0 runs on the chunk as is, every further level on the in-place decimated chunk
+        int levelSamples = n;
+        for (int level = 0; level < bank_->numLevels; ++level)
+        {
+            if (level > 0)
+                levelSamples = decimators_[static_cast<std::size_t> (level)].process (chunk_.data(), chunk_.data(), levelSamples);
+
+            if (levelSamples == 0)
+                break;
+
+            processLevel (*bank_, level, chunk_.data(), levelSamples);
+            levelSampleCount_[static_cast<std::size_t> (level)] += levelSamples;
+        }
+
+        offset += n;
+    }
+}
+
+void FilterBankAnalyzer::processLevel (Bank& bank, int level, const float* samples, int numSamples) noexcept
+{
+    const int groupBegin = bank.levelGroupBegin[static_cast<std::size_t> (level)];
+    const int groupEnd = bank.levelGroupEnd[static_cast<std::size_t> (level)];
+
+    for (int g = groupBegin; g < groupEnd; ++g)
+    {
+        Group& group = bank.groups[static_cast<std::size_t> (g)];
+
+        // State in registers for the whole run; kLanes bands advance per instruction
+        auto z1 = group.z1;
+        auto z2 = group.z2;
+        Register energy = group.energy;
+
+        for (int n = 0; n < numSamples; ++n)
+        {
+            Register x = Register::expand (samples[n]);
+
+            for (std::size_t s = 0; s < static_cast<std::size_t> (kNumSections); ++s)
+            {
+                const Register y = group.b0[s] * x + z1[s];
+                z1[s] = z2[s] - group.a1[s] * y;
+                z2[s] = group.b2[s] * x - group.a2[s] * y;
+                x = y;
+            }
+
+            energy += x * x;
+        }
+
+        group.z1 = z1;
+        group.z2 = z2;
+        group.energy = energy;
+    }
+}
+
+void FilterBankAnalyzer::readBandPower (float* dest) noexcept
+{
+    Bank& bank = *bank_;
+
+    for (int i = 0; i < bank.numBands; ++i)
+    {
+        const auto band = static_cast<std::size_t> (i);
+        const int slot = bank.bandSlot[band];
+        if (slot < 0)
+        {
+            dest[i] = 0.0f;
+            continue;
+        }
+
+        const int count = levelSampleCount_[static_cast<std::size_t> (bank.bandLevel[band])];
+        if (count > 0)
+        {
+            const float energy = bank.groups[static_cast<std::size_t> (slot / kLanes)].energy.get (static_cast<std::size_t> (slot % kLanes));
+            lastPower_[band] = 2.0f * energy / static_cast<float> (count);
+        }
+
+        dest[i] = lastPower_[band];
+    }
+
+    // Restart the averages of every level that contributed
+    const Register zero = Register::expand (0.0f);
+    for (int level = 0; level < bank.numLevels; ++level)
+    {
+        const auto l = static_cast<std::size_t> (level);
+        if (levelSampleCount_[l] == 0)
+            continue;
+
+        for (int g = bank.levelGroupBegin[l]; g < bank.levelGroupEnd[l]; ++g)
+            bank.groups[static_cast<std::size_t> (g)].energy = zero;
+
+        levelSampleCount_[l] = 0;
+    }
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include "../dsp/resampling/HalfbandDecimator.h"
+#include <array>
+
+//==============================================================================
+/**
+    Time-domain fractional-octave filter bank (IEC 61260-1 style RTA) for the BANDS view.
+
+    Every band is a 6th-order Butterworth band-pass (three biquads, bilinear with
+    prewarped edges) on the base-10 band grid: fm = 1000 * G^(x/b) (b odd) or
+    1000 * G^((2x+1)/(2b)) (b even), G = 10^(3/10), edges fm * G^(+/-1/(2b)).
+    1/1, 1/3, 1/6 and 1/12-octave banks are designed once in prepare().
+
+    The Mid signal runs through an octave decimation tree (HalfbandDecimator cascade):
+    each band is evaluated at the lowest rate where its centre stays <= 0.2 * fs_level,
+    so low bands neither waste cycles nor suffer from poles crowding z = 1 at the full rate.
+    Bands of one level are packed into SIMDRegister lanes and their biquads are evaluated
+    across bands in parallel (one broadcast input sample per level, no per-band loops).
+
+    Unlike FFT bands, the low bands do not depend on a long window: every band is updated
+    sample by sample and readBandPower() can be called at any rate.
+
+    Output power is 2 * mean square (a full-scale sine reads 0 dB, matching the FFT traces).
+    Bands whose upper edge does not fit below Nyquist read 0.
+
+    prepare() designs all banks (message thread). process()/readBandPower()/
+    setBandsPerOctave() are RT-safe.
+*/
+class FilterBankAnalyzer
+{
+public:
+    static constexpr int kNumSections = 3;        // Biquads per band (6th-order band-pass)
+    static constexpr int kMaxLevels = 11;         // Decimation levels (fs ... fs / 1024)
+    static constexpr int kMaxBands = 128;         // 1/12 octave over 20 Hz - 20 kHz needs 121
+    static constexpr float kMinFrequencyHz = 20.0f;
+    static constexpr float kMaxFrequencyHz = 20000.0f;
+    static constexpr int kNumResolutions = 4;     // 1/1, 1/3, 1/6, 1/12 octave
+
+    FilterBankAnalyzer();
+
+    /** Designs all banks for the sample rate, then resets. */
+    void prepare (double sampleRate);
+
+    /** Clears filter state, decimators and accumulated energy (RT-safe). */
+    void reset() noexcept;
+
+    /** Switches to the 1/bandsPerOctave bank (1, 3, 6 or 12; anything else selects 1/3).
+        Resets when the bank changes. RT-safe. */
+    void setBandsPerOctave (int bandsPerOctave) noexcept;
+    int getBandsPerOctave() const noexcept { return bandsPerOctave_; }
+
+    /** Number of bands of the active bank (same as getNumBands (getBandsPerOctave())). */
+    int getNumBands() const noexcept;
+
+    /** Feeds numSamples of L/R (analysed as Mid = (L+R)/2). RT-safe. */
+    void process (const float* left, const float* right, int numSamples) noexcept;
+
+    /** Writes getNumBands() power values averaged since the previous call and restarts the
+        averages. Decimated levels that received no sample since then repeat their last value. RT-safe. */
+    void readBandPower (float* dest) noexcept;
+
+    /** Band grid (independent of the sample rate, so the display layout never changes with it). */
+    static int getNumBands (int bandsPerOctave) noexcept;
+    static double getBandCentreHz (int bandsPerOctave, int index) noexcept;
+
+private:
+    using Register = juce::dsp::SIMDRegister<float>;
+    static constexpr int kLanes = static_cast<int> (Register::SIMDNumElements);
+    static constexpr int kChunkSize = 256;
+    // Each level starts on a fresh register, so padding costs at most kLanes - 1 slots per level
+    static constexpr int kMaxGroups = (kMaxBands + kMaxLevels * (kLanes - 1) + kLanes - 1) / kLanes;
+
+    /** kLanes bands of one level. TDF-II biquads with b1 = 0 and b2 = -b0 (band-pass zeros at DC
+        and Nyquist); padding lanes have all-zero coefficients and stay silent. */
+    struct Group
+    {
+        std::array<Register, kNumSections> b0, b2, a1, a2;
+        std::array<Register, kNumSections> z1, z2;
+        Register energy;
+    };
+
+    struct Bank
+    {
+        int bandsPerOctave = 3;
+        int numBands = 0;
+        int numLevels = 0;
+        std::array<int, kMaxBands> bandSlot {};              // Group * kLanes + lane, -1 = above Nyquist
+        std::array<int, kMaxBands> bandLevel {};
+        std::array<int, kMaxLevels> levelGroupBegin {};
+        std::array<int, kMaxLevels> levelGroupEnd {};
+        std::array<Group, kMaxGroups> groups;
+    };
+
+    static int getResolutionIndex (int bandsPerOctave) noexcept;
+    static void getBandRange (int bandsPerOctave, int& first, int& count) noexcept;
+    static double getBandExponent (int bandsPerOctave, int bandNumber) noexcept;
+
+    void designBank (Bank& bank, int bandsPerOctave);
+    static void processLevel (Bank& bank, int level, const float* samples, int numSamples) noexcept;
+
+    std::array<Bank, kNumResolutions> banks_;
+    Bank* bank_ = nullptr;
+    int bandsPerOctave_ = 3;
+    double sampleRate_ = 0.0;
+
+    std::array<AnalyzerPro::dsp::HalfbandDecimator, kMaxLevels> decimators_;   // [level] feeds level from level - 1
+    std::array<int, kMaxLevels> levelSampleCount_ {};                           // Samples since the last read
+    std::array<float, kMaxBands> lastPower_ {};
+    std::array<float, kChunkSize> chunk_ {};                                    // Mid, decimated in place down the tree
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FilterBankAnalyzer)
+};
@@ -0,0 +1,97 @@
+#include "LtasAccumulator.h"
+#include <algorithm>
+
+//==============================================================================
+LtasAccumulator::LtasAccumulator (int maxBins)
+    : binSums_ (static_cast<std::size_t> (juce::jmax (1, maxBins)), 0.0)
+{
+}
+
+void LtasAccumulator::reset() noexcept
+{
+    std::fill (binSums_.begin(), binSums_.end(), 0.0);
+    bandSums_.fill (0.0);
+    logSums_.fill (0.0);
+    frameCount_ = 0;
+    weight_ = 0.0;
+    binWeight_ = 0.0;
+}
+
+void LtasAccumulator::restartBins (int numBins) noexcept
+{
+    numBins_ = juce::jlimit (0, static_cast<int> (binSums_.size()), numBins);
+    std::fill (binSums_.begin(), binSums_.end(), 0.0);
+    binWeight_ = 0.0;
+}
+
+void LtasAccumulator::addFrame (const float* binPower, int numBins, const float* bandPower, const float* logPower,
+                                int hopSamples) noexcept
+{
+    if (binPower == nullptr || bandPower == nullptr || logPower == nullptr || hopSamples <= 0)
+        return;
+
+    if (numBins != numBins_)
+        restartBins (numBins);
+
+    // Hop-weighted sums: overlapping frames count for the new samples they bring, not twice
+    const double w = static_cast<double> (hopSamples);
+
+    double* bins = binSums_.data();
+    for (int i = 0; i < numBins_; ++i)
+        bins[i] += w * static_cast<double> (binPower[i]);
+
+    for (int i = 0; i < kNumBands; ++i)
+        bandSums_[static_cast<std::size_t> (i)] += w * static_cast<double> (bandPower[i]);
+
+    for (int i = 0; i < kNumLogPoints; ++i)
+        logSums_[static_cast<std::size_t> (i)] += w * static_cast<double> (logPower[i]);
+
+    ++frameCount_;
+    weight_ += w;
+    binWeight_ += w;
+}
+
+void LtasAccumulator::addSilentFrame (int numBins, int hopSamples) noexcept
+{
+    if (hopSamples <= 0)
+        return;
+
+    if (numBins != numBins_)
+        restartBins (numBins);
+
+    // Silence lowers the mean by diluting it: the sums stay, the weights grow
+    const double w = static_cast<double> (hopSamples);
+    ++frameCount_;
+    weight_ += w;
+    binWeight_ += w;
+}
+
+void LtasAccumulator::readMean (const double* sums, double weight, float* dest, int count) noexcept
+{
+    if (weight <= 0.0)
+    {
+        std::fill (dest, dest + count, 0.0f);
+        return;
+    }
+
+    const double scale = 1.0 / weight;
+    for (int i = 0; i < count; ++i)
+        dest[i] = static_cast<float> (sums[i] * scale);
+}
+
+void LtasAccumulator::readBinPower (float* dest, int numBins) const noexcept
+{
+    const int n = juce::jmin (numBins, numBins_);
+    readMean (binSums_.data(), binWeight_, dest, n);
+    std::fill (dest + n, dest + juce::jmax (n, numBins), 0.0f);
+}
+
+void LtasAccumulator::readBandPower (float* dest) const noexcept
+{
+    readMean (bandSums_.data(), weight_, dest, kNumBands);
+}
+
+void LtasAccumulator::readLogPower (float* dest) const noexcept
+{
+    readMean (logSums_.data(), weight_, dest, kNumLogPoints);
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "SpectrumResampler.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+//==============================================================================
+/**
+    Unbounded long-term average spectrum (LTAS).
+
+    Running power sums per FFT bin, per 1/3-octave band and per log point, updated
+    once per hop in O(bins) and never storing history. Each frame is weighted by the
+    number of new samples it covers (its hop), so the result is a time average whatever
+    the overlap, and the weights give the measured duration directly.
+
+    Sums are double precision: after 10 hours at 100 frames/s the relative rounding
+    error is still around 1e-9, so a session-long average does not drift or stall the
+    way float running sums do.
+
+    The per-bin sums follow the FFT bin layout and restart when it changes (restartBins);
+    the band/log sums are on fixed grids and keep accumulating across FFT size changes.
+
+    Storage is allocated in the constructor; everything else is RT-safe and runs on the
+    analysis context only.
+*/
+class LtasAccumulator
+{
+public:
+    static constexpr int kNumBands = SpectrumResampler::kNumBands;
+    static constexpr int kNumLogPoints = SpectrumResampler::kNumLogPoints;
+
+    explicit LtasAccumulator (int maxBins);
+
+    /** Clears every sum. */
+    void reset() noexcept;
+
+    /** Clears the per-bin sums only (bin layout changed). */
+    void restartBins (int numBins) noexcept;
+
+    /** Adds one frame of linear power (numBins bins, kNumBands bands, kNumLogPoints log points)
+        covering hopSamples new samples. */
+    void addFrame (const float* binPower, int numBins, const float* bandPower, const float* logPower,
+                   int hopSamples) noexcept;
+
+    /** Adds one frame of zero power (digital silence): only the weights move, O(1). */
+    void addSilentFrame (int numBins, int hopSamples) noexcept;
+
+    /** Mean power since the last reset (0 before the first frame). */
+    void readBinPower (float* dest, int numBins) const noexcept;
+    void readBandPower (float* dest) const noexcept;
+    void readLogPower (float* dest) const noexcept;
+
+    uint64_t getFrameCount() const noexcept { return frameCount_; }
+    /** Samples covered by the band/log averages. */
+    double getWeightSamples() const noexcept { return weight_; }
+    /** Samples covered by the per-bin average (less than getWeightSamples() after a bin restart). */
+    double getBinWeightSamples() const noexcept { return binWeight_; }
+
+private:
+    static void readMean (const double* sums, double weight, float* dest, int count) noexcept;
+
+    std::vector<double> binSums_;
+    std::array<double, kNumBands> bandSums_ {};
+    std::array<double, kNumLogPoints> logSums_ {};
+    int numBins_ = 0;
+    uint64_t frameCount_ = 0;
+    double weight_ = 0.0;
+    double binWeight_ = 0.0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LtasAccumulator)
+};
@@ -0,0 +1,170 @@
+#include "MultiResolutionAnalyzer.h"
+#include <cmath>
+
+MultiResolutionAnalyzer::MultiResolutionAnalyzer()
+{
+    // Same symmetric Hann as the engine (N - 1 denominator) so tone levels match exactly
+    const float pi = juce::MathConstants<float>::pi;
+    for (int n = 0; n < kTierFFTSize; ++n)
+        window_[static_cast<std::size_t> (n)] = 0.5f * (1.0f - std::cos (2.0f * pi * static_cast<float> (n)
+                                                                          / static_cast<float> (kTierFFTSize - 1)));
+}
+
+double MultiResolutionAnalyzer::getLogPointFrequency (int index) noexcept
+{
+    const double logMin = std::log10 (static_cast<double> (kMinFrequencyHz));
+    const double logMax = std::log10 (static_cast<double> (kMaxFrequencyHz));
+    return std::pow (10.0, logMin + (logMax - logMin) * static_cast<double> (index) / static_cast<double> (kNumLogPoints - 1));
+}
+
+void MultiResolutionAnalyzer::prepare (double sampleRate)
+{
+    sampleRate_ = sampleRate;
+
+    // Tier k owns (0.2, 0.4] * fs / 2^k. Enough tiers that the last one starts near 50 Hz
+    // (everything below is resolved by it at < 1 Hz/bin); 8 tiers at 44.1/48k, 10 at 192k.
+    const double octavesBelow = std::log2 (juce::jmax (1.0, sampleRate / 400.0));
+    numTiers_ = juce::jlimit (1, kMaxTiers, 1 + static_cast<int> (std::ceil (octavesBelow)));
+
+    for (int i = 0; i < kNumLogPoints; ++i)
+    {
+        const double centre = getLogPointFrequency (i);
+        const double lower = std::sqrt (centre * getLogPointFrequency (juce::jmax (0, i - 1)));
+        const double upper = std::sqrt (centre * getLogPointFrequency (juce::jmin (kNumLogPoints - 1, i + 1)));
+
+        // Highest-resolution tier whose band still contains the centre frequency
+        int tier = 0;
+        while (tier + 1 < numTiers_ && centre <= 0.2 * sampleRate / static_cast<double> (1 << tier))
+            ++tier;
+
+        const double binWidthHz = sampleRate / static_cast<double> (1 << tier) / static_cast<double> (kTierFFTSize);
+        const int lastBin = kTierNumBins - 1;
+
+        LogPoint& p = logPoints_[static_cast<std::size_t> (i)];
+        p.tier = (lower < 0.5 * sampleRate) ? tier : -1;   // Above Nyquist (decimated engine input): empty
+        p.bin0 = juce::jlimit (0, lastBin, static_cast<int> (std::ceil (lower / binWidthHz)));
+        p.bin1 = juce::jlimit (0, lastBin, static_cast<int> (std::floor (upper / binWidthHz)));
+        p.frac = 0.0f;
+
+        if (p.bin1 < p.bin0)
+        {
+            // Point narrower than a bin: interpolate between the two neighbouring bins
+            const double pos = juce::jlimit (0.0, static_cast<double> (lastBin), centre / binWidthHz);
+            p.bin0 = juce::jmin (lastBin - 1, static_cast<int> (pos));
+            p.bin1 = -1;
+            p.frac = static_cast<float> (pos - static_cast<double> (p.bin0));
+        }
+    }
+
+    reset();
+}
+
+void MultiResolutionAnalyzer::reset() noexcept
+{
+    for (auto& tier : tiers_)
+    {
+        tier.decimator.reset();
+        tier.fifo.fill (0.0f);
+        tier.writePos = 0;
+        tier.samplesSinceHop = 0;
+        tier.power.fill (0.0f);
+        tier.hasFrame = false;
+    }
+}
+
+void MultiResolutionAnalyzer::process (const float* left, const float* right, int numSamples) noexcept
+{
+    if (numTiers_ <= 0)
+        return;
+
+    int offset = 0;
+    while (offset < numSamples)
+    {
+        int n = juce::jmin (kChunkSize, numSamples - offset);
+
+        // Mid = (L + R) / 2
+        float* chunk = chunk_.data();
+        juce::FloatVectorOperations::add (chunk, left + offset, right + offset, n);
+        juce::FloatVectorOperations::multiply (chunk, 0.5f, n);
+        offset += n;
+
+        pushToTier (tiers_[0], chunk, n);
+
+        // Each stage halves the rate in place; the chunk shrinks as it goes down the cascade
+        for (int t = 1; t < numTiers_ && n > 0; ++t)
+        {
+            Tier& tier = tiers_[static_cast<std::size_t> (t)];
+            n = tier.decimator.process (chunk, chunk, n);
+            pushToTier (tier, chunk, n);
+        }
+    }
+}
+
+void MultiResolutionAnalyzer::pushToTier (Tier& tier, const float* samples, int numSamples) noexcept
+{
+    for (int i = 0; i < numSamples; ++i)
+    {
+        tier.fifo[static_cast<std::size_t> (tier.writePos)] = samples[i];
+        tier.fifo[static_cast<std::size_t> (tier.writePos + kTierFFTSize)] = samples[i];
+        tier.writePos = (tier.writePos + 1) & (kTierFFTSize - 1);
+
+        if (++tier.samplesSinceHop >= kTierHopSize)
+        {
+            tier.samplesSinceHop = 0;
+            analyseTier (tier);
+        }
+    }
+}
+
+void MultiResolutionAnalyzer::analyseTier (Tier& tier) noexcept
+{
+    const float* src = tier.fifo.data() + tier.writePos;  // Oldest first
+    juce::FloatVectorOperations::multiply (fftBuffer_.data(), src, window_.data(), kTierFFTSize);
+    std::fill (fftBuffer_.begin() + kTierFFTSize, fftBuffer_.end(), 0.0f);
+
+    fft_.performRealOnlyForwardTransform (fftBuffer_.data(), true);
+
+    // Same scaling as AnalyzerEngine::performStereoFFT: (2/N)^2 * 4 (Hann), DC/Nyquist * 0.25
+    const float scale = 2.0f / static_cast<float> (kTierFFTSize);
+    const float powerScale = (scale * scale) * 4.0f;
+
+    for (int k = 0; k < kTierNumBins; ++k)
+    {
+        const float re = fftBuffer_[static_cast<std::size_t> (2 * k)];
+        const float im = fftBuffer_[static_cast<std::size_t> (2 * k + 1)];
+        tier.power[static_cast<std::size_t> (k)] = (re * re + im * im) * powerScale;
+    }
+
+    tier.power[0] *= 0.25f;
+    tier.power[kTierNumBins - 1] *= 0.25f;
+    tier.hasFrame = true;
+}
+
+void MultiResolutionAnalyzer::renderLogPower (float* dest) const noexcept
+{
+    for (int i = 0; i < kNumLogPoints; ++i)
+    {
+        const LogPoint& p = logPoints_[static_cast<std::size_t> (i)];
+
+        if (p.tier < 0 || ! tiers_[static_cast<std::size_t> (p.tier)].hasFrame)
+        {
+            dest[i] = 0.0f;
+            continue;
+        }
+
+        const float* power = tiers_[static_cast<std::size_t> (p.tier)].power.data();
+
+        if (p.bin1 >= p.bin0)
+        {
+            // Peak-pick across the point's bins: a tone reads the same level in every tier
+            float maxPower = power[p.bin0];
+            for (int b = p.bin0 + 1; b <= p.bin1; ++b)
+                maxPower = juce::jmax (maxPower, power[b]);
+            dest[i] = maxPower;
+        }
+        else
+        {
+            dest[i] = power[p.bin0] + p.frac * (power[p.bin0 + 1] - power[p.bin0]);
+        }
+    }
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include "../dsp/resampling/HalfbandDecimator.h"
+#include <array>
+
+//==============================================================================
+/**
+    Multi-resolution (constant-Q style) spectrum for the LOG view.
+
+    Instead of one very long FFT, the Mid signal runs through a cascade of halfband
+    decimators. Every tier k sees the input at fs / 2^k and runs the same short
+    512-point FFT, so each octave gets roughly the same number of bins: tier 0 resolves
+    the top octaves at ~94 Hz/bin (fast update), the last tier resolves the bass at
+    well under 1 Hz/bin (the resolution of a 64k+ FFT at the full rate).
+
+    Every tier uses the same window and power scaling as AnalyzerEngine, so a tone reads
+    the same level whichever tier it lands in. Tier k owns (0.2, 0.4] * fs_k - safely
+    inside the decimators' alias-free passband - and the tiers are stitched into
+    kNumLogPoints log-spaced points (20 Hz - 20 kHz, same grid as the UI LOG mode).
+
+    prepare() may allocate (message thread). process()/renderLogPower() are RT-safe.
+*/
+class MultiResolutionAnalyzer
+{
+public:
+    static constexpr int kMaxTiers = 10;
+    static constexpr int kTierFFTOrder = 9;
+    static constexpr int kTierFFTSize = 1 << kTierFFTOrder;
+    static constexpr int kTierHopSize = kTierFFTSize / 4;   // 75% overlap at every tier
+    static constexpr int kTierNumBins = kTierFFTSize / 2 + 1;
+    static constexpr int kNumLogPoints = 256;
+    static constexpr float kMinFrequencyHz = 20.0f;
+    static constexpr float kMaxFrequencyHz = 20000.0f;
+
+    MultiResolutionAnalyzer();
+
+    /** Builds the tier layout and the log-point map for the sample rate, then resets. */
+    void prepare (double sampleRate);
+
+    /** Clears decimators, FIFOs and tier spectra (RT-safe). */
+    void reset() noexcept;
+
+    /** Feeds numSamples of L/R (analysed as Mid = (L+R)/2). Runs a tier FFT whenever a tier
+        completes a hop. RT-safe. */
+    void process (const float* left, const float* right, int numSamples) noexcept;
+
+    /** True once the top tier has produced a frame (the lower tiers fill in as they complete). */
+    bool hasOutput() const noexcept { return numTiers_ > 0 && tiers_[0].hasFrame; }
+
+    /** Writes kNumLogPoints linear power values (tiers without a frame yet read as 0). RT-safe. */
+    void renderLogPower (float* dest) const noexcept;
+
+    int getNumTiers() const noexcept { return numTiers_; }
+
+    /** Centre frequency of a log point (identical grid to the UI LOG conversion). */
+    static double getLogPointFrequency (int index) noexcept;
+
+private:
+    static constexpr int kChunkSize = 256;
+
+    struct Tier
+    {
+        AnalyzerPro::dsp::HalfbandDecimator decimator;     // Feeds this tier from the one above (unused for tier 0)
+
+        // Mirrored FIFO: each sample is written at [pos] and [pos + kTierFFTSize], so the
+        // latest kTierFFTSize samples are contiguous from [pos]
+        std::array<float, 2 * kTierFFTSize> fifo {};
+        int writePos = 0;
+        int samplesSinceHop = 0;
+
+        std::array<float, kTierNumBins> power {};         // Latest frame, linear power
+        bool hasFrame = false;
+    };
+
+    /** Precomputed stitching for one log point: max over bins [bin0, bin1] of one tier,
+        or linear interpolation at bin0 + frac when the point is narrower than a bin. */
+    struct LogPoint
+    {
+        int tier = 0;          // -1: above Nyquist, reads 0
+        int bin0 = 0;
+        int bin1 = -1;
+        float frac = 0.0f;
+    };
+
+    void pushToTier (Tier& tier, const float* samples, int numSamples) noexcept;
+    void analyseTier (Tier& tier) noexcept;
+
+    std::array<Tier, kMaxTiers> tiers_;
+    int numTiers_ = 0;
+    double sampleRate_ = 0.0;
+
+    juce::dsp::FFT fft_ { kTierFFTOrder };
+    std::array<float, kTierFFTSize> window_ {};
+    std::array<float, 2 * kTierFFTSize> fftBuffer_ {};    // performRealOnlyForwardTransform needs 2N
+    std::array<float, kChunkSize> chunk_ {};               // Mid, decimated in place down the cascade
+
+    std::array<LogPoint, kNumLogPoints> logPoints_ {};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MultiResolutionAnalyzer)
+};
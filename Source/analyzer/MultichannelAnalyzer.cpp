@@ -0,0 +1,376 @@
+#include "MultichannelAnalyzer.h"
+#include "../dsp/simd/SpectrumKernels.h"
+#include "../diagnostics/RealtimeGuard.h"
+#include <cmath>
+
+//==============================================================================
+void MultichannelAnalyzer::FrameTripleBuffer::publish() noexcept
+{
+    const uint32_t previous = middle_.exchange (static_cast<uint32_t> (writeIndex_) | kFreshBit,
+                                                std::memory_order_acq_rel);
+    writeIndex_ = static_cast<int> (previous & kIndexMask);
+}
+
+const MultichannelAnalyzer::Frame* MultichannelAnalyzer::FrameTripleBuffer::acquireLatest() noexcept
+{
+    if ((middle_.load (std::memory_order_relaxed) & kFreshBit) != 0)
+    {
+        const uint32_t previous = middle_.exchange (static_cast<uint32_t> (readIndex_), std::memory_order_acq_rel);
+        readIndex_ = static_cast<int> (previous & kIndexMask);
+        hasFrame_ = true;
+    }
+
+    return hasFrame_ ? &slots_[static_cast<std::size_t> (readIndex_)] : nullptr;
+}
+
+//==============================================================================
+MultichannelAnalyzer::MultichannelAnalyzer()
+{
+    // FFT plans and Hann windows do not depend on the sample rate: build them once
+    const float pi = juce::MathConstants<float>::pi;
+    for (int i = 0; i < kNumFFTSizes; ++i)
+    {
+        const int order = kMinFFTOrder + i;
+        const int size = 1 << order;
+        fftPlans_[static_cast<std::size_t> (i)] = std::make_unique<juce::dsp::FFT> (order);
+
+        auto& w = windows_[static_cast<std::size_t> (i)];
+        w.resize (static_cast<std::size_t> (size));
+        for (int n = 0; n < size; ++n)
+            w[static_cast<std::size_t> (n)] = 0.5f * (1.0f - std::cos (2.0f * pi * static_cast<float> (n) / static_cast<float> (size - 1)));
+    }
+}
+
+MultichannelAnalyzer::~MultichannelAnalyzer()
+{
+    release();
+}
+
+void MultichannelAnalyzer::prepare (double sampleRate, int samplesPerBlock, int numChannels)
+{
+    release();
+
+    sampleRate_ = sampleRate;
+    numChannels_ = (numChannels > 2) ? juce::jmin (numChannels, kMaxChannels) : 0;
+    if (numChannels_ == 0)
+        return;
+
+    for (int i = 0; i < kNumFFTSizes; ++i)
+        resamplers_[static_cast<std::size_t> (i)].prepare (sampleRate, 1 << (kMinFFTOrder + i));
+
+    // Ring sized like the engine's worker ring (~0.5 s or several host blocks), per channel
+    ringSize_ = juce::jmax (8 * juce::jmax (1, samplesPerBlock), static_cast<int> (sampleRate * 0.5)) + 1;
+    ring_.assign (static_cast<std::size_t> (ringSize_ * numChannels_), 0.0f);
+    ringFifo_.setTotalSize (ringSize_);
+    ringFifo_.reset();
+    overruns_.store (0, std::memory_order_relaxed);
+
+    histories_.assign (static_cast<std::size_t> (numChannels_) * 2 * kMaxFFTSize, 0.0f);
+    power_.assign (static_cast<std::size_t> (kNumSlots) * kMaxBins, 0.0f);
+    rms_.assign (static_cast<std::size_t> (kNumSlots) * kMaxBins, 0.0f);
+    seed_.fill (true);
+    historyWritePos_ = 0;
+    samplesSinceHop_ = 0;
+    consumed_ = 0;
+    fftOrder_ = requestedFftOrder_.load (std::memory_order_relaxed);
+    hopSize_ = juce::jlimit ((1 << fftOrder_) / 8, 1 << fftOrder_, juce::roundToInt (sampleRate / kTargetFrameRateHz));
+    batchState_.store (0, std::memory_order_relaxed);
+
+    scratch_.resize (static_cast<std::size_t> ((numChannels_ + 1) / 2));
+    for (auto& s : scratch_)
+    {
+        s.input.assign (static_cast<std::size_t> (kMaxFFTSize), {});
+        s.spectrum.assign (static_cast<std::size_t> (kMaxFFTSize), {});
+    }
+
+    // Registry full: stay idle rather than analyse on the audio thread
+    registered_ = scheduler_->add (*this);
+    if (! registered_)
+        numChannels_ = 0;
+}
+
+void MultichannelAnalyzer::release()
+{
+    // Returns once no pool worker is inside the analyser any more
+    if (registered_)
+        scheduler_->remove (*this);
+
+    registered_ = false;
+    numChannels_ = 0;
+}
+
+void MultichannelAnalyzer::setFftSize (int fftSize) noexcept
+{
+    const int order = juce::jlimit (kMinFFTOrder, kMaxFFTOrder, juce::findHighestSetBit (static_cast<uint32_t> (juce::jmax (1, fftSize))));
+    requestedFftOrder_.store (order, std::memory_order_relaxed);
+}
+
+const MultichannelAnalyzer::Frame* MultichannelAnalyzer::acquireLatest (int slot) noexcept
+{
+    if (slot < 0 || slot >= kNumSlots)
+        return nullptr;
+    return frames_[static_cast<std::size_t> (slot)].acquireLatest();
+}
+
+//==============================================================================
+void MultichannelAnalyzer::push (const float* const* channels, int numChannels, int numSamples) noexcept
+{
+    // Nothing displayed: no copy at all
+    if (numChannels_ == 0 || numSamples <= 0 || consumedRequested_.load (std::memory_order_relaxed) == 0)
+        return;
+
+    int start1 = 0, size1 = 0, start2 = 0, size2 = 0;
+    ringFifo_.prepareToWrite (numSamples, start1, size1, start2, size2);
+
+    for (int c = 0; c < numChannels_; ++c)
+    {
+        float* dst = ring_.data() + static_cast<std::size_t> (c) * static_cast<std::size_t> (ringSize_);
+        if (c < numChannels)
+        {
+            if (size1 > 0) juce::FloatVectorOperations::copy (dst + start1, channels[c], size1);
+            if (size2 > 0) juce::FloatVectorOperations::copy (dst + start2, channels[c] + size1, size2);
+        }
+        else
+        {
+            if (size1 > 0) juce::FloatVectorOperations::clear (dst + start1, size1);
+            if (size2 > 0) juce::FloatVectorOperations::clear (dst + start2, size2);
+        }
+    }
+
+    ringFifo_.finishedWrite (size1 + size2);
+
+    if (size1 + size2 < numSamples)
+        overruns_.fetch_add (1, std::memory_order_relaxed);
+}
+
+//==============================================================================
+bool MultichannelAnalyzer::drain()
+{
+    const int ready = ringFifo_.getNumReady();
+    if (ready <= 0)
+        return false;
+
+    int start1 = 0, size1 = 0, start2 = 0, size2 = 0;
+    ringFifo_.prepareToRead (ready, start1, size1, start2, size2);
+
+    // Hop-bounded chunks: frame positions do not depend on how the host partitions the stream
+    for (const auto& run : { std::make_pair (start1, size1), std::make_pair (start2, size2) })
+    {
+        int offset = 0;
+        while (offset < run.second)
+        {
+            // Deferred requests apply at hop boundaries only
+            if (samplesSinceHop_ == 0)
+            {
+                const int order = requestedFftOrder_.load (std::memory_order_relaxed);
+                if (order != fftOrder_)
+                {
+                    fftOrder_ = order;
+                    hopSize_ = juce::jlimit ((1 << order) / 8, 1 << order, juce::roundToInt (sampleRate_ / kTargetFrameRateHz));
+                    seed_.fill (true);
+                }
+
+                const uint32_t mask = consumedRequested_.load (std::memory_order_relaxed);
+                if (consumed_ == 0 && mask != 0)
+                {
+                    // Resuming after nothing was displayed: the histories are stale
+                    juce::FloatVectorOperations::clear (histories_.data(), static_cast<int> (histories_.size()));
+                }
+                for (int s = 0; s < kNumSlots; ++s)
+                    if ((mask & ~consumed_ & (1u << s)) != 0)
+                        seed_[static_cast<std::size_t> (s)] = true;
+                consumed_ = mask;
+            }
+
+            const int chunk = juce::jmin (run.second - offset, hopSize_ - samplesSinceHop_);
+            appendToHistories (run.first + offset, chunk);
+            offset += chunk;
+            samplesSinceHop_ += chunk;
+
+            if (samplesSinceHop_ >= hopSize_)
+            {
+                samplesSinceHop_ = 0;
+                if (consumed_ != 0)
+                    runBatch();
+            }
+        }
+    }
+
+    ringFifo_.finishedRead (size1 + size2);
+    return true;
+}
+
+void MultichannelAnalyzer::appendToHistories (int ringStart, int numSamples) noexcept
+{
+    // Mirrored histories (modulo kMaxFFTSize): the latest N samples of any size are contiguous
+    const int firstRun = juce::jmin (numSamples, kMaxFFTSize - historyWritePos_);
+    const int secondRun = numSamples - firstRun;
+
+    for (int c = 0; c < numChannels_; ++c)
+    {
+        const float* src = ring_.data() + static_cast<std::size_t> (c) * static_cast<std::size_t> (ringSize_) + ringStart;
+        float* dst = history (c);
+
+        juce::FloatVectorOperations::copy (dst + historyWritePos_, src, firstRun);
+        juce::FloatVectorOperations::copy (dst + historyWritePos_ + kMaxFFTSize, src, firstRun);
+        if (secondRun > 0)
+        {
+            juce::FloatVectorOperations::copy (dst, src + firstRun, secondRun);
+            juce::FloatVectorOperations::copy (dst + kMaxFFTSize, src + firstRun, secondRun);
+        }
+    }
+
+    historyWritePos_ += numSamples;
+    if (historyWritePos_ >= kMaxFFTSize)
+        historyWritePos_ -= kMaxFFTSize;
+}
+
+void MultichannelAnalyzer::runBatch()
+{
+    // The sum needs every channel; otherwise only the displayed ones are transformed
+    const bool wantSum = (consumed_ & kSumBit) != 0;
+    batchNumChannels_ = 0;
+    for (int c = 0; c < numChannels_; ++c)
+        if (wantSum || (consumed_ & (1u << c)) != 0)
+            batchChannels_[static_cast<std::size_t> (batchNumChannels_++)] = c;
+
+    batchConsumed_ = consumed_;
+
+    const double hopSec = static_cast<double> (hopSize_) / sampleRate_;
+    rmsAttCoeff_ = static_cast<float> (std::exp (-hopSec / (kRmsAttackMs / 1000.0)));
+    rmsRelCoeff_ = static_cast<float> (std::exp (-hopSec / (kRmsReleaseMs / 1000.0)));
+
+    const int numJobs = (batchNumChannels_ + 1) / 2;
+    jobsDone_.store (0, std::memory_order_relaxed);
+    batchState_.store (static_cast<uint32_t> (numJobs) << 8, std::memory_order_release);
+
+    if (numJobs > 1)
+    {
+        // Waking idle pool workers is the one step that locks (event); the audio thread never does it
+        RealtimeGuard::ScopedAllow wake;
+        scheduler_->wakeWorkers (numJobs - 1);
+    }
+
+    while (jobsDone_.load (std::memory_order_acquire) < numJobs)
+        if (! helpWithBatch())
+            juce::Thread::yield();
+
+    if (wantSum)
+    {
+        float* sum = power (kSumSlot);
+        const int numBins = (1 << fftOrder_) / 2 + 1;
+        juce::FloatVectorOperations::copy (sum, power (0), numBins);
+        for (int c = 1; c < numChannels_; ++c)
+            juce::FloatVectorOperations::add (sum, power (c), numBins);
+        finishSlot (kSumSlot);
+    }
+}
+
+bool MultichannelAnalyzer::helpWithBatch() noexcept
+{
+    uint32_t state = batchState_.load (std::memory_order_acquire);
+    for (;;)
+    {
+        const uint32_t next = state & 0xffu;
+        if (next >= (state >> 8))
+            return false;
+
+        if (batchState_.compare_exchange_weak (state, state + 1, std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+            runPairJob (static_cast<int> (next));
+            jobsDone_.fetch_add (1, std::memory_order_release);
+            return true;
+        }
+    }
+}
+
+void MultichannelAnalyzer::runPairJob (int job) noexcept
+{
+    auto& scratch = scratch_[static_cast<std::size_t> (job)];
+
+    // Two channels per complex FFT (a in the real part, b in the imaginary part)
+    const int first = 2 * job;
+    const int a = batchChannels_[static_cast<std::size_t> (first)];
+    const int b = (first + 1 < batchNumChannels_) ? batchChannels_[static_cast<std::size_t> (first + 1)] : -1;
+
+    const int fftSize = 1 << fftOrder_;
+    const std::size_t planIndex = static_cast<std::size_t> (fftOrder_ - kMinFFTOrder);
+    const float* win = windows_[planIndex].data();
+    const int readStart = historyWritePos_ + kMaxFFTSize - fftSize;
+    const float* srcA = history (a) + readStart;
+    const float* srcB = (b >= 0) ? history (b) + readStart : nullptr;
+    auto* packed = scratch.input.data();
+
+    if (srcB != nullptr)
+        for (int i = 0; i < fftSize; ++i)
+            packed[i] = { srcA[i] * win[i], srcB[i] * win[i] };
+    else
+        for (int i = 0; i < fftSize; ++i)
+            packed[i] = { srcA[i] * win[i], 0.0f };
+
+    fftPlans_[planIndex]->perform (packed, scratch.spectrum.data(), false);
+
+    // Same split and scaling as AnalyzerEngine::performStereoFFT
+    const int numBins = fftSize / 2 + 1;
+    const float scale = 2.0f / static_cast<float> (fftSize);
+    const float powerScale = (scale * scale) * 4.0f;  // Hann window correction
+    const juce::dsp::Complex<float> minusHalfJ { 0.0f, -0.5f };
+    const auto* spectrum = scratch.spectrum.data();
+    float* powerA = power (a);
+    float* powerB = (b >= 0) ? power (b) : nullptr;
+
+    for (int k = 0; k < numBins; ++k)
+    {
+        const auto z = spectrum[k];
+        const auto zMirror = std::conj (spectrum[(fftSize - k) & (fftSize - 1)]);
+        powerA[k] = std::norm (0.5f * (z + zMirror)) * powerScale;
+        if (powerB != nullptr)
+            powerB[k] = std::norm (minusHalfJ * (z - zMirror)) * powerScale;
+    }
+
+    // Correct DC and Nyquist (factor of 0.25)
+    for (float* p : { powerA, powerB })
+    {
+        if (p != nullptr)
+        {
+            p[0] *= 0.25f;
+            p[numBins - 1] *= 0.25f;
+        }
+    }
+
+    finishSlot (a);
+    if (b >= 0)
+        finishSlot (b);
+}
+
+void MultichannelAnalyzer::finishSlot (int slot) noexcept
+{
+    if ((batchConsumed_ & (1u << slot)) == 0)
+        return;
+
+    // RMS ballistics on power (first frame after a resume / size change starts at the input)
+    const std::size_t slotIndex = static_cast<std::size_t> (slot);
+    const int numBins = (1 << fftOrder_) / 2 + 1;
+    const float* in = power (slot);
+    float* state = rms (slot);
+    const bool seed = seed_[slotIndex];
+    seed_[slotIndex] = false;
+
+    for (int k = 0; k < numBins; ++k)
+    {
+        const float coeff = seed ? 0.0f : ((in[k] > state[k]) ? rmsAttCoeff_ : rmsRelCoeff_);
+        state[k] = coeff * state[k] + (1.0f - coeff) * in[k];
+    }
+
+    const auto& resampler = resamplers_[static_cast<std::size_t> (fftOrder_ - kMinFFTOrder)];
+    auto& frame = frames_[slotIndex].getWriteSlot();
+    resampler.applyLogPower (state, frame.logDb.data());
+    resampler.applyBandsPower (state, frame.bandsDb.data());
+    AnalyzerPro::dsp::SpectrumKernels::powerToDb (frame.logDb.data(), frame.logDb.data(), kNumLogPoints, kDbFloor);
+    AnalyzerPro::dsp::SpectrumKernels::powerToDb (frame.bandsDb.data(), frame.bandsDb.data(), kNumBands, kDbFloor);
+
+    frame.sampleRate = sampleRate_;
+    frame.fftSize = 1 << fftOrder_;
+    frame.frameIndex = ++frameCounters_[slotIndex];
+    frames_[slotIndex].publish();
+}
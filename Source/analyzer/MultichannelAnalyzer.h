@@ -0,0 +1,184 @@
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include "SpectrumResampler.h"
+#include "AnalysisScheduler.h"
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+//==============================================================================
+/**
+    Per-channel spectra for multichannel buses (up to 7.1.4 = 12 channels) plus a summed view.
+
+    The main AnalyzerEngine pipeline keeps analysing the stereo L/R pair; this analyser
+    covers every input channel of wider buses. The audio thread only copies the block into
+    a per-channel SoA ring (wait-free, same idea as the engine's worker mode). The shared
+    AnalysisScheduler pool does the rest: the worker that claims the analyser drains the ring
+    into per-channel mirrored histories and, at every hop, posts one batch of parallel jobs -
+    one packed complex FFT per channel PAIR, the same L + jR trick as the engine - which idle
+    pool workers claim from a shared counter.
+    Each job windows, transforms and splits its pair, runs the RMS ballistics and resamples to
+    the LOG / 1/3-octave grids, then publishes one Frame per channel. The summed view (power sum
+    of every channel) is built once the batch completes.
+
+    Every channel (and the sum) has its own lock-free triple buffer, and only the slots named in
+    setConsumedSlots() are computed: the UI marks the channels it displays, and with no
+    consumer the audio thread does not even queue samples.
+
+    Window, power scaling and ballistics match AnalyzerEngine, so a channel reads the same level
+    here as in the main view. FFT sizes are capped at 16384 (12 histories + scratch stay small).
+    prepare()/release() run on the message thread; push() is RT-safe.
+*/
+class MultichannelAnalyzer : private AnalysisScheduler::Client
+{
+public:
+    static constexpr int kMaxChannels = 12;
+    static constexpr int kSumSlot = kMaxChannels;               // Slot index of the summed view
+    static constexpr int kNumSlots = kMaxChannels + 1;
+    static constexpr uint32_t kSumBit = 1u << kSumSlot;
+    static constexpr int kMinFFTOrder = 10;
+    static constexpr int kMaxFFTOrder = 14;
+    static constexpr int kNumFFTSizes = kMaxFFTOrder - kMinFFTOrder + 1;
+    static constexpr int kMaxFFTSize = 1 << kMaxFFTOrder;
+    static constexpr int kMaxBins = kMaxFFTSize / 2 + 1;
+    static constexpr int kNumLogPoints = SpectrumResampler::kNumLogPoints;
+    static constexpr int kNumBands = SpectrumResampler::kNumBands;
+
+    /** One published spectrum (RMS ballistics, dB). */
+    struct Frame
+    {
+        double sampleRate = 0.0;
+        int fftSize = 0;
+        uint32_t frameIndex = 0;
+        std::array<float, kNumLogPoints> logDb {};
+        std::array<float, kNumBands> bandsDb {};
+    };
+
+    MultichannelAnalyzer();
+    ~MultichannelAnalyzer();
+
+    /** Sizes rings/histories for numChannels (clamped to kMaxChannels) and registers with the
+        scheduler. Fewer than 3 channels leaves the analyser idle (the main pipeline covers stereo). */
+    void prepare (double sampleRate, int samplesPerBlock, int numChannels);
+
+    /** Unregisters from the scheduler (message thread). */
+    void release();
+
+    /** Channels being analysed (0 while idle). */
+    int getNumChannels() const noexcept { return numChannels_; }
+
+    /** RT-safe: clamped to 1024 .. 16384, applied at the next hop. */
+    void setFftSize (int fftSize) noexcept;
+
+    /** Bit per slot to compute (channel index, kSumBit for the summed view). 0 = nothing
+        displayed: push() becomes a no-op. RT-safe, applied at the next hop. */
+    void setConsumedSlots (uint32_t mask) noexcept { consumedRequested_.store (mask, std::memory_order_relaxed); }
+
+    /** Audio thread: queues every channel of the block (wait-free; drops and counts on overrun). */
+    void push (const float* const* channels, int numChannels, int numSamples) noexcept;
+
+    /** Latest frame of a slot, read in place (one consumer per slot, e.g. the UI timer).
+        Stays unchanged until the next call for the same slot; nullptr before the first frame. */
+    const Frame* acquireLatest (int slot) noexcept;
+
+    uint32_t getOverrunCount() const noexcept { return overruns_.load (std::memory_order_relaxed); }
+
+    /** Scheduling priority (follows the owning engine). */
+    using AnalysisScheduler::Client::setPriority;
+
+private:
+    static constexpr double kTargetFrameRateHz = 30.0;   // Small multiples: half the main view's rate
+    static constexpr float kDbFloor = -120.0f;
+    static constexpr float kRmsAttackMs = 80.0f;         // AnalyzerEngine defaults
+    static constexpr float kRmsReleaseMs = 250.0f;
+
+    /** Lock-free triple buffer of Frames (same protocol as AnalyzerSnapshotTripleBuffer). */
+    class FrameTripleBuffer
+    {
+    public:
+        Frame& getWriteSlot() noexcept { return slots_[static_cast<std::size_t> (writeIndex_)]; }
+        void publish() noexcept;
+        const Frame* acquireLatest() noexcept;
+
+    private:
+        static constexpr uint32_t kIndexMask = 0x3u;
+        static constexpr uint32_t kFreshBit = 0x4u;
+
+        std::array<Frame, 3> slots_;
+        std::atomic<uint32_t> middle_ { 1 };
+        int writeIndex_ = 0;
+        int readIndex_ = 2;
+        bool hasFrame_ = false;
+    };
+
+    /** Per-job transform scratch (the FFT plans are shared: perform() is const). */
+    struct Scratch
+    {
+        std::vector<juce::dsp::Complex<float>> input;
+        std::vector<juce::dsp::Complex<float>> spectrum;
+    };
+
+    // AnalysisScheduler::Client
+    bool runPendingAnalysis() override { return drain(); }
+    bool runParallelJob() override { return helpWithBatch(); }
+
+    // Driver (one pool worker at a time): ring -> histories, hop counting, batch posting
+    bool drain();
+    void appendToHistories (int ringStart, int numSamples) noexcept;
+    void runBatch();
+
+    // Any pool worker: claim and run one job of the current batch; false when none was left
+    bool helpWithBatch() noexcept;
+    void runPairJob (int job) noexcept;
+    void finishSlot (int slot) noexcept;
+
+    float* history (int channel) noexcept { return histories_.data() + static_cast<std::size_t> (channel) * 2 * kMaxFFTSize; }
+    float* power (int slot) noexcept      { return power_.data() + static_cast<std::size_t> (slot) * kMaxBins; }
+    float* rms (int slot) noexcept        { return rms_.data() + static_cast<std::size_t> (slot) * kMaxBins; }
+
+    double sampleRate_ = 48000.0;
+    int numChannels_ = 0;
+
+    // Input ring (audio thread -> driver), channel-major SoA
+    juce::AbstractFifo ringFifo_ { 1 };
+    std::vector<float> ring_;
+    int ringSize_ = 0;
+    std::atomic<uint32_t> overruns_ { 0 };
+
+    // Analysis state (driver between batches, jobs within one)
+    std::array<std::unique_ptr<juce::dsp::FFT>, kNumFFTSizes> fftPlans_;
+    std::array<std::vector<float>, kNumFFTSizes> windows_;
+    std::array<SpectrumResampler, kNumFFTSizes> resamplers_;
+    std::vector<float> histories_;      // numChannels x (2 x kMaxFFTSize), mirrored like the engine FIFOs
+    std::vector<float> power_;          // kNumSlots x kMaxBins, latest frame
+    std::vector<float> rms_;            // kNumSlots x kMaxBins, ballistic state
+    std::array<bool, kNumSlots> seed_ {};
+    std::array<FrameTripleBuffer, kNumSlots> frames_;
+    std::array<uint32_t, kNumSlots> frameCounters_ {};
+    int historyWritePos_ = 0;
+    int samplesSinceHop_ = 0;
+    int hopSize_ = 0;
+    int fftOrder_ = 11;
+    uint32_t consumed_ = 0;
+    std::atomic<int> requestedFftOrder_ { 11 };
+    std::atomic<uint32_t> consumedRequested_ { 0 };
+
+    // Current batch: jobs are channel pairs; next / total are packed in one atomic so a worker
+    // that raced past the end of one batch can never claim a job of the next one by mistake
+    std::array<int, kMaxChannels> batchChannels_ {};
+    int batchNumChannels_ = 0;
+    uint32_t batchConsumed_ = 0;
+    float rmsAttCoeff_ = 0.0f;
+    float rmsRelCoeff_ = 0.0f;
+    std::atomic<uint32_t> batchState_ { 0 };    // (total << 8) | next
+    std::atomic<int> jobsDone_ { 0 };
+
+    std::vector<Scratch> scratch_;             // One per channel pair (jobs run concurrently)
+
+    juce::SharedResourcePointer<AnalysisScheduler> scheduler_;
+    bool registered_ = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MultichannelAnalyzer)
+};
@@ -0,0 +1,96 @@
+#include "SpectrogramHistory.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+//==============================================================================
+SpectrogramHistory::SpectrogramHistory()
+    : rows_ (static_cast<std::size_t> (kNumRows) * static_cast<std::size_t> (kNumColumns), 0)
+{
+}
+
+void SpectrogramHistory::prepare (double sampleRate) noexcept
+{
+    if (sampleRate > 0.0)
+        samplesPerRow_ = sampleRate / static_cast<double> (kRowsPerSecond);
+
+    pendingValid_ = false;
+    sampleAccumulator_ = 0.0;
+}
+
+uint8_t SpectrogramHistory::dbToCode (float db) noexcept
+{
+    // NaN/-inf (silence) land on code 0 via the clamp
+    const float code = (db - kMinDb) / kDbPerCode;
+    if (! (code > 0.0f))
+        return 0;
+    return static_cast<uint8_t> (std::min (255.0f, code + 0.5f));
+}
+
+void SpectrogramHistory::addFrame (const float* columnDb, int hopSamples) noexcept
+{
+    if (columnDb == nullptr || hopSamples <= 0)
+        return;
+
+    // Max-merge: a short transient within a row period must survive into the row
+    if (pendingValid_)
+    {
+        for (int c = 0; c < kNumColumns; ++c)
+            pendingDb_[static_cast<std::size_t> (c)] = std::max (pendingDb_[static_cast<std::size_t> (c)], columnDb[c]);
+    }
+    else
+    {
+        std::copy (columnDb, columnDb + kNumColumns, pendingDb_.begin());
+        pendingValid_ = true;
+    }
+
+    sampleAccumulator_ += static_cast<double> (hopSamples);
+    if (sampleAccumulator_ < samplesPerRow_)
+        return;
+
+    // Hop spans one or more row periods: repeat the row (bounded by the ring size)
+    int rowsDue = 0;
+    while (sampleAccumulator_ >= samplesPerRow_)
+    {
+        sampleAccumulator_ -= samplesPerRow_;
+        ++rowsDue;
+    }
+
+    for (int i = 0; i < std::min (rowsDue, kNumRows); ++i)
+        publishPendingRow();
+
+    pendingValid_ = false;
+}
+
+void SpectrogramHistory::publishPendingRow() noexcept
+{
+    const uint64_t total = rowsWritten_.load (std::memory_order_relaxed);
+    uint8_t* row = rows_.data() + static_cast<std::size_t> (total % static_cast<uint64_t> (kNumRows)) * kNumColumns;
+
+    for (int c = 0; c < kNumColumns; ++c)
+        row[c] = dbToCode (pendingDb_[static_cast<std::size_t> (c)]);
+
+    rowsWritten_.store (total + 1, std::memory_order_release);
+}
+
+int SpectrogramHistory::readRows (uint64_t& cursor, uint8_t* dest, int maxRows) const noexcept
+{
+    if (dest == nullptr || maxRows <= 0)
+        return 0;
+
+    const uint64_t total = rowsWritten_.load (std::memory_order_acquire);
+    constexpr uint64_t readableRows = static_cast<uint64_t> (kReadableRows);
+    const uint64_t oldest = total > readableRows ? total - readableRows : 0;
+
+    cursor = std::clamp (cursor, oldest, total);
+
+    const int numRows = static_cast<int> (std::min<uint64_t> (total - cursor, static_cast<uint64_t> (maxRows)));
+    for (int i = 0; i < numRows; ++i)
+    {
+        const uint8_t* row = rows_.data() + static_cast<std::size_t> ((cursor + static_cast<uint64_t> (i)) % static_cast<uint64_t> (kNumRows)) * kNumColumns;
+        std::memcpy (dest + static_cast<std::size_t> (i) * kNumColumns, row, kNumColumns);
+    }
+
+    cursor += static_cast<uint64_t> (numRows);
+    return numRows;
+}
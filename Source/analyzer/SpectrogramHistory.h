@@ -0,0 +1,74 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+//==============================================================================
+/**
+    Lock-free spectrogram (waterfall) history ring.
+
+    The analyzer thread appends one row of kNumColumns log-frequency bins
+    (SpectrumResampler spectrogram grid, 20 Hz - 20 kHz) every 1 / kRowsPerSecond
+    seconds of audio. Hops shorter than a row period are max-merged into the pending
+    row; a hop spanning several periods repeats its row, so the time axis is uniform
+    whatever the FFT size / overlap / sample rate.
+
+    Each bin is quantised to one byte: dB = kMinDb + code * kDbPerCode. kNumRows covers
+    72 s, of which 64 s stay readable behind the guard, i.e. 1.1 MB of history (512 KB per
+    32 s), allocated once in the constructor.
+
+    Single producer (addFrame on the analyzer thread), any number of consumers, each with
+    its own cursor (readRows). The producer publishes a row by bumping rowsWritten_ with
+    release ordering after writing it; readers never touch the kReadGuardRows rows the
+    producer may be overwriting, so a slow reader only loses history, it never tears a row.
+*/
+class SpectrogramHistory
+{
+public:
+    static constexpr int kNumColumns = 512;
+    static constexpr int kRowsPerSecond = 32;
+    static constexpr int kNumRows = 2304;             // 72 s
+    static constexpr int kReadGuardRows = 256;        // 8 s of slack before the producer laps a reader
+    static constexpr int kReadableRows = kNumRows - kReadGuardRows;   // 64 s
+
+    static_assert (kReadableRows >= 60 * kRowsPerSecond, "At least 60 s of readable history");
+    static constexpr float kMinDb = -120.0f;
+    static constexpr float kDbPerCode = 0.5f;         // Codes 0..255 -> -120 .. +7.5 dB
+
+    SpectrogramHistory();
+
+    /** Sets the row period for the sample rate and clears the pending row.
+        Published rows are kept (the time axis is in seconds, not samples). */
+    void prepare (double sampleRate) noexcept;
+
+    /** Appends one analysis frame of kNumColumns dB values covering hopSamples of audio.
+        RT-safe (analyzer thread only). */
+    void addFrame (const float* columnDb, int hopSamples) noexcept;
+
+    /** Total rows published since construction (monotonic). */
+    uint64_t getNumRowsWritten() const noexcept { return rowsWritten_.load (std::memory_order_acquire); }
+
+    /** Copies up to maxRows rows (kNumColumns bytes each, oldest first) from cursor onwards into dest
+        and advances cursor. A cursor that fell behind the readable window is moved forward to its
+        oldest row first. Returns the number of rows copied. Safe from any thread. */
+    int readRows (uint64_t& cursor, uint8_t* dest, int maxRows) const noexcept;
+
+    static uint8_t dbToCode (float db) noexcept;
+    static float codeToDb (uint8_t code) noexcept { return kMinDb + kDbPerCode * static_cast<float> (code); }
+
+private:
+    void publishPendingRow() noexcept;
+
+    std::vector<uint8_t> rows_;                        // kNumRows * kNumColumns
+    std::array<float, kNumColumns> pendingDb_ {};
+    bool pendingValid_ = false;
+    double samplesPerRow_ = 48000.0 / kRowsPerSecond;
+    double sampleAccumulator_ = 0.0;
+
+    std::atomic<uint64_t> rowsWritten_ { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SpectrogramHistory)
+};
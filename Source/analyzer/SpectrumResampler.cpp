@@ -0,0 +1,133 @@
+#include "SpectrumResampler.h"
+#include "../dsp/simd/SpectrumKernels.h"
+#include <cmath>
+
+const std::array<float, SpectrumResampler::kNumBands>& SpectrumResampler::getBandCentresHz() noexcept
+{
+    static const std::array<float, kNumBands> centres {
+        20.0f, 25.0f, 31.5f, 40.0f, 50.0f, 63.0f, 80.0f, 100.0f, 125.0f, 160.0f,
+        200.0f, 250.0f, 315.0f, 400.0f, 500.0f, 630.0f, 800.0f, 1000.0f, 1250.0f, 1600.0f,
+        2000.0f, 2500.0f, 3150.0f, 4000.0f, 5000.0f, 6300.0f, 8000.0f, 10000.0f, 12500.0f, 16000.0f, 20000.0f
+    };
+    return centres;
+}
+
+double SpectrumResampler::getLogGridFrequency (int index, int numPoints) noexcept
+{
+    const double logMin = std::log10 (static_cast<double> (kMinLogFrequencyHz));
+    const double logMax = std::log10 (static_cast<double> (kMaxLogFrequencyHz));
+    return std::pow (10.0, logMin + (logMax - logMin) * static_cast<double> (index) / static_cast<double> (numPoints - 1));
+}
+
+void SpectrumResampler::prepare (double sampleRate, int fftSize)
+{
+    numBins_ = fftSize / 2 + 1;
+    const double binWidthHz = sampleRate / static_cast<double> (fftSize);
+
+    // Bands: exact base-10 1/3-octave edges around the exact centres 1000 * 10^(n/10)
+    {
+        std::array<double, kNumBands> lower {}, upper {};
+        const double halfBand = std::pow (10.0, 0.05);
+        for (int b = 0; b < kNumBands; ++b)
+        {
+            const double exactCentre = 1000.0 * std::pow (10.0, static_cast<double> (b - 17) / 10.0);
+            lower[static_cast<std::size_t> (b)] = exactCentre / halfBand;
+            upper[static_cast<std::size_t> (b)] = exactCentre * halfBand;
+        }
+        bands_.build (lower.data(), upper.data(), kNumBands, binWidthHz, numBins_);
+    }
+
+    buildLogGrid (log_, kNumLogPoints, binWidthHz, numBins_);
+    buildLogGrid (spectrogram_, kNumSpectrogramColumns, binWidthHz, numBins_);
+}
+
+void SpectrumResampler::buildLogGrid (SparseRows& rows, int numPoints, double binWidthHz, int numSpectrumBins)
+{
+    // Edges at the geometric midpoints between neighbours
+    std::vector<double> lower (static_cast<std::size_t> (numPoints)), upper (static_cast<std::size_t> (numPoints));
+    const double halfStep = std::sqrt (getLogGridFrequency (1, numPoints) / getLogGridFrequency (0, numPoints));
+    for (int i = 0; i < numPoints; ++i)
+    {
+        const double centre = getLogGridFrequency (i, numPoints);
+        lower[static_cast<std::size_t> (i)] = centre / halfStep;
+        upper[static_cast<std::size_t> (i)] = centre * halfStep;
+    }
+    rows.build (lower.data(), upper.data(), numPoints, binWidthHz, numSpectrumBins);
+}
+
+void SpectrumResampler::SparseRows::build (const double* lowerHz, const double* upperHz, int numRows,
+                                           double binWidthHz, int numSpectrumBins)
+{
+    firstBin.assign (static_cast<std::size_t> (numRows), 0);
+    numBins.assign (static_cast<std::size_t> (numRows), 0);
+    weightStart.assign (static_cast<std::size_t> (numRows), 0);
+    weights.clear();
+
+    const double lastBinUpper = (static_cast<double> (numSpectrumBins - 1) + 0.5);
+
+    for (int r = 0; r < numRows; ++r)
+    {
+        // Row edges in bin units; bin k spans [k - 0.5, k + 0.5]
+        const double lo = juce::jmax (-0.5, lowerHz[r] / binWidthHz);
+        const double hi = juce::jmin (lastBinUpper, upperHz[r] / binWidthHz);
+        const std::size_t row = static_cast<std::size_t> (r);
+
+        weightStart[row] = static_cast<int> (weights.size());
+
+        if (hi <= lo)
+            continue;  // Entirely above Nyquist
+
+        const int b0 = static_cast<int> (std::floor (lo + 0.5));
+        const int b1 = juce::jmin (numSpectrumBins - 1, static_cast<int> (std::ceil (hi - 0.5)));
+
+        double sum = 0.0;
+        for (int k = b0; k <= b1; ++k)
+        {
+            const double overlap = juce::jmin (hi, k + 0.5) - juce::jmax (lo, k - 0.5);
+            weights.push_back (static_cast<float> (juce::jmax (0.0, overlap)));
+            sum += juce::jmax (0.0, overlap);
+        }
+
+        if (sum <= 0.0)
+        {
+            weights.resize (static_cast<std::size_t> (weightStart[row]));
+            continue;
+        }
+
+        for (std::size_t w = static_cast<std::size_t> (weightStart[row]); w < weights.size(); ++w)
+            weights[w] = static_cast<float> (static_cast<double> (weights[w]) / sum);
+
+        firstBin[row] = b0;
+        numBins[row] = b1 - b0 + 1;
+    }
+}
+
+void SpectrumResampler::applyMean (const SparseRows& rows, const float* power, float* out) noexcept
+{
+    const std::size_t numRows = rows.numBins.size();
+    const float* weights = rows.weights.data();
+
+    for (std::size_t r = 0; r < numRows; ++r)
+    {
+        const int count = rows.numBins[r];
+        out[r] = (count > 0) ? AnalyzerPro::dsp::SpectrumKernels::dot (weights + rows.weightStart[r], power + rows.firstBin[r], count)
+                             : 0.0f;
+    }
+}
+
+void SpectrumResampler::applyMax (const SparseRows& rows, const float* values, float* out, float emptyValue) noexcept
+{
+    const std::size_t numRows = rows.numBins.size();
+
+    for (std::size_t r = 0; r < numRows; ++r)
+    {
+        const int count = rows.numBins[r];
+        const float* v = values + rows.firstBin[r];
+        float m = emptyValue;
+
+        for (int k = 0; k < count; ++k)
+            m = juce::jmax (m, v[k]);
+
+        out[r] = m;
+    }
+}
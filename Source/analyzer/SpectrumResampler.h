@@ -0,0 +1,81 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <array>
+#include <vector>
+
+//==============================================================================
+/**
+    Precomputed sparse bin -> series matrices for the BANDS and LOG views and the
+    spectrogram columns.
+
+    Each output row (a 1/3-octave band or a log-spaced point) covers a contiguous run
+    of FFT bins. Bin k spans [(k - 0.5), (k + 0.5)] * binWidth and contributes with the
+    fraction of that span inside the row's edges, so edge bins are split between
+    neighbouring rows instead of being counted twice or dropped. Weights are normalised
+    per row: applying a row yields the mean power of the band.
+
+    Built once per (sample rate, FFT size) in prepare() (allocating, message thread);
+    the apply functions are RT-safe.
+*/
+class SpectrumResampler
+{
+public:
+    static constexpr int kNumBands = 31;             // ISO 266 1/3-octave centres, 20 Hz - 20 kHz
+    static constexpr int kNumLogPoints = 256;        // Same grid as the UI LOG mode / MultiResolutionAnalyzer
+    static constexpr int kNumSpectrogramColumns = 512;  // Same span, twice the density (SpectrogramHistory rows)
+    static constexpr float kMinLogFrequencyHz = 20.0f;
+    static constexpr float kMaxLogFrequencyHz = 20000.0f;
+
+    /** Nominal band centres (the same labels the UI draws). */
+    static const std::array<float, kNumBands>& getBandCentresHz() noexcept;
+
+    /** Centre frequency of a log point. */
+    static double getLogPointFrequency (int index) noexcept { return getLogGridFrequency (index, kNumLogPoints); }
+
+    /** Centre frequency of a spectrogram column. */
+    static double getSpectrogramColumnFrequency (int index) noexcept { return getLogGridFrequency (index, kNumSpectrogramColumns); }
+
+    SpectrumResampler() = default;
+
+    /** Rebuilds all matrices (allocates). */
+    void prepare (double sampleRate, int fftSize);
+
+    bool isPrepared() const noexcept { return numBins_ > 0; }
+    int getNumBins() const noexcept { return numBins_; }
+
+    /** Mean power per band/log point from a power spectrum of getNumBins() bins. Rows above
+        Nyquist read 0. */
+    void applyBandsPower (const float* power, float* bandsOut) const noexcept   { applyMean (bands_, power, bandsOut); }
+    void applyLogPower (const float* power, float* logOut) const noexcept       { applyMean (log_, power, logOut); }
+    void applySpectrogramPower (const float* power, float* columnsOut) const noexcept { applyMean (spectrogram_, power, columnsOut); }
+
+    /** Maximum per band/log point (any domain, e.g. peak dB). Rows above Nyquist read emptyValue. */
+    void applyBandsMax (const float* values, float* bandsOut, float emptyValue) const noexcept { applyMax (bands_, values, bandsOut, emptyValue); }
+    void applyLogMax (const float* values, float* logOut, float emptyValue) const noexcept     { applyMax (log_, values, logOut, emptyValue); }
+
+private:
+    /** CSR-style matrix with contiguous columns per row. */
+    struct SparseRows
+    {
+        std::vector<int> firstBin;     // Per row
+        std::vector<int> numBins;      // Per row (0 = empty row)
+        std::vector<int> weightStart;  // Per row, offset into weights
+        std::vector<float> weights;    // Normalised, contiguous per row
+
+        void build (const double* lowerHz, const double* upperHz, int numRows, double binWidthHz, int numSpectrumBins);
+    };
+
+    /** index-th of numPoints log-spaced frequencies over [kMinLogFrequencyHz, kMaxLogFrequencyHz]. */
+    static double getLogGridFrequency (int index, int numPoints) noexcept;
+    /** Log grid rows with edges at the geometric midpoints between neighbours. */
+    static void buildLogGrid (SparseRows& rows, int numPoints, double binWidthHz, int numSpectrumBins);
+
+    static void applyMean (const SparseRows& rows, const float* power, float* out) noexcept;
+    static void applyMax (const SparseRows& rows, const float* values, float* out, float emptyValue) noexcept;
+
+    SparseRows bands_;
+    SparseRows log_;
+    SparseRows spectrogram_;
+    int numBins_ = 0;
+};
@@ -8,6 +8,8 @@ ap::control::ParamIdMap ap::control::makeDefaultParamIdMap()
     m[ap::control::ControlId::MeterInGain] = "Gain";
     m[ap::control::ControlId::AnalyzerMode] = "Mode";
     m[ap::control::ControlId::AnalyzerFftSize] = "FftSize";
+    m[ap::control::ControlId::AnalyzerFftOverlap] = "FftOverlap";
+    m[ap::control::ControlId::AnalyzerBandwidth] = "AnalysisBandwidth";
     m[ap::control::ControlId::AnalyzerAveraging] = "Averaging";
     m[ap::control::ControlId::AnalyzerHoldPeaks] = "HoldPeaks";
     m[ap::control::ControlId::AnalyzerPeakDecay] = "PeakDecay";
@@ -23,6 +25,11 @@ ap::control::ParamIdMap ap::control::makeDefaultParamIdMap()
     m[ap::control::ControlId::TraceShowMid]  = "analyzerShowMid";
     m[ap::control::ControlId::TraceShowSide] = "analyzerShowSide";
     m[ap::control::ControlId::TraceShowRMS]  = "analyzerShowRMS";
+    m[ap::control::ControlId::AnalyzerMultiRes] = "analyzerMultiRes";
+    m[ap::control::ControlId::AnalyzerFilterBank] = "analyzerFilterBank";
+    m[ap::control::ControlId::AnalyzerBandResolution] = "analyzerBandResolution";
+    m[ap::control::ControlId::AnalyzerShowSpectrogram] = "analyzerShowSpectrogram";
+    m[ap::control::ControlId::AnalyzerShowLtas] = "analyzerShowLTAS";
     m[ap::control::ControlId::AnalyzerWeighting] = "analyzerWeighting";
     m[ap::control::ControlId::ScopeChannelMode]  = "scopeChannelMode";
     m[ap::control::ControlId::MeterChannelMode]  = "meterChannelMode";
@@ -21,6 +21,8 @@ enum class ControlId
     MeterInGain,
     AnalyzerMode,        // FFT / BANDS / LOG
     AnalyzerFftSize,
+    AnalyzerFftOverlap,  // 0% / 50% / 75% / 87.5% / Auto
+    AnalyzerBandwidth,   // Full / 20 kHz / 10 kHz / 5 kHz (decimating front end)
     AnalyzerAveraging,
     AnalyzerHoldPeaks,   // Consolidated Hold
     AnalyzerPeakDecay,
@@ -34,6 +36,11 @@ enum class ControlId
     TraceShowSide,
     TraceShowRMS,
     AnalyzerWeighting,
+    AnalyzerMultiRes,    // Multi-resolution LOG spectrum
+    AnalyzerFilterBank,  // Filter-bank RTA for BANDS mode
+    AnalyzerBandResolution, // 1/1 / 1/3 / 1/6 / 1/12 octave (filter bank)
+    AnalyzerShowSpectrogram, // Spectrogram (waterfall) view under the analyzer
+    AnalyzerShowLtas,    // Long-term average spectrum overlay
     
     // Scope
     ScopeChannelMode, // 0=Stereo, 1=MidSide
@@ -0,0 +1,141 @@
+#include "RealtimeGuard.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+
+namespace
+{
+    // Plain ints: no TLS constructor, safe to touch from inside malloc
+    thread_local int realtimeDepth = 0;
+    thread_local int suspendDepth = 0;
+
+    std::atomic<int> mode { static_cast<int> (RealtimeGuard::Mode::Record) };
+    std::atomic<int> numViolations { 0 };
+
+    struct Site
+    {
+        RealtimeGuard::Violation kind = RealtimeGuard::Violation::Allocation;
+        int count = 0;
+        std::size_t largestBytes = 0;
+    };
+
+    struct Registry
+    {
+        std::mutex lock;
+        std::map<juce::String, Site> sites;   // Keyed by kind + stack summary
+    };
+
+    Registry& getRegistry()
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    const char* getName (RealtimeGuard::Violation kind) noexcept
+    {
+        switch (kind)
+        {
+            case RealtimeGuard::Violation::Allocation:   return "allocation";
+            case RealtimeGuard::Violation::Deallocation: return "deallocation";
+            case RealtimeGuard::Violation::Lock:         return "lock";
+        }
+        return "";
+    }
+
+    /** The few frames above the hook, one per line (the guard and hook frames are dropped). */
+    juce::String summariseStack()
+    {
+        constexpr int kFramesToKeep = 6;
+
+        auto lines = juce::StringArray::fromLines (juce::SystemStats::getStackBacktrace());
+        lines.removeEmptyStrings();
+
+        juce::StringArray kept;
+        for (const auto& line : lines)
+        {
+            if (line.contains ("RealtimeGuard") || line.contains ("getStackBacktrace")
+                || line.contains ("operator new") || line.contains ("operator delete")
+                || line.contains ("malloc") || line.contains ("pthread_mutex_lock"))
+                continue;
+
+            kept.add ("    " + line.trim());
+            if (kept.size() == kFramesToKeep)
+                break;
+        }
+        return kept.joinIntoString ("\n");
+    }
+}
+
+//==============================================================================
+RealtimeGuard::ScopedRealtimeThread::ScopedRealtimeThread() noexcept  { ++realtimeDepth; }
+RealtimeGuard::ScopedRealtimeThread::~ScopedRealtimeThread() noexcept { --realtimeDepth; }
+
+RealtimeGuard::ScopedAllow::ScopedAllow() noexcept  { ++suspendDepth; }
+RealtimeGuard::ScopedAllow::~ScopedAllow() noexcept { --suspendDepth; }
+
+void RealtimeGuard::setMode (Mode newMode) noexcept
+{
+    mode.store (static_cast<int> (newMode), std::memory_order_relaxed);
+}
+
+bool RealtimeGuard::isCheckingThisThread() noexcept
+{
+    return realtimeDepth > 0 && suspendDepth == 0;
+}
+
+int RealtimeGuard::getNumViolations() noexcept
+{
+    return numViolations.load (std::memory_order_relaxed);
+}
+
+void RealtimeGuard::report (Violation kind, std::size_t bytes) noexcept
+{
+    // Everything below allocates and locks: suspend this thread's checks first
+    const ScopedAllow suspend;
+    numViolations.fetch_add (1, std::memory_order_relaxed);
+
+    const auto stack = summariseStack();
+
+    if (static_cast<Mode> (mode.load (std::memory_order_relaxed)) == Mode::Abort)
+    {
+        std::fprintf (stderr, "Real-time violation: %s (%zu bytes) on a real-time thread\n%s\n",
+                      getName (kind), bytes, stack.toRawUTF8());
+        std::fflush (stderr);
+        std::abort();
+    }
+
+    auto& registry = getRegistry();
+    const std::lock_guard<std::mutex> lock (registry.lock);
+    auto& site = registry.sites[juce::String (getName (kind)) + "\n" + stack];
+    site.kind = kind;
+    ++site.count;
+    site.largestBytes = juce::jmax (site.largestBytes, bytes);
+}
+
+juce::String RealtimeGuard::getReport()
+{
+    const ScopedAllow suspend;
+    auto& registry = getRegistry();
+    const std::lock_guard<std::mutex> lock (registry.lock);
+
+    juce::String text;
+    for (const auto& [key, site] : registry.sites)
+    {
+        text << getName (site.kind) << " x" << site.count;
+        if (site.kind == Violation::Allocation)
+            text << " (up to " << static_cast<int> (site.largestBytes) << " bytes)";
+        text << "\n" << key.fromFirstOccurrenceOf ("\n", false, false) << "\n";
+    }
+    return text;
+}
+
+void RealtimeGuard::clearViolations()
+{
+    const ScopedAllow suspend;
+    auto& registry = getRegistry();
+    const std::lock_guard<std::mutex> lock (registry.lock);
+    registry.sites.clear();
+    numViolations.store (0, std::memory_order_relaxed);
+}
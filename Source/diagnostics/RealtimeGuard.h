@@ -0,0 +1,74 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <cstddef>
+
+//==============================================================================
+/**
+    Real-time safety checks for test builds.
+
+    Code that must be real-time safe marks its thread with ScopedRealtimeThread
+    (processBlock, the analysis worker's drain). The mark is one thread-local increment
+    and does nothing on its own: the checks come from hook functions that a test
+    executable links in (tools/rtcheck/RealtimeGuardHooks.cpp replaces operator new/delete
+    and, on glibc, malloc/free and pthread_mutex_lock), which call the check functions below.
+    Plugin and app builds never link the hooks, so they never pay for them.
+
+    A violation on a marked thread is recorded with a short stack summary (deduplicated
+    by call site), or aborts the process in Mode::Abort. While a violation is being
+    recorded the thread's checks are suspended, so the report itself can allocate.
+*/
+class RealtimeGuard
+{
+public:
+    enum class Violation
+    {
+        Allocation,
+        Deallocation,
+        Lock
+    };
+
+    enum class Mode
+    {
+        Record,     // Collect and keep running (report at the end)
+        Abort       // Print the report for the first violation and abort
+    };
+
+    /** Marks the calling thread as real-time for its lifetime (nestable). */
+    class ScopedRealtimeThread
+    {
+    public:
+        ScopedRealtimeThread() noexcept;
+        ~ScopedRealtimeThread() noexcept;
+        JUCE_DECLARE_NON_COPYABLE (ScopedRealtimeThread)
+    };
+
+    /** Suspends checks on the calling thread (deliberate, reviewed exceptions). */
+    class ScopedAllow
+    {
+    public:
+        ScopedAllow() noexcept;
+        ~ScopedAllow() noexcept;
+        JUCE_DECLARE_NON_COPYABLE (ScopedAllow)
+    };
+
+    static void setMode (Mode mode) noexcept;
+
+    /** True while the calling thread is marked and not suspended. */
+    static bool isCheckingThisThread() noexcept;
+
+    /** Called by the hooks. Cheap when the thread is not marked. */
+    static void checkAllocation (std::size_t bytes) noexcept   { if (isCheckingThisThread()) report (Violation::Allocation, bytes); }
+    static void checkDeallocation() noexcept                   { if (isCheckingThisThread()) report (Violation::Deallocation, 0); }
+    static void checkLock() noexcept                           { if (isCheckingThisThread()) report (Violation::Lock, 0); }
+
+    //==============================================================================
+    /** Violations since the last clear (all threads). */
+    static int getNumViolations() noexcept;
+    /** One line per distinct call site: kind, count, largest allocation, stack summary. */
+    static juce::String getReport();
+    static void clearViolations();
+
+private:
+    static void report (Violation kind, std::size_t bytes) noexcept;
+};
@@ -0,0 +1,133 @@
+#include "StageProfiler.h"
+#include <cmath>
+
+StageProfiler::StageProfiler()
+{
+    for (auto& stage : counts_)
+        for (auto& c : stage)
+            c.store (0, std::memory_order_relaxed);
+    for (auto& m : windowMaxNs_)
+        m.store (0, std::memory_order_relaxed);
+
+    nsPerTick_ = 1.0e9 / static_cast<double> (juce::Time::getHighResolutionTicksPerSecond());
+}
+
+const char* StageProfiler::getStageName (Stage stage) noexcept
+{
+    switch (stage)
+    {
+        case Stage::InputMeters:     return "Input meters";
+        case Stage::ParameterSync:   return "Parameters";
+        case Stage::AnalysisCopy:    return "Analysis copy";
+        case Stage::Analyzer:        return "Analyzer";
+        case Stage::RingPush:        return "  Ring push";
+        case Stage::FifoFill:        return "  FIFO fill";
+        case Stage::SideAnalysers:   return "  Multi-res / bank";
+        case Stage::Fft:             return "  FFT";
+        case Stage::Smoothing:       return "  Smooth / ballistics";
+        case Stage::Publish:         return "  Publish";
+        case Stage::Loudness:        return "Loudness";
+        case Stage::OutputMeters:    return "Gain / output meters";
+        case Stage::HardwareMapping: return "Hardware mapping";
+        case Stage::Callback:        return "Callback total";
+        case Stage::NumStages:       break;
+    }
+    return "";
+}
+
+void StageProfiler::setDeadline (int numSamples, double sampleRate) noexcept
+{
+    if (sampleRate > 0.0)
+        deadlineNs_.store (static_cast<uint32_t> (1.0e9 * numSamples / sampleRate), std::memory_order_relaxed);
+}
+
+//==============================================================================
+int StageProfiler::binForNs (uint32_t ns) noexcept
+{
+    if (ns < (1u << kMinOctave))
+        return 0;
+
+    // Octave from the top bit, sub-bin from the next three bits below it
+    const int msb = juce::findHighestSetBit (ns);
+    const int octave = msb - kMinOctave;
+    const int sub = static_cast<int> ((ns >> (msb - 3)) & 7u);
+    return juce::jmin (kNumBins - 1, octave * kBinsPerOctave + sub);
+}
+
+double StageProfiler::getBinCentreNs (int bin) noexcept
+{
+    const int octave = bin / kBinsPerOctave;
+    const int sub = bin % kBinsPerOctave;
+    const double lower = std::ldexp (1.0 + sub / 8.0, kMinOctave + octave);
+    const double upper = std::ldexp (1.0 + (sub + 1) / 8.0, kMinOctave + octave);
+    return std::sqrt (lower * upper);
+}
+
+void StageProfiler::record (Stage stage, int64_t ticks) noexcept
+{
+    const double ns = juce::jlimit (0.0, 4.0e9, static_cast<double> (ticks) * nsPerTick_);
+    const auto nsInt = static_cast<uint32_t> (ns);
+    const auto s = static_cast<std::size_t> (stage);
+
+    // Single writer per stage: plain load + store, no read-modify-write
+    auto& bin = counts_[s][static_cast<std::size_t> (binForNs (nsInt))];
+    bin.store (bin.load (std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+    auto& maxNs = windowMaxNs_[s];
+    if (nsInt > maxNs.load (std::memory_order_relaxed))
+        maxNs.store (nsInt, std::memory_order_relaxed);
+}
+
+//==============================================================================
+void StageProfiler::WindowStats::update (StageProfiler& profiler) noexcept
+{
+    for (int s = 0; s < kNumStages; ++s)
+    {
+        const auto si = static_cast<std::size_t> (s);
+        Counts window {};
+        uint32_t total = 0;
+
+        for (int b = 0; b < kNumBins; ++b)
+        {
+            const auto bi = static_cast<std::size_t> (b);
+            const uint32_t now = profiler.counts_[si][bi].load (std::memory_order_relaxed);
+            window[bi] = now - previous_[si][bi];   // Wraps correctly
+            previous_[si][bi] = now;
+            total += window[bi];
+        }
+
+        Stats stats;
+        stats.count = total;
+        // A reset racing a write can survive one window; that only shows a slightly older max
+        stats.maxNs = static_cast<double> (profiler.windowMaxNs_[si].exchange (0, std::memory_order_relaxed));
+
+        if (total > 0)
+        {
+            const double p50Target = 0.50 * total;
+            const double p99Target = 0.99 * total;
+            uint32_t running = 0;
+            bool p50Done = false;
+
+            for (int b = 0; b < kNumBins; ++b)
+            {
+                running += window[static_cast<std::size_t> (b)];
+                if (! p50Done && running >= p50Target)
+                {
+                    stats.p50Ns = getBinCentreNs (b);
+                    p50Done = true;
+                }
+                if (running >= p99Target)
+                {
+                    stats.p99Ns = getBinCentreNs (b);
+                    break;
+                }
+            }
+
+            // Bin centres can overshoot the exact max by up to half a bin
+            stats.p50Ns = juce::jmin (stats.p50Ns, stats.maxNs > 0.0 ? stats.maxNs : stats.p50Ns);
+            stats.p99Ns = juce::jmin (stats.p99Ns, stats.maxNs > 0.0 ? stats.maxNs : stats.p99Ns);
+        }
+
+        stats_[si] = stats;
+    }
+}
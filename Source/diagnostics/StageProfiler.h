@@ -0,0 +1,144 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// Compile-time switch: 0 removes every timestamp from the audio path (Scope/begin/end become no-ops).
+#ifndef ANALYZERPRO_STAGE_PROFILER
+ #define ANALYZERPRO_STAGE_PROFILER 1
+#endif
+
+//==============================================================================
+/**
+    Per-stage timing of the audio callback and the analysis pipeline.
+
+    Every stage owns a log-scale histogram (8 bins per octave from 64 ns to ~270 ms, so
+    percentiles are within ~9%) plus a windowed maximum. Each stage has exactly one
+    writer (the audio thread, or the analysis context for the engine stages in
+    worker-thread mode), so recording is two relaxed loads and stores: no locks, no
+    RMW, no allocation. The UI reads the counters and works out p50/p99/max over the
+    counts added since its previous read (WindowStats).
+
+    Runtime switch: nothing is timed until setEnabled (true) (the overlay turns it on
+    while visible), so the disabled cost is one relaxed load per stage.
+*/
+class StageProfiler
+{
+public:
+    enum class Stage : int
+    {
+        InputMeters = 0,
+        ParameterSync,      // APVTS polling / engine setters
+        AnalysisCopy,       // Input -> analysis scratch buffer (per chunk)
+        Analyzer,           // AnalyzerEngine::processBlock as a whole (contains the engine stages below)
+        RingPush,           //   L/R push into the analysis ring (audio thread, worker / bounded mode)
+        FifoFill,           //   L/R FIFO append (analysis context)
+        SideAnalysers,      //   Multi-res tiers / filter bank feed
+        Fft,                //   Packed stereo FFT
+        Smoothing,          //   Frequency smoothing, ballistics, dB conversion, peak hold
+        Publish,            //   Snapshot fill (incl. resampled series) and publish
+        Loudness,
+        OutputMeters,       // Output gain + output meters
+        HardwareMapping,
+        Callback,           // Whole processBlock
+        NumStages
+    };
+
+    static constexpr int kNumStages = static_cast<int> (Stage::NumStages);
+    static constexpr int kBinsPerOctave = 8;
+    static constexpr int kMinOctave = 6;        // 2^6 = 64 ns
+    static constexpr int kNumOctaves = 22;      // up to 2^28 ns
+    static constexpr int kNumBins = kBinsPerOctave * kNumOctaves;
+
+    using Counts = std::array<uint32_t, kNumBins>;
+
+    StageProfiler();
+
+    static const char* getStageName (Stage stage) noexcept;
+
+    void setEnabled (bool shouldBeEnabled) noexcept { enabled_.store (shouldBeEnabled, std::memory_order_relaxed); }
+    bool isEnabled() const noexcept { return enabled_.load (std::memory_order_relaxed); }
+
+    //==============================================================================
+    // Writer side (RT-safe)
+
+    /** Start timestamp, or 0 when profiling is off (end() then ignores it). */
+    int64_t begin() const noexcept
+    {
+       #if ANALYZERPRO_STAGE_PROFILER
+        return isEnabled() ? juce::Time::getHighResolutionTicks() : 0;
+       #else
+        return 0;
+       #endif
+    }
+
+    void end (Stage stage, int64_t startTicks) noexcept
+    {
+       #if ANALYZERPRO_STAGE_PROFILER
+        if (startTicks != 0)
+            record (stage, juce::Time::getHighResolutionTicks() - startTicks);
+       #else
+        juce::ignoreUnused (stage, startTicks);
+       #endif
+    }
+
+    /** Callback deadline (block duration) the UI compares against. */
+    void setDeadline (int numSamples, double sampleRate) noexcept;
+    double getDeadlineNs() const noexcept { return static_cast<double> (deadlineNs_.load (std::memory_order_relaxed)); }
+
+    /** Times the enclosing scope; a null profiler makes it a no-op. */
+    class Scope
+    {
+    public:
+        Scope (StageProfiler* profiler, Stage stage) noexcept
+            : profiler_ (profiler), stage_ (stage), start_ (profiler != nullptr ? profiler->begin() : 0) {}
+        ~Scope() { if (profiler_ != nullptr) profiler_->end (stage_, start_); }
+
+    private:
+        StageProfiler* profiler_;
+        Stage stage_;
+        int64_t start_;
+
+        JUCE_DECLARE_NON_COPYABLE (Scope)
+    };
+
+    //==============================================================================
+    // Reader side (UI thread)
+
+    struct Stats
+    {
+        uint32_t count = 0;     // Samples in the window
+        double p50Ns = 0.0;
+        double p99Ns = 0.0;
+        double maxNs = 0.0;
+    };
+
+    /** Percentiles over the counts added since the previous update() (one instance per reader). */
+    class WindowStats
+    {
+    public:
+        void update (StageProfiler& profiler) noexcept;
+        const Stats& get (Stage stage) const noexcept { return stats_[static_cast<std::size_t> (stage)]; }
+
+    private:
+        std::array<Counts, kNumStages> previous_ {};
+        std::array<Stats, kNumStages> stats_ {};
+    };
+
+    /** Bin centre (geometric) in ns. */
+    static double getBinCentreNs (int bin) noexcept;
+
+private:
+    void record (Stage stage, int64_t ticks) noexcept;
+    static int binForNs (uint32_t ns) noexcept;
+
+    std::array<std::array<std::atomic<uint32_t>, kNumBins>, kNumStages> counts_;
+    std::array<std::atomic<uint32_t>, kNumStages> windowMaxNs_;   // Writer raises, reader takes-and-clears
+    std::atomic<uint32_t> deadlineNs_ { 0 };
+    std::atomic<bool> enabled_ { false };
+    double nsPerTick_ = 1.0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (StageProfiler)
+};
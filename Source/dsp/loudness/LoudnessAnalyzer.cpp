@@ -9,6 +9,7 @@
 */
 
 #include "LoudnessAnalyzer.h"
+#include "../simd/SpectrumKernels.h"
 
 namespace AnalyzerPro::dsp
 {
@@ -41,6 +42,8 @@ void LoudnessAnalyzer::reset()
     // Reset integration
     std::fill (historyBuffer.begin(), historyBuffer.end(), BlockEnergy{});
     historyWriteIndex = 0;
+    silentSamples = 0;
+    filtersIdle = false;
     
     integratedSumSquaresL = 1e-10;
     integratedSumSquaresR = 1e-10;
@@ -98,7 +101,27 @@ void LoudnessAnalyzer::process (const juce::AudioBuffer<float>& buffer)
     const float* inL = buffer.getReadPointer (0);
     const float* inR = (buffer.getNumChannels() > 1) ? buffer.getReadPointer (1) : nullptr;
 
-    for (int i = 0; i < numSamples; ++i)
+    // Digital silence: the filters' outputs are exactly their decaying tails, so once those have
+    // rung out a silent block contributes zero energy and no peak. Record it without the biquads
+    // (zeroing their state once keeps the resume exact and denormal-free).
+    const bool blockSilent = SpectrumKernels::isSilent (inL, numSamples, kSilenceThreshold)
+                          && (inR == nullptr || SpectrumKernels::isSilent (inR, numSamples, kSilenceThreshold));
+    const int64_t settleSamples = static_cast<int64_t> (kFilterSettleSeconds * currentSampleRate);
+    const bool skipFilters = blockSilent && silentSamples >= settleSamples;
+
+    if (skipFilters && ! filtersIdle)
+    {
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            preFilter[ch]->reset();
+            rlbFilter[ch]->reset();
+        }
+    }
+
+    filtersIdle = skipFilters;
+    silentSamples = blockSilent ? juce::jmin (silentSamples + numSamples, settleSamples) : 0;
+
+    for (int i = 0; i < numSamples && ! skipFilters; ++i)
     {
         // 1. Get input
         float l = inL[i];
@@ -239,6 +262,14 @@ void LoudnessAnalyzer::resetPeak()
     atomicPeak.store(-100.0f);
 }
 
+void LoudnessAnalyzer::resetIntegrated()
+{
+    integratedSumSquaresL = 1e-10;
+    integratedSumSquaresR = 1e-10;
+    integratedTotalSamples = 0;
+    atomicI.store (-100.0f);
+}
+
 float LoudnessAnalyzer::unitsToLufs (double meanSquareSum) const
 {
     if (meanSquareSum <= 1e-10) return -100.0f;
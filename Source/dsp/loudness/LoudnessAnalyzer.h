@@ -35,6 +35,9 @@ public:
     void prepare (double sampleRate, int estimatedSamplesPerBlock);
     void reset();
     void resetPeak();
+    /** Restarts the integrated measurement only (filters and M/S windows keep their history,
+        e.g. after an offline warm-up pre-roll). */
+    void resetIntegrated();
     void process (const juce::AudioBuffer<float>& buffer);
 
     LoudnessSnapshot getSnapshot() const;
@@ -58,6 +61,13 @@ private:
         int numSamples = 0;
     };
 
+    // Digital-silence fast path: once the K-weighting filters have rung out, silent blocks are
+    // recorded as zero energy without running the biquads (see process())
+    static constexpr float kSilenceThreshold = 1.0e-15f;   // ~ -300 dBFS
+    static constexpr double kFilterSettleSeconds = 0.5;    // 38 Hz high-pass tail is < -300 dB well before this
+    int64_t silentSamples = 0;
+    bool filtersIdle = false;
+
     // Circular buffer for history
     std::vector<BlockEnergy> historyBuffer;
     int historyWriteIndex = 0;
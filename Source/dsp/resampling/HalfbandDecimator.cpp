@@ -0,0 +1,120 @@
+/*
+  ==============================================================================
+
+    HalfbandDecimator.cpp
+    Created: 16 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "HalfbandDecimator.h"
+#include <cmath>
+
+namespace AnalyzerPro::dsp
+{
+
+namespace
+{
+    // Zeroth-order modified Bessel function (power series, converges fast for beta < 20)
+    double besselI0 (double x) noexcept
+    {
+        double sum = 1.0;
+        double term = 1.0;
+        const double halfX = 0.5 * x;
+
+        for (int k = 1; k < 50; ++k)
+        {
+            term *= (halfX / static_cast<double> (k)) * (halfX / static_cast<double> (k));
+            sum += term;
+            if (term < sum * 1.0e-12)
+                break;
+        }
+
+        return sum;
+    }
+}
+
+HalfbandDecimator::HalfbandDecimator()
+{
+    computeCoefficients();
+}
+
+void HalfbandDecimator::setResponse (Response newResponse) noexcept
+{
+    if (newResponse == response_)
+        return;
+
+    response_ = newResponse;
+    numTaps_ = (response_ == Response::Steep) ? kSteepTaps : kStandardTaps;
+    centre_ = (numTaps_ - 1) / 2;
+    numPairs_ = (numTaps_ + 1) / 4;
+    computeCoefficients();
+    reset();
+}
+
+void HalfbandDecimator::computeCoefficients() noexcept
+{
+    // Kaiser-windowed ideal halfband (cutoff fs/4). beta ~ 0.1102 * (A - 8.7) for A = 90 dB;
+    // the tap count alone sets the transition width.
+    constexpr double beta = 8.96;
+    const double i0Beta = besselI0 (beta);
+
+    for (int i = 0; i < numPairs_; ++i)
+    {
+        const int n = 2 * i + 1;  // Odd offset from the centre
+        const double ratio = static_cast<double> (n) / static_cast<double> (centre_);
+        const double window = besselI0 (beta * std::sqrt (1.0 - ratio * ratio)) / i0Beta;
+        const double sinc = std::sin (juce::MathConstants<double>::halfPi * n) / (juce::MathConstants<double>::pi * n);
+        pairCoeffs_[static_cast<std::size_t> (i)] = static_cast<float> (sinc * window);
+    }
+
+    // Normalise DC gain to exactly 1 (centre 0.5 + 2 * sum(pairs))
+    double pairSum = 0.0;
+    for (int i = 0; i < numPairs_; ++i)
+        pairSum += static_cast<double> (pairCoeffs_[static_cast<std::size_t> (i)]);
+
+    const float pairScale = static_cast<float> (0.5 / (2.0 * pairSum));
+    for (int i = 0; i < numPairs_; ++i)
+        pairCoeffs_[static_cast<std::size_t> (i)] *= pairScale;
+}
+
+void HalfbandDecimator::reset() noexcept
+{
+    history_.fill (0.0f);
+    writePos_ = 0;
+    emitNext_ = false;
+}
+
+int HalfbandDecimator::process (const float* in, float* out, int numIn) noexcept
+{
+    int numOut = 0;
+
+    for (int n = 0; n < numIn; ++n)
+    {
+        const float x = in[n];
+        history_[static_cast<std::size_t> (writePos_)] = x;
+        history_[static_cast<std::size_t> (writePos_ + numTaps_)] = x;
+        writePos_ = (writePos_ + 1 == numTaps_) ? 0 : writePos_ + 1;
+
+        emitNext_ = ! emitNext_;
+        if (! emitNext_)
+            continue;
+
+        // Oldest..newest sample of the current window are contiguous from writePos_
+        const float* w = history_.data() + writePos_;
+        float acc = 0.5f * w[centre_];
+
+        for (int i = 0; i < numPairs_; ++i)
+        {
+            const int offset = 2 * i + 1;
+            acc += pairCoeffs_[static_cast<std::size_t> (i)] * (w[centre_ - offset] + w[centre_ + offset]);
+        }
+
+        // Safe in place: out[numOut] trails in[n] (numOut <= n / 2)
+        out[numOut++] = acc;
+    }
+
+    return numOut;
+}
+
+} // namespace AnalyzerPro::dsp
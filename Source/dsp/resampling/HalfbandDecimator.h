@@ -0,0 +1,89 @@
+/*
+  ==============================================================================
+
+    HalfbandDecimator.h
+    Created: 16 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <array>
+
+namespace AnalyzerPro::dsp
+{
+
+//==============================================================================
+/**
+    Single-channel 2:1 decimator built on a linear-phase halfband FIR.
+
+    Every other tap of a halfband filter is zero, so one output sample costs
+    (numTaps + 1) / 4 symmetric pair MACs plus the centre tap. Two Kaiser-windowed
+    designs, both rejecting > ~90 dB in the stopband:
+    - Standard (59 taps): flat to 0.2 fs(in), stopband from 0.3 fs(in), so the decimated
+      signal is alias-free up to 0.4 fs(out). Cascade instances for octave decimation trees.
+    - Steep (75 taps): flat to 0.21 fs(in), stopband from 0.29 fs(in) (alias-free up to
+      0.42 fs(out), 20 kHz at 96 -> 48 kHz). For the last stage of a cascade, where the
+      band of interest sits closest to the new Nyquist; earlier stages keep the cheap design.
+
+    No allocation: all state lives in fixed arrays. process() is RT-safe.
+*/
+class HalfbandDecimator
+{
+public:
+    enum class Response
+    {
+        Standard,
+        Steep
+    };
+
+    static constexpr int kStandardTaps = 59;                // 4k - 1 so the outermost taps are non-zero
+    static constexpr int kSteepTaps = 75;
+    static constexpr int kMaxTaps = kSteepTaps;
+
+    /** Flat passband / stopband edges as a fraction of the input rate. */
+    static constexpr float getPassbandEdge (Response response) noexcept { return response == Response::Steep ? 0.21f : 0.2f; }
+    static constexpr float getStopbandEdge (Response response) noexcept { return response == Response::Steep ? 0.29f : 0.3f; }
+
+    HalfbandDecimator();
+
+    /** Selects the filter design (Standard by default). Recomputes the coefficients and
+        clears the state when it changes: call while not processing. */
+    void setResponse (Response newResponse) noexcept;
+    Response getResponse() const noexcept { return response_; }
+
+    /** Clears the delay line and the decimation phase. */
+    void reset() noexcept;
+
+    /** Filters and decimates numIn samples. Writes up to (numIn + 1) / 2 samples
+        (depending on the carried phase) and returns how many were written. In-place
+        operation (out == in) is allowed. */
+    int process (const float* in, float* out, int numIn) noexcept;
+
+    /** Group delay in input samples. */
+    int getLatencyInSamples() const noexcept { return centre_; }
+
+private:
+    void computeCoefficients() noexcept;
+
+    Response response_ = Response::Standard;
+    int numTaps_ = kStandardTaps;
+    int centre_ = (kStandardTaps - 1) / 2;
+
+    // Non-zero odd-offset taps h[centre_ +/- (2i + 1)] (symmetric), centre tap is exactly 0.5
+    static constexpr int kMaxPairs = (kMaxTaps + 1) / 4;
+    int numPairs_ = (kStandardTaps + 1) / 4;
+    std::array<float, kMaxPairs> pairCoeffs_ {};
+
+    // Mirrored delay line: each sample is stored at [pos] and [pos + numTaps_], so the
+    // latest numTaps_ samples are always contiguous (no modulo in the MAC loop)
+    std::array<float, 2 * kMaxTaps> history_ {};
+    int writePos_ = 0;
+    bool emitNext_ = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (HalfbandDecimator)
+};
+
+} // namespace AnalyzerPro::dsp
@@ -0,0 +1,432 @@
+/*
+  ==============================================================================
+
+    SpectrumKernels.cpp
+    Created: 16 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "SpectrumKernels.h"
+
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if defined (__AVX2__)
+ #include <immintrin.h>
+ #define ANALYZERPRO_KERNELS_AVX2 1
+#elif defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2)
+ #include <emmintrin.h>
+ #define ANALYZERPRO_KERNELS_SSE2 1
+#elif defined (__ARM_NEON) && defined (__aarch64__)
+ #include <arm_neon.h>
+ #define ANALYZERPRO_KERNELS_NEON 1
+#endif
+
+namespace AnalyzerPro::dsp::SpectrumKernels
+{
+
+namespace
+{
+    //==============================================================================
+    // Shared constants (every path evaluates the same approximation)
+    constexpr float kSqrt2 = 1.41421356237f;
+    constexpr float kDbPerLog2 = 3.01029995664f;        // 10 * log10 (2)
+    constexpr float kLog2PerDb = 0.332192809489f;       // log2 (10) / 10
+
+    // log2 (m) = (2 / ln 2) * atanh (s), s = (m - 1) / (m + 1), |s| <= 0.1716 for m in [sqrt(1/2), sqrt(2))
+    constexpr float kLogC1 = 2.88539008178f;            // 2 / ln 2
+    constexpr float kLogC3 = 0.961796693926f;           // 2 / (3 ln 2)
+    constexpr float kLogC5 = 0.577078016356f;           // 2 / (5 ln 2)
+    constexpr float kLogC7 = 0.412198583111f;           // 2 / (7 ln 2)
+
+    // 2^f = sum (f ln 2)^k / k!, f in [-0.5, 0.5]
+    constexpr float kExpC1 = 0.693147180560f;
+    constexpr float kExpC2 = 0.240226506959f;
+    constexpr float kExpC3 = 0.0555041086648f;
+    constexpr float kExpC4 = 0.00961812910763f;
+    constexpr float kExpC5 = 0.00133335581464f;
+    constexpr float kExpC6 = 0.000154035303934f;
+
+    constexpr float kMinExp2 = -126.0f;                 // Below this the result flushes to 0
+    constexpr float kMaxExp2 = 127.0f;
+
+    /** Floor in the power domain (never denormal, so the exponent extraction stays exact). */
+    float floorPowerFor (float floorDb) noexcept
+    {
+        const float p = std::pow (10.0f, floorDb * 0.1f);
+        return (p > FLT_MIN) ? p : FLT_MIN;
+    }
+
+    //==============================================================================
+    inline float scalarLog2 (float x) noexcept
+    {
+        // x is positive, finite and normal here
+        uint32_t bits;
+        std::memcpy (&bits, &x, sizeof (bits));
+
+        float e = static_cast<float> (static_cast<int> (bits >> 23) - 127);
+        bits = (bits & 0x007fffffu) | 0x3f800000u;
+
+        float m;
+        std::memcpy (&m, &bits, sizeof (m));
+
+        if (m > kSqrt2)
+        {
+            m *= 0.5f;
+            e += 1.0f;
+        }
+
+        const float s = (m - 1.0f) / (m + 1.0f);
+        const float s2 = s * s;
+        return e + s * (kLogC1 + s2 * (kLogC3 + s2 * (kLogC5 + s2 * kLogC7)));
+    }
+
+    inline float scalarPowerToDb (float x, float floorPower, float floorDb) noexcept
+    {
+        x = (x > floorPower) ? x : floorPower;   // NaN -> floor
+        x = (x < FLT_MAX) ? x : FLT_MAX;
+        const float db = kDbPerLog2 * scalarLog2 (x);
+        return (db > floorDb) ? db : floorDb;
+    }
+
+    inline float scalarExp2 (float x) noexcept
+    {
+        if (! (x >= kMinExp2))
+            return 0.0f;
+
+        x = (x < kMaxExp2) ? x : kMaxExp2;
+
+        const float n = std::floor (x + 0.5f);
+        const float f = x - n;
+        const float p = 1.0f + f * (kExpC1 + f * (kExpC2 + f * (kExpC3 + f * (kExpC4 + f * (kExpC5 + f * kExpC6)))));
+
+        const uint32_t bits = static_cast<uint32_t> (static_cast<int> (n) + 127) << 23;
+        float scale;
+        std::memcpy (&scale, &bits, sizeof (scale));
+        return scale * p;
+    }
+
+    inline float scalarSanitize (float x, float minDb, float maxDb) noexcept
+    {
+        x = (x > minDb) ? x : minDb;             // NaN -> minDb
+        return (x < maxDb) ? x : maxDb;
+    }
+
+    //==============================================================================
+   #if ANALYZERPRO_KERNELS_AVX2
+    constexpr int kLanes = 8;
+
+    struct Vec
+    {
+        using V = __m256;
+
+        static V load (const float* p) noexcept                 { return _mm256_loadu_ps (p); }
+        static void store (float* p, V v) noexcept              { _mm256_storeu_ps (p, v); }
+        static V set (float x) noexcept                         { return _mm256_set1_ps (x); }
+        static V mul (V a, V b) noexcept                        { return _mm256_mul_ps (a, b); }
+        static V add (V a, V b) noexcept                        { return _mm256_add_ps (a, b); }
+        static float sum (V v) noexcept
+        {
+            __m128 x = _mm_add_ps (_mm256_castps256_ps128 (v), _mm256_extractf128_ps (v, 1));
+            x = _mm_add_ps (x, _mm_movehl_ps (x, x));
+            return _mm_cvtss_f32 (_mm_add_ss (x, _mm_shuffle_ps (x, x, 1)));
+        }
+        // max/min return the SECOND operand when the first is NaN
+        static V maxNanToB (V a, V b) noexcept                  { return _mm256_max_ps (a, b); }
+        static V minNanToB (V a, V b) noexcept                  { return _mm256_min_ps (a, b); }
+        static V abs (V v) noexcept                             { return _mm256_andnot_ps (_mm256_set1_ps (-0.0f), v); }
+        static bool anyGreater (V a, V b) noexcept              { return _mm256_movemask_ps (_mm256_cmp_ps (a, b, _CMP_NLE_UQ)) != 0; }  // NaN -> true
+
+        static V log2 (V x) noexcept
+        {
+            const __m256i bits = _mm256_castps_si256 (x);
+            V e = _mm256_cvtepi32_ps (_mm256_sub_epi32 (_mm256_srli_epi32 (bits, 23), _mm256_set1_epi32 (127)));
+            V m = _mm256_castsi256_ps (_mm256_or_si256 (_mm256_and_si256 (bits, _mm256_set1_epi32 (0x007fffff)),
+                                                        _mm256_set1_epi32 (0x3f800000)));
+
+            const V one = set (1.0f);
+            const V big = _mm256_cmp_ps (m, set (kSqrt2), _CMP_GT_OQ);
+            m = _mm256_blendv_ps (m, _mm256_mul_ps (m, set (0.5f)), big);
+            e = _mm256_add_ps (e, _mm256_and_ps (big, one));
+
+            const V s = _mm256_div_ps (_mm256_sub_ps (m, one), _mm256_add_ps (m, one));
+            const V s2 = _mm256_mul_ps (s, s);
+            V p = _mm256_add_ps (set (kLogC5), _mm256_mul_ps (s2, set (kLogC7)));
+            p = _mm256_add_ps (set (kLogC3), _mm256_mul_ps (s2, p));
+            p = _mm256_add_ps (set (kLogC1), _mm256_mul_ps (s2, p));
+            return _mm256_add_ps (e, _mm256_mul_ps (s, p));
+        }
+
+        static V exp2 (V x) noexcept
+        {
+            const V inRange = _mm256_cmp_ps (x, set (kMinExp2), _CMP_GE_OQ);
+            x = _mm256_min_ps (_mm256_max_ps (x, set (kMinExp2)), set (kMaxExp2));
+
+            const __m256i n = _mm256_cvtps_epi32 (x);     // Round to nearest
+            const V f = _mm256_sub_ps (x, _mm256_cvtepi32_ps (n));
+
+            V p = _mm256_add_ps (set (kExpC5), _mm256_mul_ps (f, set (kExpC6)));
+            p = _mm256_add_ps (set (kExpC4), _mm256_mul_ps (f, p));
+            p = _mm256_add_ps (set (kExpC3), _mm256_mul_ps (f, p));
+            p = _mm256_add_ps (set (kExpC2), _mm256_mul_ps (f, p));
+            p = _mm256_add_ps (set (kExpC1), _mm256_mul_ps (f, p));
+            p = _mm256_add_ps (set (1.0f), _mm256_mul_ps (f, p));
+
+            const V scale = _mm256_castsi256_ps (_mm256_slli_epi32 (_mm256_add_epi32 (n, _mm256_set1_epi32 (127)), 23));
+            return _mm256_and_ps (_mm256_mul_ps (scale, p), inRange);
+        }
+    };
+
+   #elif ANALYZERPRO_KERNELS_SSE2
+    constexpr int kLanes = 4;
+
+    struct Vec
+    {
+        using V = __m128;
+
+        static V load (const float* p) noexcept                 { return _mm_loadu_ps (p); }
+        static void store (float* p, V v) noexcept              { _mm_storeu_ps (p, v); }
+        static V set (float x) noexcept                         { return _mm_set1_ps (x); }
+        static V mul (V a, V b) noexcept                        { return _mm_mul_ps (a, b); }
+        static V add (V a, V b) noexcept                        { return _mm_add_ps (a, b); }
+        static float sum (V v) noexcept
+        {
+            const __m128 x = _mm_add_ps (v, _mm_movehl_ps (v, v));
+            return _mm_cvtss_f32 (_mm_add_ss (x, _mm_shuffle_ps (x, x, 1)));
+        }
+        // max/min return the SECOND operand when the first is NaN
+        static V maxNanToB (V a, V b) noexcept                  { return _mm_max_ps (a, b); }
+        static V minNanToB (V a, V b) noexcept                  { return _mm_min_ps (a, b); }
+        static V abs (V v) noexcept                             { return _mm_andnot_ps (_mm_set1_ps (-0.0f), v); }
+        static bool anyGreater (V a, V b) noexcept              { return _mm_movemask_ps (_mm_cmpnle_ps (a, b)) != 0; }  // NaN -> true
+
+        static V log2 (V x) noexcept
+        {
+            const __m128i bits = _mm_castps_si128 (x);
+            V e = _mm_cvtepi32_ps (_mm_sub_epi32 (_mm_srli_epi32 (bits, 23), _mm_set1_epi32 (127)));
+            V m = _mm_castsi128_ps (_mm_or_si128 (_mm_and_si128 (bits, _mm_set1_epi32 (0x007fffff)),
+                                                  _mm_set1_epi32 (0x3f800000)));
+
+            const V one = set (1.0f);
+            const V big = _mm_cmpgt_ps (m, set (kSqrt2));
+            m = _mm_mul_ps (m, _mm_or_ps (_mm_and_ps (big, set (0.5f)), _mm_andnot_ps (big, one)));
+            e = _mm_add_ps (e, _mm_and_ps (big, one));
+
+            const V s = _mm_div_ps (_mm_sub_ps (m, one), _mm_add_ps (m, one));
+            const V s2 = _mm_mul_ps (s, s);
+            V p = _mm_add_ps (set (kLogC5), _mm_mul_ps (s2, set (kLogC7)));
+            p = _mm_add_ps (set (kLogC3), _mm_mul_ps (s2, p));
+            p = _mm_add_ps (set (kLogC1), _mm_mul_ps (s2, p));
+            return _mm_add_ps (e, _mm_mul_ps (s, p));
+        }
+
+        static V exp2 (V x) noexcept
+        {
+            const V inRange = _mm_cmpge_ps (x, set (kMinExp2));
+            x = _mm_min_ps (_mm_max_ps (x, set (kMinExp2)), set (kMaxExp2));
+
+            const __m128i n = _mm_cvtps_epi32 (x);        // Round to nearest
+            const V f = _mm_sub_ps (x, _mm_cvtepi32_ps (n));
+
+            V p = _mm_add_ps (set (kExpC5), _mm_mul_ps (f, set (kExpC6)));
+            p = _mm_add_ps (set (kExpC4), _mm_mul_ps (f, p));
+            p = _mm_add_ps (set (kExpC3), _mm_mul_ps (f, p));
+            p = _mm_add_ps (set (kExpC2), _mm_mul_ps (f, p));
+            p = _mm_add_ps (set (kExpC1), _mm_mul_ps (f, p));
+            p = _mm_add_ps (set (1.0f), _mm_mul_ps (f, p));
+
+            const V scale = _mm_castsi128_ps (_mm_slli_epi32 (_mm_add_epi32 (n, _mm_set1_epi32 (127)), 23));
+            return _mm_and_ps (_mm_mul_ps (scale, p), inRange);
+        }
+    };
+
+   #elif ANALYZERPRO_KERNELS_NEON
+    constexpr int kLanes = 4;
+
+    struct Vec
+    {
+        using V = float32x4_t;
+
+        static V load (const float* p) noexcept                 { return vld1q_f32 (p); }
+        static void store (float* p, V v) noexcept              { vst1q_f32 (p, v); }
+        static V set (float x) noexcept                         { return vdupq_n_f32 (x); }
+        static V mul (V a, V b) noexcept                        { return vmulq_f32 (a, b); }
+        static V add (V a, V b) noexcept                        { return vaddq_f32 (a, b); }
+        static float sum (V v) noexcept                         { return vaddvq_f32 (v); }
+        // NEON max/min propagate NaN, so select explicitly (comparisons with NaN are false)
+        static V maxNanToB (V a, V b) noexcept                  { return vbslq_f32 (vcgtq_f32 (a, b), a, b); }
+        static V minNanToB (V a, V b) noexcept                  { return vbslq_f32 (vcltq_f32 (a, b), a, b); }
+        static V abs (V v) noexcept                             { return vabsq_f32 (v); }
+        static bool anyGreater (V a, V b) noexcept              { return vmaxvq_u32 (vmvnq_u32 (vcleq_f32 (a, b))) != 0; }  // NaN -> true
+
+        static V log2 (V x) noexcept
+        {
+            const uint32x4_t bits = vreinterpretq_u32_f32 (x);
+            V e = vcvtq_f32_s32 (vsubq_s32 (vreinterpretq_s32_u32 (vshrq_n_u32 (bits, 23)), vdupq_n_s32 (127)));
+            V m = vreinterpretq_f32_u32 (vorrq_u32 (vandq_u32 (bits, vdupq_n_u32 (0x007fffffu)), vdupq_n_u32 (0x3f800000u)));
+
+            const V one = set (1.0f);
+            const uint32x4_t big = vcgtq_f32 (m, set (kSqrt2));
+            m = vbslq_f32 (big, vmulq_f32 (m, set (0.5f)), m);
+            e = vaddq_f32 (e, vbslq_f32 (big, one, set (0.0f)));
+
+            const V s = vdivq_f32 (vsubq_f32 (m, one), vaddq_f32 (m, one));
+            const V s2 = vmulq_f32 (s, s);
+            V p = vfmaq_f32 (set (kLogC5), s2, set (kLogC7));
+            p = vfmaq_f32 (set (kLogC3), s2, p);
+            p = vfmaq_f32 (set (kLogC1), s2, p);
+            return vfmaq_f32 (e, s, p);
+        }
+
+        static V exp2 (V x) noexcept
+        {
+            const uint32x4_t inRange = vcgeq_f32 (x, set (kMinExp2));
+            x = vminq_f32 (vmaxq_f32 (x, set (kMinExp2)), set (kMaxExp2));
+
+            const int32x4_t n = vcvtnq_s32_f32 (x);       // Round to nearest
+            const V f = vsubq_f32 (x, vcvtq_f32_s32 (n));
+
+            V p = vfmaq_f32 (set (kExpC5), f, set (kExpC6));
+            p = vfmaq_f32 (set (kExpC4), f, p);
+            p = vfmaq_f32 (set (kExpC3), f, p);
+            p = vfmaq_f32 (set (kExpC2), f, p);
+            p = vfmaq_f32 (set (kExpC1), f, p);
+            p = vfmaq_f32 (set (1.0f), f, p);
+
+            const V scale = vreinterpretq_f32_s32 (vshlq_n_s32 (vaddq_s32 (n, vdupq_n_s32 (127)), 23));
+            return vreinterpretq_f32_u32 (vandq_u32 (vreinterpretq_u32_f32 (vmulq_f32 (scale, p)), inRange));
+        }
+    };
+   #endif
+
+   #if ANALYZERPRO_KERNELS_AVX2 || ANALYZERPRO_KERNELS_SSE2 || ANALYZERPRO_KERNELS_NEON
+    #define ANALYZERPRO_KERNELS_SIMD 1
+   #endif
+}
+
+//==============================================================================
+void powerToDb (const float* power, float* db, int n, float floorDb) noexcept
+{
+    powerToDb (&power, &db, 1, n, floorDb);
+}
+
+void powerToDb (const float* const* powers, float* const* dbs, int numTraces, int n, float floorDb) noexcept
+{
+    const float floorPower = floorPowerFor (floorDb);
+    int i = 0;
+
+   #if ANALYZERPRO_KERNELS_SIMD
+    const auto vFloorPower = Vec::set (floorPower);
+    const auto vMaxPower = Vec::set (FLT_MAX);
+    const auto vFloorDb = Vec::set (floorDb);
+    const auto vDbPerLog2 = Vec::set (kDbPerLog2);
+
+    for (; i + kLanes <= n; i += kLanes)
+    {
+        for (int t = 0; t < numTraces; ++t)
+        {
+            auto x = Vec::maxNanToB (Vec::load (powers[t] + i), vFloorPower);  // NaN -> floor
+            x = Vec::minNanToB (x, vMaxPower);
+            Vec::store (dbs[t] + i, Vec::maxNanToB (Vec::mul (Vec::log2 (x), vDbPerLog2), vFloorDb));
+        }
+    }
+   #endif
+
+    for (; i < n; ++i)
+        for (int t = 0; t < numTraces; ++t)
+            dbs[t][i] = scalarPowerToDb (powers[t][i], floorPower, floorDb);
+}
+
+void dbToPower (const float* db, float* power, int n) noexcept
+{
+    int i = 0;
+
+   #if ANALYZERPRO_KERNELS_SIMD
+    const auto vLog2PerDb = Vec::set (kLog2PerDb);
+
+    for (; i + kLanes <= n; i += kLanes)
+        Vec::store (power + i, Vec::exp2 (Vec::mul (Vec::load (db + i), vLog2PerDb)));
+   #endif
+
+    for (; i < n; ++i)
+        power[i] = scalarExp2 (db[i] * kLog2PerDb);
+}
+
+void sanitizeDb (float* db, int n, float minDb, float maxDb) noexcept
+{
+    int i = 0;
+
+   #if ANALYZERPRO_KERNELS_SIMD
+    const auto vMin = Vec::set (minDb);
+    const auto vMax = Vec::set (maxDb);
+
+    for (; i + kLanes <= n; i += kLanes)
+        Vec::store (db + i, Vec::minNanToB (Vec::maxNanToB (Vec::load (db + i), vMin), vMax));
+   #endif
+
+    for (; i < n; ++i)
+        db[i] = scalarSanitize (db[i], minDb, maxDb);
+}
+
+float dot (const float* a, const float* b, int n) noexcept
+{
+    int i = 0;
+    float result = 0.0f;
+
+   #if ANALYZERPRO_KERNELS_SIMD
+    // Two independent accumulators hide the add latency
+    auto acc0 = Vec::set (0.0f);
+    auto acc1 = Vec::set (0.0f);
+
+    for (; i + 2 * kLanes <= n; i += 2 * kLanes)
+    {
+        acc0 = Vec::add (acc0, Vec::mul (Vec::load (a + i), Vec::load (b + i)));
+        acc1 = Vec::add (acc1, Vec::mul (Vec::load (a + i + kLanes), Vec::load (b + i + kLanes)));
+    }
+
+    for (; i + kLanes <= n; i += kLanes)
+        acc0 = Vec::add (acc0, Vec::mul (Vec::load (a + i), Vec::load (b + i)));
+
+    result = Vec::sum (Vec::add (acc0, acc1));
+   #endif
+
+    for (; i < n; ++i)
+        result += a[i] * b[i];
+
+    return result;
+}
+
+bool isSilent (const float* x, int n, float threshold) noexcept
+{
+    int i = 0;
+
+   #if ANALYZERPRO_KERNELS_SIMD
+    const auto vThreshold = Vec::set (threshold);
+
+    for (; i + kLanes <= n; i += kLanes)
+        if (Vec::anyGreater (Vec::abs (Vec::load (x + i)), vThreshold))
+            return false;
+   #endif
+
+    for (; i < n; ++i)
+        if (! (std::abs (x[i]) <= threshold))   // NaN -> signal
+            return false;
+
+    return true;
+}
+
+float fastPowerToDb (float power) noexcept
+{
+    // Floor at the smallest normal float (~ -379 dB): the result is exact for every normal input
+    return scalarPowerToDb (power, FLT_MIN, -380.0f);
+}
+
+float fastDbToPower (float db) noexcept
+{
+    return scalarExp2 (db * kLog2PerDb);
+}
+
+} // namespace AnalyzerPro::dsp::SpectrumKernels
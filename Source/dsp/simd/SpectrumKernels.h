@@ -0,0 +1,59 @@
+/*
+  ==============================================================================
+
+    SpectrumKernels.h
+    Created: 16 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+namespace AnalyzerPro::dsp::SpectrumKernels
+{
+
+//==============================================================================
+/*
+    Vectorised per-bin kernels for the spectrum pipeline (engine and UI).
+
+    The transcendental work is done with bit-level approximations instead of libm:
+      - log2: exponent from the float bits, mantissa folded to [sqrt(1/2), sqrt(2))
+        and an odd atanh series (|error| < 1e-4 dB over the whole float range)
+      - exp2: round-to-nearest split, degree-6 polynomial for the fraction and the
+        integer part written straight into the exponent bits (relative error < 1e-5)
+
+    Paths: AVX2 (8 lanes) when the compiler targets it, SSE2 or NEON (4 lanes)
+    otherwise, and a scalar fallback that evaluates the same approximation, so
+    every build produces the same values to within float rounding.
+
+    All functions are RT-safe (no allocation, no locks) and accept in-place
+    operation (dest == source). n may be any length; tails run through the
+    scalar path.
+*/
+
+/** dB = 10 * log10 (max (power, 10^(floorDb / 10))). NaN and negative power read as floorDb. */
+void powerToDb (const float* power, float* db, int n, float floorDb) noexcept;
+
+/** powerToDb() over several equally long traces in ONE pass over the bins
+    (constants loaded once, one loop instead of numTraces). */
+void powerToDb (const float* const* powers, float* const* dbs, int numTraces, int n, float floorDb) noexcept;
+
+/** power = 10^(db / 10). Inputs below -380 dB flush to 0. */
+void dbToPower (const float* db, float* power, int n) noexcept;
+
+/** Clamps dB values to [minDb, maxDb]; NaN reads as minDb, +/-inf clamp to the nearest bound. */
+void sanitizeDb (float* db, int n, float minDb, float maxDb) noexcept;
+
+/** Sum of a[i] * b[i] (rows of the sparse bin -> band/log matrices). */
+float dot (const float* a, const float* b, int n) noexcept;
+
+/** True when every |x[i]| <= threshold (digital silence / denormal-level residue).
+    NaN counts as signal. Returns at the first vector above the threshold, so live
+    audio costs a few instructions per block. */
+bool isSilent (const float* x, int n, float threshold) noexcept;
+
+/** Scalar versions of the same approximations (for single values and tests). */
+float fastPowerToDb (float power) noexcept;
+float fastDbToPower (float db) noexcept;
+
+} // namespace AnalyzerPro::dsp::SpectrumKernels
@@ -13,7 +13,10 @@ MainView::MainView (mdsp_ui::UiContext& ui, AnalayzerProAudioProcessor& p, juce:
       rail_ (ui_),
       footer_ (ui_),
       analyzerView_ (p),
-      stereoScopeView_ (ui, p.getAnalyzerEngine().getStereoScopeAnalyzer()),
+      stereoScopeView_ (ui, p.getAnalyzerEngine()),
+      spectrogramView_ (ui, p.getAnalyzerEngine()),
+      profilerOverlay_ (ui, p.getStageProfiler()),
+      channelSpectraView_ (ui, p),
       loudnessPanel_ (ui, p),
       outputMeters_ (ui_, p, MeterGroupComponent::GroupType::Output),
       inputMeters_ (ui_, p, MeterGroupComponent::GroupType::Input)
@@ -28,9 +31,12 @@ MainView::MainView (mdsp_ui::UiContext& ui, AnalayzerProAudioProcessor& p, juce:
     addAndMakeVisible (footer_);
     addAndMakeVisible (analyzerView_);
     addAndMakeVisible (stereoScopeView_);
+    addChildComponent (spectrogramView_);   // Shown by analyzerShowSpectrogram
     addAndMakeVisible (loudnessPanel_);
     addAndMakeVisible (outputMeters_);
     addAndMakeVisible (inputMeters_);
+    addChildComponent (channelSpectraView_);   // Toggled with "C" (per-channel spectra)
+    addChildComponent (profilerOverlay_);   // Toggled with "P" (diagnostics)
     
     // Initialize header and rail with control binder
     header_.setControlBinder (controls_.getBinder());
@@ -44,6 +50,10 @@ MainView::MainView (mdsp_ui::UiContext& ui, AnalayzerProAudioProcessor& p, juce:
     {
         triggerResetPeaks();
     });
+    rail_.setResetLtasCallback ([this]
+    {
+        audioProcessor.getAnalyzerEngine().resetLtas();
+    });
     
     rail_.onScopeModeChanged = [this] (int id)
     {
@@ -75,6 +85,7 @@ MainView::MainView (mdsp_ui::UiContext& ui, AnalayzerProAudioProcessor& p, juce:
         apvts->addParameterListener ("meterChannelMode", this); // New
         apvts->addParameterListener ("meterPeakHold", this); // Peak Hold
         apvts->addParameterListener ("scopePeakHold", this); // Peak Hold
+        apvts->addParameterListener ("analyzerShowSpectrogram", this);
     }
 
     // HeaderBar is authoritative for Mode/FFT/Averaging controls
@@ -173,6 +184,10 @@ MainView::MainView (mdsp_ui::UiContext& ui, AnalayzerProAudioProcessor& p, juce:
             const bool hold = raw->load() > 0.5f;
             stereoScopeView_.setHoldEnabled (hold);
         }
+        
+        // Apply Spectrogram visibility
+        if (auto* raw = apvts_->getRawParameterValue ("analyzerShowSpectrogram"))
+            setSpectrogramVisible (raw->load() > 0.5f);
     }
 
     //setSize (900, 650);  // Slightly bigger to fit all controls
@@ -207,10 +222,13 @@ void MainView::shutdown()
         apvts_->removeParameterListener ("DbRange", this);
         apvts_->removeParameterListener ("DisplayGain", this);
         apvts_->removeParameterListener ("Tilt", this);
+        apvts_->removeParameterListener ("analyzerShowSpectrogram", this);
     }
     
     // Shutdown child views that have timers/listeners
     analyzerView_.shutdown();
+    profilerOverlay_.setVisible (false);   // Stops its timer and switches profiling off
+    channelSpectraView_.setVisible (false); // Stops its timer and releases the channel slots
     
     // Clear control binder attachments (must happen before controls are destroyed)
     controls_.getBinder().clear();
@@ -265,9 +283,9 @@ void MainView::parameterChanged (const juce::String& parameterID, float newValue
     {
         // Convert choice index to FFT size (handled in PluginProcessor::parameterChanged)
         // This is redundant but ensures UI thread safety
-        const int sizes[] = { 1024, 2048, 4096, 8192 };
+        const int sizes[] = { 1024, 2048, 4096, 8192, 16384, 32768, 65536 };
         const int index = juce::roundToInt (newValue);
-        if (index >= 0 && index < 4)
+        if (index >= 0 && index < static_cast<int> (std::size (sizes)))
             audioProcessor.getAnalyzerEngine().setFftSize (sizes[index]);
     }
     else if (parameterID == "Averaging")
@@ -314,6 +332,14 @@ void MainView::parameterChanged (const juce::String& parameterID, float newValue
             stereoScopeView_.setHoldEnabled (hold);
         });
     }
+    else if (parameterID == "analyzerShowSpectrogram")
+    {
+        const bool show = newValue > 0.5f;
+        juce::MessageManager::callAsync ([this, show]
+        {
+            setSpectrogramVisible (show);
+        });
+    }
     else if (parameterID == "HoldPeaks")
     {
         audioProcessor.getAnalyzerEngine().setHold (newValue > 0.5f);
@@ -375,6 +401,26 @@ bool MainView::keyPressed (const juce::KeyPress& key, juce::Component* originati
     }
 #endif
 
+    // Stage profiler overlay (profiling only runs while it is shown)
+    const juce::KeyPress pLower { 'p', juce::ModifierKeys{}, 0 };
+    const juce::KeyPress pUpper { 'P', juce::ModifierKeys{}, 0 };
+    if (key == pLower || key == pUpper)
+    {
+        profilerOverlay_.setVisible (! profilerOverlay_.isVisible());
+        profilerOverlay_.toFront (false);
+        return true;
+    }
+
+    // Per-channel spectra of multichannel buses (channels are only analysed while shown)
+    const juce::KeyPress cLower { 'c', juce::ModifierKeys{}, 0 };
+    const juce::KeyPress cUpper { 'C', juce::ModifierKeys{}, 0 };
+    if (key == cLower || key == cUpper)
+    {
+        channelSpectraView_.setVisible (! channelSpectraView_.isVisible());
+        profilerOverlay_.toFront (false);
+        return true;
+    }
+
     const juce::KeyPress dLower { 'd', juce::ModifierKeys{}, 0 };
     const juce::KeyPress dUpper { 'D', juce::ModifierKeys{}, 0 };
     if (key == dLower || key == dUpper)
@@ -411,6 +457,15 @@ void MainView::triggerResetPeaks()
     analyzerView_.repaint();
 }
 
+void MainView::setSpectrogramVisible (bool shouldBeVisible)
+{
+    if (spectrogramView_.isVisible() == shouldBeVisible)
+        return;
+    
+    spectrogramView_.setVisible (shouldBeVisible);
+    resized();
+}
+
 void MainView::paint (juce::Graphics& g)
 {
     // Background from shared theme (variant-aware)
@@ -535,10 +590,24 @@ void MainView::resized()
     stereoScopeView_.setBounds (stereoArea);
     loudnessPanel_.setBounds (bottomArea); // Right side
 
+    // Spectrogram (when shown) takes the lower 40% of the analyzer area
+    if (spectrogramView_.isVisible())
+    {
+        auto spectrogramArea = mainArea.removeFromBottom (mainArea.getHeight() * 2 / 5);
+        spectrogramArea.removeFromTop (ui_.metrics().gapSmall);
+        spectrogramView_.setBounds (spectrogramArea);
+    }
+
     // Remaining is Analyzer
     debugAnalyzerTop = mainArea;
     debugLeft = mainArea; // Reusing debug rect
     analyzerView_.setBounds (mainArea);
+    channelSpectraView_.setBounds (mainArea);
+    
+    // Profiler overlay floats in the analyzer's top-right corner
+    const auto overlaySize = ProfilerOverlay::getPreferredBounds();
+    profilerOverlay_.setBounds (overlaySize.withPosition (mainArea.getRight() - overlaySize.getWidth() - 8, mainArea.getY() + 8)
+                                           .getIntersection (mainArea));
 }
 
 void MainView::setTooltipManager (mdsp_ui::TooltipManager* manager)
@@ -575,6 +644,8 @@ void MainView::auditApvtsParameters()
     std::set<juce::String> apvtsParams;
     apvtsParams.insert ("Mode");
     apvtsParams.insert ("FftSize");
+    apvtsParams.insert ("FftOverlap");
+    apvtsParams.insert ("AnalysisBandwidth");
     apvtsParams.insert ("Averaging");
     apvtsParams.insert ("PeakHold");
     apvtsParams.insert ("Hold");
@@ -591,6 +662,11 @@ void MainView::auditApvtsParameters()
     apvtsParams.insert ("analyzerShowSide");
     apvtsParams.insert ("analyzerShowRMS");
     apvtsParams.insert ("analyzerShowRMS");
+    apvtsParams.insert ("analyzerMultiRes");
+    apvtsParams.insert ("analyzerFilterBank");
+    apvtsParams.insert ("analyzerBandResolution");
+    apvtsParams.insert ("analyzerShowSpectrogram");
+    apvtsParams.insert ("analyzerShowLTAS");
     apvtsParams.insert ("analyzerWeighting");
     apvtsParams.insert ("scopeChannelMode");
     apvtsParams.insert ("meterChannelMode");
@@ -14,6 +14,9 @@
 #include "layout/FooterBar.h"
 #include "analyzer/AnalyzerDisplayView.h"
 #include "analyzer/StereoScopeView.h"
+#include "analyzer/SpectrogramView.h"
+#include "analyzer/ProfilerOverlay.h"
+#include "analyzer/ChannelSpectraView.h"
 #include "meters/MeterGroupComponent.h"
 #include "loudness/LoudnessNumericPanel.h"
 #include <memory>
@@ -63,6 +66,7 @@ public:
 
 private:
     void triggerResetPeaks();
+    void setSpectrogramVisible (bool shouldBeVisible);
 
     bool isShutdown = false;
     AnalayzerProAudioProcessor& audioProcessor;
@@ -76,6 +80,9 @@ private:
     FooterBar footer_;
     AnalyzerDisplayView analyzerView_;
     StereoScopeView stereoScopeView_;
+    SpectrogramView spectrogramView_;   // Shares the analyzer area when shown
+    ProfilerOverlay profilerOverlay_;   // Diagnostics, hidden by default
+    ChannelSpectraView channelSpectraView_; // Multichannel buses, covers the analyzer area when shown
     LoudnessNumericPanel loudnessPanel_; // New Loudness Panel
     MeterGroupComponent outputMeters_;
     MeterGroupComponent inputMeters_;
@@ -1,4 +1,7 @@
 #include "AnalyzerDisplayView.h"
+#include "../../analyzer/FilterBankAnalyzer.h"
+#include "../../analyzer/SpectrumResampler.h"
+#include "../../dsp/simd/SpectrumKernels.h"
 #include <mdsp_ui/Theme.h>
 #include <cmath>
 #include <limits>
@@ -53,6 +56,13 @@ AnalyzerDisplayView::AnalyzerDisplayView (AnalayzerProAudioProcessor& processor)
     // Initialize band centers
     bandCentersHz_ = generateThirdOctaveBands();
     
+    logCentresHz_.resize (static_cast<size_t> (SpectrumResampler::kNumLogPoints));
+    for (int i = 0; i < SpectrumResampler::kNumLogPoints; ++i)
+        logCentresHz_[static_cast<size_t> (i)] = static_cast<float> (SpectrumResampler::getLogPointFrequency (i));
+    
+    const auto& ltasBandCentres = SpectrumResampler::getBandCentresHz();
+    ltasBandCentresHz_.assign (ltasBandCentres.begin(), ltasBandCentres.end());
+    
     // Sync initial mode to RTADisplay (currentMode_ defaults to FFT)
     rtaDisplay.setViewMode (toRtaMode (currentMode_));
 #if JUCE_DEBUG
@@ -65,6 +75,9 @@ AnalyzerDisplayView::AnalyzerDisplayView (AnalayzerProAudioProcessor& processor)
     updateModeOverlayText();
 #endif
     
+    // The engine only computes snapshots while a view consumes them
+    audioProcessor.getAnalyzerEngine().addConsumer (AnalyzerEngine::Product::Spectrum);
+    
     // Start timer for snapshot updates (~60 Hz) and dB range animation
     startTimerHz (60);
     
@@ -146,6 +159,7 @@ void AnalyzerDisplayView::shutdown()
     isShutdown = true;
 
     stopTimer();          // CRITICAL
+    audioProcessor.getAnalyzerEngine().removeConsumer (AnalyzerEngine::Product::Spectrum);
     //cancelPendingUpdate(); // if AsyncUpdater ever used later
 
     // Shutdown complete
@@ -344,23 +358,21 @@ void AnalyzerDisplayView::resized()
 std::vector<float> AnalyzerDisplayView::generateThirdOctaveBands()
 {
     // Standard 1/3-octave band centers from ~20 Hz to ~20 kHz (31 bands)
-    // ISO 266:1997 standard frequencies
-    std::vector<float> centers;
-    centers.reserve (31);
-    
-    // 1/3-octave centers: f = 1000 * 10^(n/10) where n ranges from -20 to +10
-    // Filter to 20 Hz - 20 kHz range
-    const float bandCenters[] = {
-        20.0f, 25.0f, 31.5f, 40.0f, 50.0f, 63.0f, 80.0f, 100.0f, 125.0f, 160.0f,
-        200.0f, 250.0f, 315.0f, 400.0f, 500.0f, 630.0f, 800.0f, 1000.0f, 1250.0f, 1600.0f,
-        2000.0f, 2500.0f, 3150.0f, 4000.0f, 5000.0f, 6300.0f, 8000.0f, 10000.0f, 12500.0f, 16000.0f, 20000.0f
-    };
+    // ISO 266:1997 standard frequencies - shared with the engine's band resampler so the
+    // published BandsDb series always lines up with the drawn bands
+    const auto& bandCenters = SpectrumResampler::getBandCentresHz();
+    return std::vector<float> (bandCenters.begin(), bandCenters.end());
+}
+
+std::vector<float> AnalyzerDisplayView::generateBandCenters (int bandsPerOctave)
+{
+    if (bandsPerOctave == 3)
+        return generateThirdOctaveBands();
     
-    for (float center : bandCenters)
-    {
-        if (center >= 20.0f && center <= 20000.0f)
-            centers.push_back (center);
-    }
+    // Other resolutions only come from the filter-bank RTA: use its exact base-10 centres
+    std::vector<float> centers (static_cast<size_t> (FilterBankAnalyzer::getNumBands (bandsPerOctave)));
+    for (size_t i = 0; i < centers.size(); ++i)
+        centers[i] = static_cast<float> (FilterBankAnalyzer::getBandCentreHz (bandsPerOctave, static_cast<int> (i)));
     
     return centers;
 }
@@ -380,12 +392,21 @@ void AnalyzerDisplayView::convertFFTToBands (const AnalyzerSnapshot& snapshot, s
     
     const double sampleRate = snapshot.sampleRate;
     const int fftSize = snapshot.fftSize;
-    const int fftBinCount = (snapshot.fftBinCount > 0) ? snapshot.fftBinCount : snapshot.numBins;
+    const int fftBinCount = juce::jmin ((snapshot.fftBinCount > 0) ? snapshot.fftBinCount : snapshot.numBins,
+                                        snapshot.getTraceLength (AnalyzerSnapshot::Trace::FftDb));
+    const float* fftDb = snapshot.getTrace (AnalyzerSnapshot::Trace::FftDb);
+    if (fftDb == nullptr || fftBinCount <= 0)
+        return;
     const double binWidthHz = sampleRate / static_cast<double> (fftSize);
     
+    // dB -> linear power once per bin (vectorised) instead of a pow() per bin per band
+    fftPowerScratch_.resize (static_cast<size_t> (fftBinCount));
+    AnalyzerPro::dsp::SpectrumKernels::dbToPower (fftDb, fftPowerScratch_.data(), fftBinCount);
+    const float* fftPower = fftPowerScratch_.data();
+    
     // For each band, compute lower and upper frequency edges
     // 1/3-octave: lower = center / 10^(1/6), upper = center * 10^(1/6)
-    const double thirdOctaveRatio = std::pow (10.0, 1.0 / 6.0);  // ~1.122462
+    const double thirdOctaveRatio = std::pow (2.0, 1.0 / 6.0);  // ~1.122462 (half a third-octave)
     
     for (size_t bandIdx = 0; bandIdx < numBands; ++bandIdx)
     {
@@ -416,11 +437,9 @@ void AnalyzerDisplayView::convertFFTToBands (const AnalyzerSnapshot& snapshot, s
         
         for (int bin = lowerBin; bin <= upperBin; ++bin)
         {
-            // Convert dB to linear power for averaging
+            // Linear power for averaging
             const std::size_t idx = static_cast<std::size_t> (bin);
-            const float db = snapshot.fftDb[idx];
-            const float power = std::pow (10.0f, db / 10.0f);
-            sumPower += power;
+            sumPower += fftPower[idx];
             binCount++;
             
             // For peak: use maximum (not sum) - more stable and correct
@@ -459,9 +478,18 @@ void AnalyzerDisplayView::convertFFTToLog (const AnalyzerSnapshot& snapshot, std
     
     const double sampleRate = snapshot.sampleRate;
     const int fftSize = snapshot.fftSize;
-    const int fftBinCount = (snapshot.fftBinCount > 0) ? snapshot.fftBinCount : snapshot.numBins;
+    const int fftBinCount = juce::jmin ((snapshot.fftBinCount > 0) ? snapshot.fftBinCount : snapshot.numBins,
+                                        snapshot.getTraceLength (AnalyzerSnapshot::Trace::FftDb));
+    const float* fftDb = snapshot.getTrace (AnalyzerSnapshot::Trace::FftDb);
+    if (fftDb == nullptr || fftBinCount <= 0)
+        return;
     const double binWidthHz = sampleRate / static_cast<double> (fftSize);
     
+    // dB -> linear power once per bin (vectorised) instead of a pow() per bin per band
+    fftPowerScratch_.resize (static_cast<size_t> (fftBinCount));
+    AnalyzerPro::dsp::SpectrumKernels::dbToPower (fftDb, fftPowerScratch_.data(), fftBinCount);
+    const float* fftPower = fftPowerScratch_.data();
+    
     const double logMin = std::log10 (static_cast<double> (minFreq));
     const double logMax = std::log10 (static_cast<double> (maxFreq));
     const double logRange = logMax - logMin;
@@ -506,9 +534,7 @@ void AnalyzerDisplayView::convertFFTToLog (const AnalyzerSnapshot& snapshot, std
         for (int bin = lowerBin; bin <= upperBin; ++bin)
         {
             const std::size_t idx = static_cast<std::size_t> (bin);
-            const float db = snapshot.fftDb[idx];
-            const float power = std::pow (10.0f, db / 10.0f);
-            sumPower += power;
+            sumPower += fftPower[idx];
             binCount++;
         }
         
@@ -768,38 +794,36 @@ void AnalyzerDisplayView::timerCallback()
     if (minDbAnim_.isSmoothing())
         repaint();
 
-    // Apply any pending FFT resize on the message thread (RT-safe: allocations happen here, not on audio thread).
-    audioProcessor.getAnalyzerEngine().applyPendingFftSizeIfNeeded();
+    // Pull latest snapshot from analyzer engine (UI thread, read in place from the triple buffer)
+    const AnalyzerSnapshot* snapshot = audioProcessor.getAnalyzerEngine().acquireLatestSnapshot();
     
-    // Pull latest snapshot from analyzer engine (UI thread, reuse member snapshot)
-    const bool gotSnapshot = audioProcessor.getAnalyzerEngine().getLatestSnapshot (snapshot_);
-    
-    if (!gotSnapshot)
+    if (snapshot == nullptr)
     {
-        // No new snapshot - hold last valid frame (do not touch RTADisplay)
+        // No snapshot yet - hold last valid frame (do not touch RTADisplay)
         return;
     }
     
     // CRITICAL: Only update if snapshot is valid AND has bins (prevents blinking to floor)
     // Gate explicitly on isValid && fftBinCount > 0 to ensure smooth updates
-    const int fftBinCount = (snapshot_.fftBinCount > 0) ? snapshot_.fftBinCount : snapshot_.numBins;
-    if (!snapshot_.isValid || fftBinCount <= 0)
+    const int fftBinCount = (snapshot->fftBinCount > 0) ? snapshot->fftBinCount : snapshot->numBins;
+    if (!snapshot->isValid || fftBinCount <= 0)
     {
         // Invalid snapshot - hold last valid frame (do not touch RTADisplay)
         return;
     }
     
-    // Valid snapshot - store as last valid and update display
-    // getLatestSnapshot() already handles torn reads with retry loop, so we update every valid snapshot
-        lastValidSnapshot_ = snapshot_;
-        hasLastValid_ = true;
-            updateFromSnapshot (snapshot_);
+    // Valid snapshot - update display (RTADisplay keeps the last frame, no snapshot copy needed)
+    // The triple buffer never hands out a slot that is being written, so there are no torn reads
+    hasLastValid_ = true;
+    updateFromSnapshot (*snapshot);
 }
 
 void AnalyzerDisplayView::updateFromSnapshot (const AnalyzerSnapshot& snapshot)
 {
+    using Trace = AnalyzerSnapshot::Trace;
+    
     const int fftBinCount = (snapshot.fftBinCount > 0) ? snapshot.fftBinCount : snapshot.numBins;
-    if (!snapshot.isValid || fftBinCount <= 0)
+    if (!snapshot.isValid || fftBinCount <= 0 || snapshot.getTraceLength (Trace::FftDb) != fftBinCount)
         return;
     
     // CRITICAL: Synchronize RTADisplay mode BEFORE any data feeding
@@ -823,6 +847,9 @@ void AnalyzerDisplayView::updateFromSnapshot (const AnalyzerSnapshot& snapshot)
     
     // Update Hold Status
     isHoldOn_ = snapshot.isHoldOn;
+    
+    // LTAS overlay is mode independent (it only picks its grid from the mode)
+    updateLtasOverlay (snapshot);
     // rtaDisplay.setHoldStatus (isHoldOn_);
     
     // Route data STRICTLY by mode (FFT data only sent in FFT mode)
@@ -861,15 +888,17 @@ void AnalyzerDisplayView::updateFromSnapshot (const AnalyzerSnapshot& snapshot)
     fftDb_.resize (validBinsSize);
     fftPeakDb_.resize (validBinsSize);
     
-    // Copy from snapshot arrays into member vectors
-    std::copy (snapshot.fftDb.begin(), snapshot.fftDb.begin() + validBins, fftDb_.begin());
+    // Copy from snapshot traces into member vectors
+    const float* snapshotDb = snapshot.getTrace (Trace::FftDb);
+    std::copy (snapshotDb, snapshotDb + validBins, fftDb_.begin());
     
     // Copy peak bins: validate size matches expected bins; if mismatch ignore peaks
     bool usePeaks = false;
-    if (snapshot.fftPeakDb.size() >= static_cast<size_t> (validBins))
+    if (snapshot.getTraceLength (Trace::FftPeakDb) == validBins)
     {
         // Peak bins must match fftDb size (same bin count)
-        std::copy (snapshot.fftPeakDb.begin(), snapshot.fftPeakDb.begin() + validBins, fftPeakDb_.begin());
+        const float* snapshotPeakDb = snapshot.getTrace (Trace::FftPeakDb);
+        std::copy (snapshotPeakDb, snapshotPeakDb + validBins, fftPeakDb_.begin());
         usePeaks = true;
     }
     else
@@ -1031,7 +1060,12 @@ void AnalyzerDisplayView::updateFromSnapshot (const AnalyzerSnapshot& snapshot)
     applyBallistics (fftDb_.data(), rmsState_, validBinsSize, releaseMs_);
     
     // Multi-Trace Processing (moved here to share weighting table)
-    if (snapshot.multiTraceEnabled)
+    const bool hasMultiTrace = snapshot.multiTraceEnabled
+                               && snapshot.getTraceLength (Trace::PowerL) == validBins
+                               && snapshot.getTraceLength (Trace::PowerR) == validBins
+                               && snapshot.getTraceLength (Trace::PowerMid) == validBins
+                               && snapshot.getTraceLength (Trace::PowerSide) == validBins;
+    if (hasMultiTrace)
     {
         // Resize scratch buffers
         const size_t validBinsSz = static_cast<size_t> (validBins);
@@ -1041,22 +1075,18 @@ void AnalyzerDisplayView::updateFromSnapshot (const AnalyzerSnapshot& snapshot)
         if (scratchPowerSide_.size() != validBinsSz) scratchPowerSide_.resize (validBinsSz);
         if (scratchPowerMono_.size() != validBinsSz) scratchPowerMono_.resize (validBinsSz);
         
-        // Copy Raw first
-        if (snapshot.powerL.size() >= validBinsSz)
-            std::copy (snapshot.powerL.begin(), snapshot.powerL.begin() + validBins, scratchPowerL_.begin());
-        if (snapshot.powerR.size() >= validBinsSz)
-            std::copy (snapshot.powerR.begin(), snapshot.powerR.begin() + validBins, scratchPowerR_.begin());
+        // Copy Raw first (Mid/Side are phase-correct spectra derived from the engine's complex bins)
+        std::copy_n (snapshot.getTrace (Trace::PowerL), validBins, scratchPowerL_.begin());
+        std::copy_n (snapshot.getTrace (Trace::PowerR), validBins, scratchPowerR_.begin());
+        std::copy_n (snapshot.getTrace (Trace::PowerMid), validBins, scratchPowerMid_.begin());
+        std::copy_n (snapshot.getTrace (Trace::PowerSide), validBins, scratchPowerSide_.begin());
             
-        // Apply Weighting to L/R (Additive if dB, but treating as additive to linear power currently?)
+        // Apply Weighting to L/R/Mid/Side (Additive if dB, but treating as additive to linear power currently?)
         // CONFIRMED: snapshot.powerL is LINEAR POWER.
         // CONFIRMED: cachedWeightingTable_ is likely dB (getAWeightingDb returns dB).
         // ISSUE: Adding dB to Linear Power is physically wrong. 
-        // FIX: Convert weighting to linear before adding? Or assume weighting is small/handled elsewhere?
-        // Since we are not changing Weighting logic in this task (focus is Ballistics), we keep existing behavior
-        // BUT we must replicate it for derived traces logic to match.
-        // Actually, if we smooth L/R, we should probably apply weighting AFTER conversion to dB?
-        // Existing code applied it BEFORE ballistics/smoothing.
-        // Let's stick to existing pattern: Apply weighting to L/R scratch buffers.
+        // Since we are not changing Weighting logic here, we keep existing behavior
+        // and apply it identically to every multi-trace series so they stay comparable.
         
         if (!cachedWeightingTable_.empty() && cachedWeightingTable_.size() == validBinsSz)
         {
@@ -1065,40 +1095,25 @@ void AnalyzerDisplayView::updateFromSnapshot (const AnalyzerSnapshot& snapshot)
                  // NOTE: This looks suspicious (adding dB to linear), but preserving existing logic.
                  scratchPowerL_[i] += cachedWeightingTable_[i];
                  scratchPowerR_[i] += cachedWeightingTable_[i];
+                 scratchPowerMid_[i] += cachedWeightingTable_[i];
+                 scratchPowerSide_[i] += cachedWeightingTable_[i];
              }
         }
         
-        // Apply Spectral Smoothing (Fractional Octave) to L/R
-        std::vector<float> smoothedL (validBinsSz), smoothedR (validBinsSz);
-        
+        // Apply Spectral Smoothing (Fractional Octave) to each series (in place)
         smoother_.setConfig (smoothingOctaves_, snapshot.fftSize);
-        smoother_.process (scratchPowerL_.data(), smoothedL.data(), validBins);
-        smoother_.process (scratchPowerR_.data(), smoothedR.data(), validBins);
+        smoother_.process (scratchPowerL_.data(), scratchPowerL_.data(), validBins);
+        smoother_.process (scratchPowerR_.data(), scratchPowerR_.data(), validBins);
+        smoother_.process (scratchPowerMid_.data(), scratchPowerMid_.data(), validBins);
+        smoother_.process (scratchPowerSide_.data(), scratchPowerSide_.data(), validBins);
         
-        // Now compute Derived Traces (Mid/Side/Mono) from SMOOTHED Linear L/R
-        // This ensures derived traces benefit from spectral smoothing before ballistics
-        constexpr float kMinPower = 1.0e-20f;
-        
-        for (size_t i = 0; i < validBinsSz; ++i)
+        // Convert everything to dB for Ballistics (one vectorised pass, power floor 1e-20 = -200 dB)
         {
-            const float pL = std::max (smoothedL[i], kMinPower);
-            const float pR = std::max (smoothedR[i], kMinPower);
-            
-            const float magL = std::sqrt (pL);
-            const float magR = std::sqrt (pR);
-            
-            // Mid/Mono = 0.5 * (L+R) (Magnitude)
-            const float magMid = 0.5f * (magL + magR);
-            // Side = 0.5 * |L-R| (Magnitude)
-            const float magSide = 0.5f * std::abs (magL - magR);
-            
-            // Convert everything to dB for Ballistics
-            scratchPowerL_[i] = 10.0f * std::log10(pL);
-            scratchPowerR_[i] = 10.0f * std::log10(pR);
-            scratchPowerMid_[i] = 10.0f * std::log10(std::max(magMid * magMid, kMinPower));
-            scratchPowerMono_[i] = scratchPowerMid_[i]; // Mono same as Mid here
-            scratchPowerSide_[i] = 10.0f * std::log10(std::max(magSide * magSide, kMinPower));
+            const float* powers[] = { scratchPowerL_.data(), scratchPowerR_.data(), scratchPowerMid_.data(), scratchPowerSide_.data() };
+            float* dbs[] = { scratchPowerL_.data(), scratchPowerR_.data(), scratchPowerMid_.data(), scratchPowerSide_.data() };
+            AnalyzerPro::dsp::SpectrumKernels::powerToDb (powers, dbs, 4, validBins, -200.0f);
         }
+        std::copy (scratchPowerMid_.begin(), scratchPowerMid_.end(), scratchPowerMono_.begin()); // Mono same as Mid
         
         // Apply Ballistics (dB Domain) to ALL traces using unified Release Time
         applyBallistics (scratchPowerL_.data(), powerLState_, validBinsSz, releaseMs_);
@@ -1153,9 +1168,10 @@ void AnalyzerDisplayView::updateFromSnapshot (const AnalyzerSnapshot& snapshot)
             bool usePeakHold = false;
             fftPeakHoldDb_.resize (validBinsSize);
             
-            if (snapshot.fftPeakHoldDb.size() >= static_cast<size_t> (validBins))
+            if (snapshot.getTraceLength (Trace::FftPeakHoldDb) == validBins)
             {
-                std::copy (snapshot.fftPeakHoldDb.begin(), snapshot.fftPeakHoldDb.begin() + validBins, fftPeakHoldDb_.begin());
+                const float* snapshotPeakHoldDb = snapshot.getTrace (Trace::FftPeakHoldDb);
+                std::copy (snapshotPeakHoldDb, snapshotPeakHoldDb + validBins, fftPeakHoldDb_.begin());
                 usePeakHold = true;
             }
             else
@@ -1173,7 +1189,7 @@ void AnalyzerDisplayView::updateFromSnapshot (const AnalyzerSnapshot& snapshot)
             
             // Multi-trace: Feed L/R/Mid/Side/Mono power data if available
             // Logic moved to Step 1b to unify weighting application and ballistics
-            if (snapshot.multiTraceEnabled)
+            if (hasMultiTrace)
             {
                  rtaDisplay.setMultiTraceData (scratchPowerL_.data(), scratchPowerR_.data(),
                                                scratchPowerMid_.data(), scratchPowerSide_.data(), scratchPowerMono_.data(),
@@ -1190,24 +1206,29 @@ void AnalyzerDisplayView::updateFromSnapshot (const AnalyzerSnapshot& snapshot)
         
         case Mode::BAND:
         {
-            // BANDS mode: Convert FFT bins to 1/3-octave bands
+            // BANDS mode: engine bands (FFT resampler or filter bank), else convert FFT bins to 1/3-octave bands
             if (fftBinCount <= 0 || snapshot.fftSize <= 0 || snapshot.sampleRate <= 0.0)
             {
                 rtaDisplay.setNoData ("Invalid snapshot for BANDS");
                 break;
             }
             
-            // Initialize band centers if needed (band centers are independent of FFT size)
-            if (bandCentersHz_.empty())
+            // Band centers follow the frame's grid (filter-bank resolution); the FFT fallback is always 1/3 octave.
+            // Independent of FFT size and sample rate, so they only change with the resolution.
+            const int bandsPerOctave = snapshot.hasTrace (AnalyzerSnapshot::Trace::BandsDb) ? snapshot.bandsPerOctave : 3;
+            if (bandCentersHz_.empty() || bandsPerOctave != bandCentersBandsPerOctave_)
             {
-                bandCentersHz_ = generateThirdOctaveBands();
+                bandCentersHz_ = generateBandCenters (bandsPerOctave);
+                bandCentersBandsPerOctave_ = bandsPerOctave;
             }
             
             // CRITICAL: Always set band centers before setting band data (ensures size matching)
             rtaDisplay.setBandCenters (bandCentersHz_);
             
-            // Convert FFT bins to bands
-            convertFFTToBands (snapshot, bandsDb_, bandsPeakDb_);
+            // Engine-resampled bands when published, otherwise convert FFT bins to bands
+            if (! applyEngineSeries (snapshot, AnalyzerSnapshot::Trace::BandsDb, AnalyzerSnapshot::Trace::BandsPeakDb,
+                                     bandCentersHz_, bandsSeriesState_, bandsDb_, bandsPeakDb_))
+                convertFFTToBands (snapshot, bandsDb_, bandsPeakDb_);
             
             // CRITICAL: Ensure sizes match exactly (bandCentersHz.size() == bandsDb.size() == bandsPeakDb.size())
             jassert (bandCentersHz_.size() == bandsDb_.size());
@@ -1273,8 +1294,14 @@ void AnalyzerDisplayView::updateFromSnapshot (const AnalyzerSnapshot& snapshot)
                 break;
             }
             
-            // Convert FFT bins to log-spaced bins
-            convertFFTToLog (snapshot, logDb_, logPeakDb_);
+            // Engine-published LOG points (same 20 Hz - 20 kHz grid): multi-resolution spectrum if
+            // active, else the resampled FFT; convert FFT bins to log-spaced bins only as a fallback
+            using Trace = AnalyzerSnapshot::Trace;
+            if (! applyEngineSeries (snapshot, Trace::MultiResDb, Trace::MultiResPeakDb, logCentresHz_, logSeriesState_, logDb_, logPeakDb_)
+                && ! applyEngineSeries (snapshot, Trace::LogDb, Trace::LogPeakDb, logCentresHz_, logSeriesState_, logDb_, logPeakDb_))
+            {
+                convertFFTToLog (snapshot, logDb_, logPeakDb_);
+            }
             
             // Feed RTADisplay with LOG data
             const bool useLogPeaks = !logPeakDb_.empty() && logPeakDb_.size() == logDb_.size();
@@ -1388,6 +1415,89 @@ void AnalyzerDisplayView::applyBallistics (float* data, std::vector<float>& stat
     }
 }
 
+void AnalyzerDisplayView::updateLtasOverlay (const AnalyzerSnapshot& snapshot)
+{
+    using Trace = AnalyzerSnapshot::Trace;
+    
+    const bool bands = (currentMode_ == Mode::BAND);
+    const Trace trace = bands ? Trace::LtasBandsDb : Trace::LtasLogDb;
+    const std::vector<float>& centresHz = bands ? ltasBandCentresHz_ : logCentresHz_;
+    
+    const float* src = snapshot.getTrace (trace);
+    if (src == nullptr || snapshot.getTraceLength (trace) != static_cast<int> (centresHz.size()))
+    {
+        ltasDb_.clear();
+        rtaDisplay.setLtasData (centresHz, ltasDb_, 0.0);
+        return;
+    }
+    
+    ltasDb_.assign (src, src + centresHz.size());
+    rtaDisplay.setLtasData (centresHz, ltasDb_, snapshot.ltasDurationSec);
+}
+
+bool AnalyzerDisplayView::applyEngineSeries (const AnalyzerSnapshot& snapshot,
+                                             AnalyzerSnapshot::Trace rmsTrace, AnalyzerSnapshot::Trace peakTrace,
+                                             const std::vector<float>& centresHz, EngineSeriesState& state,
+                                             std::vector<float>& outDb, std::vector<float>& outPeakDb)
+{
+    const int n = snapshot.getTraceLength (rmsTrace);
+    if (n <= 0 || n != static_cast<int> (centresHz.size()) || snapshot.getTraceLength (peakTrace) != n)
+        return false;
+    
+    const size_t count = static_cast<size_t> (n);
+    const float* rmsDb = snapshot.getTrace (rmsTrace);
+    const float* peakDb = snapshot.getTrace (peakTrace);
+    outDb.assign (rmsDb, rmsDb + n);
+    outPeakDb.assign (peakDb, peakDb + n);
+    
+    // Hold latch on the raw peaks (same order as the per-bin path: latch, then weighting)
+    const bool holdOn = snapshot.isHoldOn;
+    if (state.heldPeak.size() != count)
+        state.heldPeak.assign (count, -120.0f);
+    
+    for (size_t i = 0; i < count; ++i)
+    {
+        float incomingDb = sanitizeDb (outPeakDb[i]);
+        if (holdOn)
+            incomingDb = juce::jmax (state.heldPeak[i], incomingDb);
+        state.heldPeak[i] = incomingDb;
+        outPeakDb[i] = incomingDb;
+    }
+    
+    // Weighting at the point centres (cheap: n points instead of every bin), rebuilt on mode change
+    if (state.weightingMode != currentWeightingMode_ || state.weightingDb.size() != count)
+    {
+        state.weightingMode = currentWeightingMode_;
+        state.weightingDb.assign (count, 0.0f);
+        
+        for (size_t i = 0; i < count; ++i)
+        {
+            const float freq = juce::jmax (1.0f, centresHz[i]);
+            if (currentWeightingMode_ == 1)
+                state.weightingDb[i] = getAWeightingDb (freq);
+            else if (currentWeightingMode_ == 2)
+                state.weightingDb[i] = getBS468WeightingDb (freq);
+        }
+    }
+    
+    if (currentWeightingMode_ != 0)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            outDb[i] += state.weightingDb[i];
+            outPeakDb[i] += state.weightingDb[i];
+        }
+    }
+    
+    for (auto& v : outPeakDb) v = sanitizeDb (v);
+    
+    // UI RMS ballistics (same time constants as the per-bin trace)
+    applyBallistics (outDb.data(), state.rmsState, count, releaseMs_);
+    for (auto& v : outDb) v = sanitizeDb (v);
+    
+    return true;
+}
+
 //==============================================================================
 // SmoothingProcessor Implementation
 //==============================================================================
@@ -80,6 +80,8 @@ public:
     void shutdown();
 
 private:
+    friend struct AnalyzerBenchAccess; // tools/bench times the private hot paths directly
+
     void timerCallback() override;
     void updateFromSnapshot (const AnalyzerSnapshot& snapshot);
     
@@ -89,9 +91,30 @@ private:
     // Convert FFT bins to log-spaced bins
     void convertFFTToLog (const AnalyzerSnapshot& snapshot, std::vector<float>& logDb, std::vector<float>& logPeakDb);
     
+    // Engine-published series (Bands / Log / Multi-Res): per-point weighting, hold latch and UI
+    // ballistics, matching what the per-bin pipeline applies before convertFFTToBands/Log.
+    struct EngineSeriesState
+    {
+        std::vector<float> weightingDb;  // Weighting offsets at the point centres
+        int weightingMode = -1;
+        std::vector<float> rmsState;     // UI ballistics
+        std::vector<float> heldPeak;     // UI hold latch
+    };
+    
+    // Returns false (outputs untouched) if the snapshot does not carry a matching series
+    bool applyEngineSeries (const AnalyzerSnapshot& snapshot, AnalyzerSnapshot::Trace rmsTrace, AnalyzerSnapshot::Trace peakTrace,
+                            const std::vector<float>& centresHz, EngineSeriesState& state,
+                            std::vector<float>& outDb, std::vector<float>& outPeakDb);
+    
+    // LTAS overlay: LtasBandsDb in BANDS mode, LtasLogDb otherwise; cleared when the frame has none
+    void updateLtasOverlay (const AnalyzerSnapshot& snapshot);
+    
     // Generate standard 1/3-octave band centers (20 Hz to 20 kHz)
     static std::vector<float> generateThirdOctaveBands();
     
+    // Band centers for a 1/bandsPerOctave grid (1/3 keeps the nominal ISO labels above)
+    static std::vector<float> generateBandCenters (int bandsPerOctave);
+    
     // Map AnalyzerDisplayView::Mode to RTADisplay view mode (0=FFT, 1=LOG, 2=BAND)
     static int toRtaMode (Mode m) noexcept;
     
@@ -128,8 +151,6 @@ private:
     double peakFlashUntilMs_ = 0.0;
     // uint32_t lastSequence_ = 0;  // Unused
     // uint32_t lastSequence_ = 0;  // Unused
-    AnalyzerSnapshot snapshot_;
-    AnalyzerSnapshot lastValidSnapshot_;  // Hold last valid frame for grace period
     bool hasLastValid_ = false;
     bool isHoldOn_ = false;
     std::vector<float> fftDb_;
@@ -151,11 +172,18 @@ private:
     std::vector<float> scratchPowerMid_;
     std::vector<float> scratchPowerSide_;
     std::vector<float> scratchPowerMono_;
+    std::vector<float> fftPowerScratch_;  // FFT dB -> linear power, converted once per frame for BANDS/LOG
 
     float releaseMs_ = 300.0f; // Parameter cache
     
     bool uiHoldActive_ = false;     // Track hold state transitions
-    std::vector<float> bandCentersHz_;  // Cached 1/3-octave band centers
+    std::vector<float> bandCentersHz_;  // Cached band centers (grid of the last BANDS frame)
+    int bandCentersBandsPerOctave_ = 3;
+    std::vector<float> logCentresHz_;   // LOG grid (SpectrumResampler::kNumLogPoints, 20 Hz - 20 kHz)
+    std::vector<float> ltasBandCentresHz_;  // SpectrumResampler 1/3-octave grid (LtasBandsDb)
+    std::vector<float> ltasDb_;
+    EngineSeriesState bandsSeriesState_;
+    EngineSeriesState logSeriesState_;
     float lastPeakDb_ = -1000.0f;
     float lastMinDb_ = 0.0f;
     float lastMaxDb_ = 0.0f;
@@ -0,0 +1,186 @@
+#include "ChannelSpectraView.h"
+#include "../../PluginProcessor.h"
+#include <cmath>
+
+ChannelSpectraView::ChannelSpectraView (mdsp_ui::UiContext& ui, AnalayzerProAudioProcessor& processor)
+    : ui_ (ui), processor_ (processor), analyzer_ (processor.getAnalyzerEngine().getMultichannelAnalyzer())
+{
+    for (auto& trace : traces_)
+        trace.fill (kDisplayFloorDb);
+
+    setOpaque (true);
+}
+
+ChannelSpectraView::~ChannelSpectraView()
+{
+    stopTimer();
+    analyzer_.setConsumedSlots (0);
+}
+
+void ChannelSpectraView::visibilityChanged()
+{
+    if (isVisible())
+    {
+        updateLayout();
+        startTimerHz (30);
+    }
+    else
+    {
+        stopTimer();
+        analyzer_.setConsumedSlots (0);
+    }
+}
+
+void ChannelSpectraView::updateLayout()
+{
+    // Channel names from the bus layout (the analyser only knows the count)
+    numChannels_ = analyzer_.getNumChannels();
+    const auto layout = processor_.getChannelLayoutOfBus (true, 0);
+    for (int c = 0; c < numChannels_; ++c)
+    {
+        const auto type = layout.getTypeOfChannel (c);
+        slotNames_[static_cast<std::size_t> (c)] = (type != juce::AudioChannelSet::unknown)
+                                                       ? juce::AudioChannelSet::getAbbreviatedChannelTypeName (type)
+                                                       : juce::String (c + 1);
+    }
+    slotNames_[MultichannelAnalyzer::kSumSlot] = "Sum";
+
+    if (soloSlot_ >= numChannels_ && soloSlot_ != MultichannelAnalyzer::kSumSlot)
+        soloSlot_ = -1;
+
+    numTiles_ = 0;
+    if (numChannels_ > 0)
+    {
+        if (soloSlot_ >= 0)
+        {
+            tileSlots_[0] = soloSlot_;
+            numTiles_ = 1;
+        }
+        else
+        {
+            for (int c = 0; c < numChannels_; ++c)
+                tileSlots_[static_cast<std::size_t> (numTiles_++)] = c;
+            tileSlots_[static_cast<std::size_t> (numTiles_++)] = MultichannelAnalyzer::kSumSlot;
+        }
+    }
+
+    updateConsumedSlots();
+    repaint();
+}
+
+void ChannelSpectraView::updateConsumedSlots()
+{
+    uint32_t mask = 0;
+    for (int t = 0; t < numTiles_; ++t)
+        mask |= 1u << tileSlots_[static_cast<std::size_t> (t)];
+
+    analyzer_.setConsumedSlots (isVisible() ? mask : 0u);
+}
+
+void ChannelSpectraView::timerCallback()
+{
+    // Bus changed under us (re-prepare with another layout)
+    if (analyzer_.getNumChannels() != numChannels_)
+        updateLayout();
+
+    bool changed = false;
+    for (int t = 0; t < numTiles_; ++t)
+    {
+        const int slot = tileSlots_[static_cast<std::size_t> (t)];
+        const auto* frame = analyzer_.acquireLatest (slot);
+        auto& last = lastFrameIndex_[static_cast<std::size_t> (slot)];
+        if (frame == nullptr || frame->frameIndex == last)
+            continue;
+
+        last = frame->frameIndex;
+        traces_[static_cast<std::size_t> (slot)] = frame->logDb;
+        changed = true;
+    }
+
+    if (changed)
+        repaint();
+}
+
+void ChannelSpectraView::mouseUp (const juce::MouseEvent& e)
+{
+    if (soloSlot_ >= 0)
+    {
+        soloSlot_ = -1;
+    }
+    else
+    {
+        for (int t = 0; t < numTiles_; ++t)
+            if (getTileBounds (t, numTiles_).contains (e.getPosition()))
+                soloSlot_ = tileSlots_[static_cast<std::size_t> (t)];
+    }
+
+    updateLayout();
+}
+
+juce::Rectangle<int> ChannelSpectraView::getTileBounds (int tileIndex, int numTiles) const noexcept
+{
+    // Near-square grid: 13 tiles (7.1.4 + sum) -> 5 x 3
+    const auto area = getLocalBounds().reduced (4);
+    const int cols = juce::jmax (1, static_cast<int> (std::ceil (std::sqrt (static_cast<double> (numTiles) * 1.6))));
+    const int rows = juce::jmax (1, (numTiles + cols - 1) / cols);
+    const int w = area.getWidth() / cols;
+    const int h = area.getHeight() / rows;
+
+    return juce::Rectangle<int> (area.getX() + (tileIndex % cols) * w, area.getY() + (tileIndex / cols) * h, w, h).reduced (2);
+}
+
+void ChannelSpectraView::paint (juce::Graphics& g)
+{
+    const auto& theme = ui_.theme();
+    g.fillAll (theme.background);
+    g.setFont (juce::Font (juce::FontOptions().withHeight (11.0f)));
+
+    if (numTiles_ == 0)
+    {
+        g.setColour (theme.textMuted);
+        g.drawText ("Per-channel view needs a bus wider than stereo (up to 7.1.4)", getLocalBounds(),
+                    juce::Justification::centred);
+        return;
+    }
+
+    for (int t = 0; t < numTiles_; ++t)
+    {
+        const int slot = tileSlots_[static_cast<std::size_t> (t)];
+        const auto tile = getTileBounds (t, numTiles_);
+        const auto plot = tile.reduced (4).withTrimmedTop (14).toFloat();
+
+        g.setColour (theme.panel);
+        g.fillRect (tile);
+        g.setColour (theme.borderDivider);
+        g.drawRect (tile);
+
+        // -20 dB grid lines
+        g.setColour (theme.grid);
+        for (float db = kDisplayCeilingDb - 20.0f; db > kDisplayFloorDb; db -= 20.0f)
+        {
+            const float y = juce::jmap (db, kDisplayFloorDb, kDisplayCeilingDb, plot.getBottom(), plot.getY());
+            g.drawHorizontalLine (juce::roundToInt (y), plot.getX(), plot.getRight());
+        }
+
+        g.setColour (theme.text);
+        g.drawText (slotNames_[static_cast<std::size_t> (slot)], tile.reduced (4, 2).removeFromTop (12),
+                    juce::Justification::centredLeft);
+
+        // LOG points are evenly spaced on the log axis: x is linear in the index
+        const auto& trace = traces_[static_cast<std::size_t> (slot)];
+        juce::Path path;
+        for (int i = 0; i < kNumPoints; ++i)
+        {
+            const float x = plot.getX() + plot.getWidth() * static_cast<float> (i) / static_cast<float> (kNumPoints - 1);
+            const float db = juce::jlimit (kDisplayFloorDb, kDisplayCeilingDb, trace[static_cast<std::size_t> (i)]);
+            const float y = juce::jmap (db, kDisplayFloorDb, kDisplayCeilingDb, plot.getBottom(), plot.getY());
+            if (i == 0)
+                path.startNewSubPath (x, y);
+            else
+                path.lineTo (x, y);
+        }
+
+        g.setColour (slot == MultichannelAnalyzer::kSumSlot ? theme.seriesPeak : theme.accent);
+        g.strokePath (path, juce::PathStrokeType (1.0f));
+    }
+}
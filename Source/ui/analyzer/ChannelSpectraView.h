@@ -0,0 +1,58 @@
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+#include <mdsp_ui/UiContext.h>
+#include "../../analyzer/MultichannelAnalyzer.h"
+#include <array>
+
+class AnalayzerProAudioProcessor;
+
+//==============================================================================
+/**
+    ChannelSpectraView
+    Small multiples of the per-channel LOG spectra of a multichannel bus (up to 7.1.4)
+    plus the summed view, labelled with the bus layout's channel names. Clicking a tile
+    shows that slot alone; clicking again returns to the grid.
+
+    Only the displayed slots are computed: the view hands its mask to the
+    MultichannelAnalyzer while visible and clears it when hidden, so a hidden view
+    (or a stereo bus) costs nothing on the audio or worker threads.
+*/
+class ChannelSpectraView : public juce::Component,
+                           private juce::Timer
+{
+public:
+    ChannelSpectraView (mdsp_ui::UiContext& ui, AnalayzerProAudioProcessor& processor);
+    ~ChannelSpectraView() override;
+
+    void paint (juce::Graphics& g) override;
+    void mouseUp (const juce::MouseEvent& e) override;
+
+    /** Starts/stops polling and requests/releases the channel slots with visibility. */
+    void visibilityChanged() override;
+
+private:
+    static constexpr int kNumSlots = MultichannelAnalyzer::kNumSlots;
+    static constexpr int kNumPoints = MultichannelAnalyzer::kNumLogPoints;
+    static constexpr float kDisplayFloorDb = -100.0f;
+    static constexpr float kDisplayCeilingDb = 0.0f;
+
+    void timerCallback() override;
+    void updateLayout();
+    void updateConsumedSlots();
+    juce::Rectangle<int> getTileBounds (int tileIndex, int numTiles) const noexcept;
+
+    mdsp_ui::UiContext& ui_;
+    AnalayzerProAudioProcessor& processor_;
+    MultichannelAnalyzer& analyzer_;
+
+    int numChannels_ = 0;
+    int soloSlot_ = -1;                                 // -1 = grid of every channel + sum
+    std::array<int, kNumSlots> tileSlots_ {};           // Slot shown in each tile
+    int numTiles_ = 0;
+    std::array<juce::String, kNumSlots> slotNames_;
+    std::array<std::array<float, kNumPoints>, kNumSlots> traces_ {};
+    std::array<uint32_t, kNumSlots> lastFrameIndex_ {};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ChannelSpectraView)
+};
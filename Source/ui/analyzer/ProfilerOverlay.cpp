@@ -0,0 +1,104 @@
+#include "ProfilerOverlay.h"
+
+ProfilerOverlay::ProfilerOverlay (mdsp_ui::UiContext& ui, StageProfiler& profiler)
+    : ui_ (ui), profiler_ (profiler)
+{
+    setInterceptsMouseClicks (false, false);
+}
+
+ProfilerOverlay::~ProfilerOverlay()
+{
+    stopTimer();
+    profiler_.setEnabled (false);
+}
+
+void ProfilerOverlay::visibilityChanged()
+{
+    if (isVisible())
+    {
+        profiler_.setEnabled (true);
+        stats_.update (profiler_);   // Drop whatever was counted before (stale window)
+        startTimerHz (2);
+    }
+    else
+    {
+        stopTimer();
+        profiler_.setEnabled (false);
+    }
+}
+
+void ProfilerOverlay::timerCallback()
+{
+    stats_.update (profiler_);
+    repaint();
+}
+
+void ProfilerOverlay::paint (juce::Graphics& g)
+{
+    const auto& theme = ui_.theme();
+    auto area = getLocalBounds().toFloat();
+
+    g.setColour (theme.panel.withAlpha (0.92f));
+    g.fillRoundedRectangle (area, 4.0f);
+    g.setColour (theme.borderDivider);
+    g.drawRoundedRectangle (area.reduced (0.5f), 4.0f, 1.0f);
+
+    const double deadlineNs = profiler_.getDeadlineNs();
+    const auto toUs = [] (double ns) { return juce::String (ns * 0.001, ns < 10000.0 ? 1 : 0); };
+
+    auto content = getLocalBounds().reduced (8, 4);
+    g.setFont (juce::Font (juce::FontOptions().withHeight (11.0f)));
+
+    // Header
+    {
+        auto row = content.removeFromTop (20);
+        g.setColour (theme.text);
+        g.drawText ("Callback profile (us)", row.removeFromLeft (150), juce::Justification::centredLeft);
+        g.setColour (theme.textMuted);
+        g.drawText ("p50", row.removeFromLeft (50), juce::Justification::centredRight);
+        g.drawText ("p99", row.removeFromLeft (50), juce::Justification::centredRight);
+        g.drawText ("max", row.removeFromLeft (50), juce::Justification::centredRight);
+        row.removeFromLeft (8);
+        g.drawText ("deadline " + toUs (deadlineNs), row, juce::Justification::centredLeft);
+    }
+
+    for (int s = 0; s < StageProfiler::kNumStages; ++s)
+    {
+        const auto stage = static_cast<StageProfiler::Stage> (s);
+        const auto& st = stats_.get (stage);
+        auto row = content.removeFromTop (16);
+
+        g.setColour (st.count > 0 ? theme.text : theme.textMuted);
+        g.drawText (StageProfiler::getStageName (stage), row.removeFromLeft (150), juce::Justification::centredLeft);
+
+        if (st.count == 0)
+            continue;
+
+        g.drawText (toUs (st.p50Ns), row.removeFromLeft (50), juce::Justification::centredRight);
+        g.drawText (toUs (st.p99Ns), row.removeFromLeft (50), juce::Justification::centredRight);
+        g.drawText (toUs (st.maxNs), row.removeFromLeft (50), juce::Justification::centredRight);
+        row.removeFromLeft (8);
+
+        if (deadlineNs <= 0.0)
+            continue;
+
+        // Bar: full width = one callback deadline; p99 solid, max as a tick
+        const auto bar = row.reduced (0, 4).toFloat();
+        g.setColour (theme.grid);
+        g.fillRect (bar);
+
+        const auto fraction = [&] (double ns) { return static_cast<float> (juce::jlimit (0.0, 1.0, ns / deadlineNs)); };
+        const double p99Share = st.p99Ns / deadlineNs;
+        g.setColour (p99Share > 1.0 ? theme.danger : (p99Share > 0.5 ? theme.warning : theme.accent));
+        g.fillRect (bar.withWidth (bar.getWidth() * fraction (st.p99Ns)));
+
+        g.setColour (st.maxNs > deadlineNs ? theme.danger : theme.text);
+        const float maxX = bar.getX() + bar.getWidth() * fraction (st.maxNs);
+        g.fillRect (juce::Rectangle<float> (maxX - 1.0f, bar.getY() - 2.0f, 2.0f, bar.getHeight() + 4.0f));
+    }
+
+    // Engine stages run on the analysis thread when it is enabled: they are not then part of the callback
+    g.setColour (theme.textMuted);
+    g.drawText ("Indented stages are inside Analyzer (analysis thread if enabled)", content.removeFromTop (16),
+                juce::Justification::centredLeft);
+}
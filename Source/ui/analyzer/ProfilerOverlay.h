@@ -0,0 +1,37 @@
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+#include <mdsp_ui/UiContext.h>
+#include "../../diagnostics/StageProfiler.h"
+
+//==============================================================================
+/**
+    ProfilerOverlay
+    Diagnostic table of the audio callback stages (StageProfiler): p50 / p99 / max per
+    stage over the last half second, with a bar against the callback deadline.
+
+    Profiling is only switched on while the overlay is visible, so a hidden overlay
+    leaves the audio thread untimed. Does not take mouse input.
+*/
+class ProfilerOverlay : public juce::Component,
+                        private juce::Timer
+{
+public:
+    ProfilerOverlay (mdsp_ui::UiContext& ui, StageProfiler& profiler);
+    ~ProfilerOverlay() override;
+
+    void paint (juce::Graphics& g) override;
+    void visibilityChanged() override;
+
+    /** Size that fits the table. */
+    static juce::Rectangle<int> getPreferredBounds() noexcept { return { 0, 0, 430, 28 + 16 * (StageProfiler::kNumStages + 1) }; }
+
+private:
+    void timerCallback() override;
+
+    mdsp_ui::UiContext& ui_;
+    StageProfiler& profiler_;
+    StageProfiler::WindowStats stats_;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ProfilerOverlay)
+};
@@ -0,0 +1,158 @@
+#include "SpectrogramView.h"
+#include <cmath>
+
+SpectrogramView::SpectrogramView (mdsp_ui::UiContext& ui, AnalyzerEngine& engine)
+    : ui_ (ui), engine_ (engine), history_ (engine.getSpectrogramHistory())
+{
+    // One image row per history row: size is fixed, the component just scales it
+    rowImage_ = juce::Image (juce::Image::ARGB, SpectrogramHistory::kNumColumns, kImageRows, true);
+    readBuffer_.resize (static_cast<std::size_t> (kImageRows) * SpectrogramHistory::kNumColumns, 0);
+
+    rebuildColourLut();
+    rowImage_.clear (rowImage_.getBounds(), ui_.theme().background);
+
+    setOpaque (true);
+}
+
+SpectrogramView::~SpectrogramView()
+{
+    stopTimer();
+    if (consuming_)
+        engine_.removeConsumer (AnalyzerEngine::Product::Spectrogram);
+}
+
+void SpectrogramView::visibilityChanged()
+{
+    if (isVisible() != consuming_)
+    {
+        consuming_ = isVisible();
+        if (consuming_)
+            engine_.addConsumer (AnalyzerEngine::Product::Spectrogram);
+        else
+            engine_.removeConsumer (AnalyzerEngine::Product::Spectrogram);
+    }
+
+    if (isVisible())
+        startTimerHz (30);
+    else
+        stopTimer();
+}
+
+void SpectrogramView::rebuildColourLut()
+{
+    const auto& theme = ui_.theme();
+
+    juce::ColourGradient gradient (theme.background, 0.0f, 0.0f, theme.danger, 1.0f, 0.0f, false);
+    gradient.addColour (0.45, theme.accent);
+    gradient.addColour (0.80, theme.warning);
+
+    for (int code = 0; code < 256; ++code)
+    {
+        const float db = SpectrogramHistory::codeToDb (static_cast<uint8_t> (code));
+        const float t = juce::jlimit (0.0f, 1.0f, (db - kDisplayFloorDb) / (kDisplayCeilingDb - kDisplayFloorDb));
+        colourLut_[static_cast<std::size_t> (code)] = gradient.getColourAtPosition (static_cast<double> (t)).getPixelARGB();
+    }
+}
+
+void SpectrogramView::writeRow (const uint8_t* codes)
+{
+    // Ring runs upwards so that reading from headRow_ down gives newest -> oldest
+    headRow_ = (headRow_ + kImageRows - 1) % kImageRows;
+
+    juce::Image::BitmapData pixels (rowImage_, 0, headRow_, SpectrogramHistory::kNumColumns, 1,
+                                    juce::Image::BitmapData::writeOnly);
+    for (int x = 0; x < SpectrogramHistory::kNumColumns; ++x)
+        *reinterpret_cast<juce::PixelARGB*> (pixels.getPixelPointer (x, 0)) = colourLut_[codes[x]];
+}
+
+void SpectrogramView::timerCallback()
+{
+    // Rows that would scroll out of the image within this tick are never converted
+    const uint64_t written = history_.getNumRowsWritten();
+    if (written - cursor_ > static_cast<uint64_t> (kImageRows))
+        cursor_ = written - static_cast<uint64_t> (kImageRows);
+
+    const int numRows = history_.readRows (cursor_, readBuffer_.data(), kImageRows);
+    if (numRows <= 0)
+        return;
+
+    for (int i = 0; i < numRows; ++i)
+        writeRow (readBuffer_.data() + static_cast<std::size_t> (i) * SpectrogramHistory::kNumColumns);
+
+    repaint();
+}
+
+void SpectrogramView::paint (juce::Graphics& g)
+{
+    const auto& theme = ui_.theme();
+    g.fillAll (theme.background);
+
+    const auto area = getLocalBounds();
+    if (area.isEmpty())
+        return;
+
+    // Scroll by offset: the visible span starts at headRow_ (newest, on top) and runs down the
+    // ring, wrapping to image row 0 for the rest
+    g.setImageResamplingQuality (juce::Graphics::lowResamplingQuality);
+    const int w = area.getWidth();
+    const int h = area.getHeight();
+    const int visibleRows = getVisibleRows();
+    const int topRows = juce::jmin (visibleRows, kImageRows - headRow_);
+    const int splitY = juce::roundToInt (static_cast<float> (h) * static_cast<float> (topRows) / static_cast<float> (visibleRows));
+
+    g.drawImage (rowImage_, area.getX(), area.getY(), w, splitY,
+                 0, headRow_, SpectrogramHistory::kNumColumns, topRows);
+    if (topRows < visibleRows)
+        g.drawImage (rowImage_, area.getX(), area.getY() + splitY, w, h - splitY,
+                     0, 0, SpectrogramHistory::kNumColumns, visibleRows - topRows);
+
+    // Decade grid on the same log axis as the columns
+    const float logSpan = std::log10 (SpectrumResampler::kMaxLogFrequencyHz / SpectrumResampler::kMinLogFrequencyHz);
+    g.setColour (theme.grid.withAlpha (0.5f));
+    for (const float hz : { 100.0f, 1000.0f, 10000.0f })
+    {
+        const float x = static_cast<float> (area.getX())
+                      + static_cast<float> (w) * std::log10 (hz / SpectrumResampler::kMinLogFrequencyHz) / logSpan;
+        g.drawVerticalLine (juce::roundToInt (x), static_cast<float> (area.getY()), static_cast<float> (area.getBottom()));
+    }
+
+    // Visible span (click or wheel to change)
+    g.setFont (ui_.type().labelSmallFont());
+    g.setColour (theme.textMuted);
+    g.drawText (juce::String (kSpanSeconds[static_cast<std::size_t> (spanIndex_)]) + " s", getSpanLabelArea(),
+                juce::Justification::centredRight, false);
+
+    g.setColour (theme.borderDivider);
+    g.drawRect (area, 1);
+}
+
+juce::Rectangle<int> SpectrogramView::getSpanLabelArea() const noexcept
+{
+    return getLocalBounds().reduced (4).removeFromTop (14).removeFromRight (40);
+}
+
+void SpectrogramView::setSpanIndex (int newIndex)
+{
+    newIndex = juce::jlimit (0, static_cast<int> (kSpanSeconds.size()) - 1, newIndex);
+    if (newIndex == spanIndex_)
+        return;
+
+    spanIndex_ = newIndex;
+    repaint();
+}
+
+void SpectrogramView::mouseDown (const juce::MouseEvent& e)
+{
+    // The label cycles 10 -> 30 -> 60 -> 10 s
+    if (getSpanLabelArea().contains (e.getPosition()))
+        setSpanIndex ((spanIndex_ + 1) % static_cast<int> (kSpanSeconds.size()));
+}
+
+void SpectrogramView::mouseWheelMove (const juce::MouseEvent&, const juce::MouseWheelDetails& wheel)
+{
+    // Wheel up zooms in (shorter span), down shows more history
+    if (wheel.deltaY > 0.0f)
+        setSpanIndex (spanIndex_ - 1);
+    else if (wheel.deltaY < 0.0f)
+        setSpanIndex (spanIndex_ + 1);
+}
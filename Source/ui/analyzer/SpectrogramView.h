@@ -0,0 +1,67 @@
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+#include <mdsp_ui/UiContext.h>
+#include "../../analyzer/AnalyzerEngine.h"
+#include "../../analyzer/SpectrumResampler.h"
+#include <array>
+#include <vector>
+
+//==============================================================================
+/**
+    SpectrogramView
+    Scrolling waterfall of the engine's SpectrogramHistory (newest row on top,
+    20 Hz - 20 kHz log axis left to right).
+
+    The history is mirrored into a persistent image used as a circular row buffer:
+    each timer tick converts only the rows published since the last tick through a
+    256-entry colour LUT, and paint() scrolls by blitting the two halves of the ring
+    at an offset. Cost per frame depends on the number of new rows and the component
+    size, never on the history length. The engine records rows only while the view is
+    shown (Product::Spectrogram consumer).
+
+    The image holds the whole readable history (64 s); the visible span is 10, 30 or 60 s,
+    cycled by clicking the span label (top right) or with the mouse wheel.
+*/
+class SpectrogramView : public juce::Component,
+                        private juce::Timer
+{
+public:
+    SpectrogramView (mdsp_ui::UiContext& ui, AnalyzerEngine& engine);
+    ~SpectrogramView() override;
+
+    void paint (juce::Graphics& g) override;
+
+    /** Starts/stops polling and recording with visibility (hidden view costs nothing). */
+    void visibilityChanged() override;
+
+    void mouseDown (const juce::MouseEvent& e) override;
+    void mouseWheelMove (const juce::MouseEvent& e, const juce::MouseWheelDetails& wheel) override;
+
+private:
+    static constexpr int kImageRows = SpectrogramHistory::kReadableRows;            // All readable history
+    static constexpr std::array<int, 3> kSpanSeconds { 10, 30, 60 };
+    static constexpr float kDisplayFloorDb = -100.0f;
+    static constexpr float kDisplayCeilingDb = 0.0f;
+
+    void timerCallback() override;
+    void rebuildColourLut();
+    void writeRow (const uint8_t* codes);
+    int getVisibleRows() const noexcept { return kSpanSeconds[static_cast<std::size_t> (spanIndex_)] * SpectrogramHistory::kRowsPerSecond; }
+    void setSpanIndex (int newIndex);
+    juce::Rectangle<int> getSpanLabelArea() const noexcept;
+
+    mdsp_ui::UiContext& ui_;
+    AnalyzerEngine& engine_;
+    const SpectrogramHistory& history_;
+    bool consuming_ = false;
+
+    juce::Image rowImage_;                         // kNumColumns x kImageRows ring
+    int headRow_ = 0;                              // Image row holding the newest history row
+    int spanIndex_ = 0;                            // Into kSpanSeconds
+    uint64_t cursor_ = 0;                          // Next history row to fetch
+    std::vector<uint8_t> readBuffer_;              // kImageRows rows of codes
+    std::array<juce::PixelARGB, 256> colourLut_ {};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SpectrogramView)
+};
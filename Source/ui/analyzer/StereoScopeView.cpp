@@ -1,8 +1,10 @@
 #include "StereoScopeView.h"
 
-StereoScopeView::StereoScopeView (mdsp_ui::UiContext& ui, StereoScopeAnalyzer& analyzer)
-    : ui_ (ui), analyzer_ (analyzer)
+StereoScopeView::StereoScopeView (mdsp_ui::UiContext& ui, AnalyzerEngine& engine)
+    : ui_ (ui), engine_ (engine), analyzer_ (engine.getStereoScopeAnalyzer())
 {
+    engine_.addConsumer (AnalyzerEngine::Product::StereoScope);
+    
     // Initialize buffers to reasonable snapshot size (e.g. 512 samples)
     lBuffer_.resize (512, 0.0f);
     rBuffer_.resize (512, 0.0f);
@@ -13,6 +15,7 @@ StereoScopeView::StereoScopeView (mdsp_ui::UiContext& ui, StereoScopeAnalyzer& a
 StereoScopeView::~StereoScopeView()
 {
     stopTimer();
+    engine_.removeConsumer (AnalyzerEngine::Product::StereoScope);
 }
 
 void StereoScopeView::resized()
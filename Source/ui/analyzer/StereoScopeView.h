@@ -2,19 +2,19 @@
 
 #include <juce_gui_basics/juce_gui_basics.h>
 #include <mdsp_ui/UiContext.h>
-#include "../../analyzer/StereoScopeAnalyzer.h"
+#include "../../analyzer/AnalyzerEngine.h"
 
 //==============================================================================
 /**
     StereoScopeView
     Visualizes stereo correlation using a vectorscope plot (Mid/Side mapping).
-    Includes persistence decay.
+    Includes persistence decay. Registered as the engine's StereoScope consumer while it exists.
 */
 class StereoScopeView : public juce::Component,
                         private juce::Timer
 {
 public:
-    StereoScopeView (mdsp_ui::UiContext& ui, StereoScopeAnalyzer& analyzer);
+    StereoScopeView (mdsp_ui::UiContext& ui, AnalyzerEngine& engine);
     ~StereoScopeView() override;
 
     void paint (juce::Graphics& g) override;
@@ -25,6 +25,7 @@ private:
     void renderScopeToImage();
 
     mdsp_ui::UiContext& ui_;
+    AnalyzerEngine& engine_;
     StereoScopeAnalyzer& analyzer_;
 
     // Data buffers
@@ -264,6 +264,25 @@ void RTADisplay::setLogData (const std::vector<float>& logBandsDb, const std::ve
     repaint();
 }
 
+void RTADisplay::setLtasData (const std::vector<float>& centersHz, const std::vector<float>& ltasDb, double durationSec)
+{
+    if (ltasDb.empty() || centersHz.size() != ltasDb.size())
+    {
+        if (state.ltasDb.empty())
+            return;
+        state.ltasCentersHz.clear();
+        state.ltasDb.clear();
+        state.ltasDurationSec = 0.0;
+        repaint();
+        return;
+    }
+    
+    state.ltasCentersHz = centersHz;
+    state.ltasDb = ltasDb;
+    state.ltasDurationSec = durationSec;
+    repaint();
+}
+
 void RTADisplay::setBandCenters (const std::vector<float>& centersHz)
 {
     // B1: Every setter updates state fields and calls repaint()
@@ -687,6 +706,65 @@ void RTADisplay::buildFftPaths()
     pathsValid_ = true;
 }
 
+void RTADisplay::rebuildPixelBinMap(size_t numBins)
+{
+    // Pixel -> bin spans only depend on geometry + FFT meta: compute once, reuse for every trace/frame.
+    // Keeps buildDecimatedPath at O(pixels + bins) with no pow() per pixel, even at 64k FFT (32769 bins).
+    const auto& s = state;
+    const int w = static_cast<int>(plotAreaWidth);
+
+    PixelBinMapKey key { w, plotAreaLeft, plotAreaWidth, s.minHz, s.maxHz, s.sampleRate, s.fftSize, numBins };
+    if (key == pixelBinMapKey_ && !pixelBinMap_.empty())
+        return;
+
+    pixelBinMapKey_ = key;
+    pixelBinMap_.clear();
+    if (w <= 0 || numBins == 0 || s.fftSize <= 0 || s.sampleRate <= 0.0)
+        return;
+
+    pixelBinMap_.resize(static_cast<size_t>(w + 1));
+
+    const float logMin = std::log10(s.minHz);
+    const float logMax = std::log10(s.maxHz);
+    const float logRange = logMax - logMin;
+    const float binWidthHz = static_cast<float>(s.sampleRate) / static_cast<float>(s.fftSize);
+
+    auto xToFreq = [&](float px) -> float {
+        const float norm = (px - plotAreaLeft) / plotAreaWidth;
+        return std::pow(10.0f, logMin + norm * logRange);
+    };
+
+    for (int x = 0; x <= w; ++x)
+    {
+        auto& span = pixelBinMap_[static_cast<size_t>(x)];
+        const float x0 = plotAreaLeft + static_cast<float>(x);
+
+        const float freqStart = xToFreq(x0);
+        const float freqEnd = xToFreq(x0 + 1.0f);
+        span.freqCenter = xToFreq(x0 + 0.5f);
+
+        // Convert Hz range to Bin range (float)
+        const float binStartF = freqStart / binWidthHz;
+        const float binEndF = freqEnd / binWidthHz;
+
+        // Fix 3: Smoothness vs Accuracy Hybrid
+        // If the pixel covers < 1 bin (Low Freq / Zoomed), use Interpolation to avoid steps.
+        // If the pixel covers >= 1 bin (High Freq), use Peak Detection to avoid missing energy.
+        span.interpolate = (binEndF - binStartF) < 1.0f;
+
+        // Sub-bin resolution: Interpolate at pixel center
+        const float exactBin = span.freqCenter / binWidthHz;
+        span.interpIdx = static_cast<size_t>(exactBin);
+        span.frac = exactBin - static_cast<float>(span.interpIdx);
+
+        // Multi-bin resolution: Peak Detect range. Ensure we scan at least one bin
+        const size_t b0 = juce::jlimit((size_t)0, numBins - 1, static_cast<size_t>(binStartF));
+        const size_t b1 = juce::jlimit((size_t)0, numBins, static_cast<size_t>(std::ceil(binEndF)));
+        span.b0 = b0;
+        span.b1 = std::min(std::max(b1, b0 + 1), numBins);
+    }
+}
+
 void RTADisplay::buildDecimatedPath(const std::vector<float>& data, juce::Path& path)
 {
     path.clear();
@@ -696,53 +774,30 @@ void RTADisplay::buildDecimatedPath(const std::vector<float>& data, juce::Path&
     const int w = static_cast<int>(plotAreaWidth);
     if (w <= 0) return;
 
-    // 1. Decimate points (O(pixels))
-    std::vector<juce::Point<float>> pts;
-    pts.reserve(static_cast<size_t>(w + 2));
-    
-    const float logMin = std::log10(s.minHz);
-    const float logMax = std::log10(s.maxHz);
-    const float logRange = logMax - logMin;
     const size_t numBins = data.size();
-    const float binWidthHz = static_cast<float>(s.sampleRate) / static_cast<float>(s.fftSize);
+    rebuildPixelBinMap(numBins);
+    if (pixelBinMap_.size() != static_cast<size_t>(w + 1)) return;
+
+    // 1. Decimate points (O(pixels + bins), spans cached)
+    auto& pts = decimatedPoints_;
+    pts.clear();
+    pts.reserve(static_cast<size_t>(w + 2));
     
     float lastX = -std::numeric_limits<float>::max();
     
     for (int x = 0; x <= w; ++x)
     {
         const float x0 = plotAreaLeft + static_cast<float>(x);
-        const float x1 = x0 + 1.0f;
         
         // ARTIFACT GUARD: Sanity check X
         if (!std::isfinite(x0)) continue;
         
-        auto xToFreq = [&](float px) -> float {
-            const float norm = (px - plotAreaLeft) / plotAreaWidth;
-            return std::pow(10.0f, logMin + norm * logRange);
-        };
-        
-        const float freqStart = xToFreq(x0);
-        const float freqEnd = xToFreq(x1);
-        
-        // Convert Hz range to Bin range (float)
-        const float binStartF = freqStart / binWidthHz;
-        const float binEndF = freqEnd / binWidthHz;
-        
-        const size_t b0 = juce::jlimit((size_t)0, numBins - 1, static_cast<size_t>(binStartF));
-        const size_t b1 = juce::jlimit((size_t)0, numBins, static_cast<size_t>(std::ceil(binEndF)));
-        
+        const auto& span = pixelBinMap_[static_cast<size_t>(x)];
         float finalDb = -200.0f;
         
-        // Fix 3: Smoothness vs Accuracy Hybrid
-        // If the pixel covers < 1 bin (Low Freq / Zoomed), use Interpolation to avoid steps.
-        // If the pixel covers >= 1 bin (High Freq), use Peak Detection to avoid missing energy.
-        if ((binEndF - binStartF) < 1.0f)
+        if (span.interpolate)
         {
-            // Sub-bin resolution: Interpolate at pixel center
-            const float freqCenter = xToFreq(x0 + 0.5f);
-            const float exactBin = freqCenter / binWidthHz;
-            const size_t idx = static_cast<size_t>(exactBin);
-            const float frac = exactBin - static_cast<float>(idx);
+            const size_t idx = span.interpIdx;
             
             if (idx < numBins - 1)
             {
@@ -752,7 +807,7 @@ void RTADisplay::buildDecimatedPath(const std::vector<float>& data, juce::Path&
                  // Sanitize inputs
                  if (!std::isfinite(v1)) v1 = -120.0f;
                  if (!std::isfinite(v2)) v2 = -120.0f;
-                 finalDb = v1 * (1.0f - frac) + v2 * frac;
+                 finalDb = v1 * (1.0f - span.frac) + v2 * span.frac;
             }
             else if (idx < numBins)
             {
@@ -761,14 +816,8 @@ void RTADisplay::buildDecimatedPath(const std::vector<float>& data, juce::Path&
         }
         else
         {
-            // Multi-bin resolution: Peak Detect
-            // Ensure we scan at least one bin
-            size_t validB0 = b0;
-            size_t validB1 = std::max(b1, validB0 + 1);
-            validB1 = std::min(validB1, numBins);
-            
             float maxVal = -200.0f;
-            for (size_t k = validB0; k < validB1; ++k)
+            for (size_t k = span.b0; k < span.b1; ++k)
             {
                 const float val = data[k];
                 if (std::isfinite(val) && val > maxVal) maxVal = val;
@@ -778,8 +827,7 @@ void RTADisplay::buildDecimatedPath(const std::vector<float>& data, juce::Path&
             
         // ARTIFACT GUARD: Hard Clamp Y
         finalDb = juce::jlimit(s.bottomDb, s.topDb + 20.0f, finalDb);
-        const float freqForY = xToFreq(x0 + 0.5f);
-        const float y = dbToYWithCompensation(finalDb, freqForY, s);
+        const float y = dbToYWithCompensation(finalDb, span.freqCenter, s);
 
         // ARTIFACT GUARD: Sanity check Y
         if (!std::isfinite(y)) continue;
@@ -1355,6 +1403,54 @@ void RTADisplay::paint (juce::Graphics& g)
         }
         paintFFTMode (g, s, theme);
     }
+    
+    paintLtasOverlay (g, s, theme);
+}
+
+void RTADisplay::paintLtasOverlay (juce::Graphics& g, const RenderState& s, const mdsp_ui::Theme& theme)
+{
+    // B3: Pure function - uses only state reference, no member mutations
+    if (s.ltasDb.empty() || s.ltasCentersHz.size() != s.ltasDb.size())
+        return;
+    
+    const int numPoints = static_cast<int> (s.ltasDb.size());
+    const juce::Rectangle<float> plotBounds (plotAreaLeft, plotAreaTop, plotAreaWidth, plotAreaHeight);
+    
+    mdsp_ui::SeriesStyle ltasStyle;
+    ltasStyle.strokeThickness = 2.0f;
+    ltasStyle.alpha = 0.9f;
+    ltasStyle.clipToPlot = true;
+    ltasStyle.minXStepPx = 1.0f;
+    ltasStyle.minYStepPx = 0.5f;
+    ltasStyle.useRoundedJoins = true;
+    ltasStyle.decimationMode = mdsp_ui::DecimationMode::Simple;
+    
+    mdsp_ui::SeriesRenderer::drawPathFromMapping (g, plotBounds, theme, numPoints,
+        [&s, this] (int i) -> float
+        {
+            return freqToX (s.ltasCentersHz[static_cast<size_t> (i)], s);
+        },
+        [&s, this] (int i) -> float
+        {
+            return dbToY (s.ltasDb[static_cast<size_t> (i)], s);
+        },
+        theme.warning, ltasStyle);
+    
+    // Averaged span, e.g. "LTAS 3:25" (h:mm:ss past an hour)
+    const int totalSec = static_cast<int> (s.ltasDurationSec);
+    const int hours = totalSec / 3600;
+    const int minutes = (totalSec / 60) % 60;
+    const int seconds = totalSec % 60;
+    juce::String span = "LTAS ";
+    if (hours > 0)
+        span << hours << ":" << juce::String (minutes).paddedLeft ('0', 2);
+    else
+        span << minutes;
+    span << ":" << juce::String (seconds).paddedLeft ('0', 2);
+    
+    g.setFont (smallFont);
+    g.setColour (theme.warning);
+    g.drawText (span, plotBounds.reduced (6.0f).removeFromBottom (12.0f), juce::Justification::bottomLeft, false);
 }
 
 // Helper functions defined above (freqToX, dbToY, computeLogFreqFromIndex, findNearestLogBand)
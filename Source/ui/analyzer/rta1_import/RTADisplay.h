@@ -61,6 +61,10 @@ public:
     /** Set log band data for Log view mode */
     void setLogData (const std::vector<float>& logBandsDb, const std::vector<float>* peakBandsDbNullable = nullptr);
 
+    /** Set long-term average (LTAS) overlay, drawn in every view mode over the live traces.
+        Empty data removes it. */
+    void setLtasData (const std::vector<float>& centersHz, const std::vector<float>& ltasDb, double durationSec);
+
     /** Set no-data state (call when data is unavailable) */
     void setNoData (const juce::String& reason);
     
@@ -128,6 +132,8 @@ public:
 #endif
 
 private:
+    friend struct AnalyzerBenchAccess; // tools/bench times the private hot paths directly
+
     enum class DataStatus
     {
         Ok,
@@ -210,6 +216,11 @@ private:
         juce::String noDataReason;
         bool isHoldOn = false;
         
+        // LTAS overlay (empty => hidden)
+        std::vector<float> ltasCentersHz;
+        std::vector<float> ltasDb;
+        double ltasDurationSec = 0.0;
+        
         // Session Marker
         bool sessionMarkerVisible = false;
         int sessionMarkerBin = -1;
@@ -236,6 +247,7 @@ private:
     void paintBandsMode (juce::Graphics& g, const RenderState& s, const mdsp_ui::Theme& theme);
     void paintLogMode (juce::Graphics& g, const RenderState& s, const mdsp_ui::Theme& theme);
     void paintFFTMode (juce::Graphics& g, const RenderState& s, const mdsp_ui::Theme& theme);
+    void paintLtasOverlay (juce::Graphics& g, const RenderState& s, const mdsp_ui::Theme& theme);
     void drawGrid (juce::Graphics& g, const RenderState& s, const mdsp_ui::Theme& theme);
     
     // Helper: compute log frequency from index (for log mode rendering)
@@ -356,6 +368,36 @@ private:
     // Helper to build a single decimated path with quadratic smoothing
     void buildDecimatedPath(const std::vector<float>& data, juce::Path& path);
 
+    // Cached pixel -> bin spans for buildDecimatedPath (rebuilt on geometry/meta/bin count change)
+    struct PixelBinSpan
+    {
+        size_t b0 = 0, b1 = 0;      // Peak-detect range [b0, b1)
+        size_t interpIdx = 0;       // Interpolation base bin (pixel center)
+        float frac = 0.0f;
+        float freqCenter = 0.0f;    // Pixel center frequency (Y compensation)
+        bool interpolate = false;   // Pixel covers < 1 bin
+    };
+
+    struct PixelBinMapKey
+    {
+        int width = 0;
+        float left = 0.0f, widthF = 0.0f, minHz = 0.0f, maxHz = 0.0f;
+        double sampleRate = 0.0;
+        int fftSize = 0;
+        size_t numBins = 0;
+
+        bool operator== (const PixelBinMapKey& o) const noexcept
+        {
+            return width == o.width && left == o.left && widthF == o.widthF && minHz == o.minHz
+                && maxHz == o.maxHz && sampleRate == o.sampleRate && fftSize == o.fftSize && numBins == o.numBins;
+        }
+    };
+
+    std::vector<PixelBinSpan> pixelBinMap_;
+    PixelBinMapKey pixelBinMapKey_;
+    std::vector<juce::Point<float>> decimatedPoints_;  // Scratch (reused per trace)
+    void rebuildPixelBinMap(size_t numBins);
+
     // Data status
 
     juce::String noDataReason;
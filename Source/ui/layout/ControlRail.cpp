@@ -28,8 +28,15 @@ ControlRail::ControlRail (mdsp_ui::UiContext& ui)
       showMidRow (ui, "Show Mid", showMidButton),
       showSideRow (ui, "Show Side", showSideButton),
       showRmsRow (ui, "Show RMS", showRmsButton),
+      showSpectrogramRow (ui, "Spectrogram", showSpectrogramButton),
+      showLtasRow (ui, "LTAS", showLtasButton),
       
       smoothingRow (ui, "Smoothing", smoothingCombo),
+      overlapRow (ui, "Overlap", overlapCombo),
+      bandwidthRow (ui, "Bandwidth", bandwidthCombo),
+      multiResRow (ui, "Multi-Res", multiResButton),
+      filterBankRow (ui, "Filter Bank", filterBankButton),
+      bandResolutionRow (ui, "Band Res", bandResolutionCombo),
       weightingRow (ui, "Weighting", weightingCombo)
 {
     const auto& theme = ui_.theme();
@@ -60,8 +67,15 @@ ControlRail::ControlRail (mdsp_ui::UiContext& ui)
     showMidRow.attachToParent (*this);
     showSideRow.attachToParent (*this);
     showRmsRow.attachToParent (*this);
+    showSpectrogramRow.attachToParent (*this);
+    showLtasRow.attachToParent (*this);
 
     smoothingRow.attachToParent (*this);
+    overlapRow.attachToParent (*this);
+    bandwidthRow.attachToParent (*this);
+    multiResRow.attachToParent (*this);
+    filterBankRow.attachToParent (*this);
+    bandResolutionRow.attachToParent (*this);
     weightingRow.attachToParent (*this);
 
     // M_2026_01_19_PEAK_HOLD_PROFESSIONAL_BEHAVIOR: Slider Config
@@ -86,6 +100,31 @@ ControlRail::ControlRail (mdsp_ui::UiContext& ui)
     smoothingCombo.addItem ("1 Octave", 6);
     smoothingCombo.setSelectedId (4, juce::dontSendNotification); // Default 1/6 (matches plugin default)
 
+    // Overlap Combo
+    // Options: 0%, 50%, 75%, 87.5%, Auto (hop from the UI frame rate)
+    overlapCombo.addItem ("0%", 1);
+    overlapCombo.addItem ("50%", 2);
+    overlapCombo.addItem ("75%", 3);
+    overlapCombo.addItem ("87.5%", 4);
+    overlapCombo.addItem ("Auto", 5);
+    overlapCombo.setSelectedId (3, juce::dontSendNotification); // Default 75% (matches plugin default)
+
+    // Analysis Bandwidth Combo
+    // Options: Full (host rate), 20 kHz, 10 kHz, 5 kHz (decimated analysis at high sample rates)
+    bandwidthCombo.addItem ("Full", 1);
+    bandwidthCombo.addItem ("20 kHz", 2);
+    bandwidthCombo.addItem ("10 kHz", 3);
+    bandwidthCombo.addItem ("5 kHz", 4);
+    bandwidthCombo.setSelectedId (1, juce::dontSendNotification); // Default Full (matches plugin default)
+
+    // Band Resolution Combo (filter-bank RTA)
+    // Options: 1/1, 1/3, 1/6, 1/12 Oct
+    bandResolutionCombo.addItem ("1/1 Oct", 1);
+    bandResolutionCombo.addItem ("1/3 Oct", 2);
+    bandResolutionCombo.addItem ("1/6 Oct", 3);
+    bandResolutionCombo.addItem ("1/12 Oct", 4);
+    bandResolutionCombo.setSelectedId (2, juce::dontSendNotification); // Default 1/3 (matches plugin default)
+
     // Weighting Combo
     // Options: None, A-Weighting, BS.468-4
     weightingCombo.addItem ("None", 1);
@@ -126,6 +165,15 @@ ControlRail::ControlRail (mdsp_ui::UiContext& ui)
         triggerResetPeaks();
     };
     addAndMakeVisible (resetPeaksButton);
+    
+    // LTAS reset (independent from peak reset)
+    resetLtasButton.setTooltip ("Restart the long-term average");
+    resetLtasButton.onClick = [this]
+    {
+        if (onResetLtas_)
+            onResetLtas_();
+    };
+    addAndMakeVisible (resetLtasButton);
 
     // Placeholder labels
     placeholderLabel1.setText ("Controls...", juce::dontSendNotification);
@@ -160,6 +208,8 @@ void ControlRail::setControlBinder (AnalyzerPro::ControlBinder& binder)
         controlBinder->bindSlider (AnalyzerPro::ControlId::AnalyzerPeakDecay, peakDecaySlider);
         controlBinder->bindCombo (AnalyzerPro::ControlId::AnalyzerTilt, tiltCombo);
         controlBinder->bindCombo (AnalyzerPro::ControlId::AnalyzerAveraging, smoothingCombo);
+        controlBinder->bindCombo (AnalyzerPro::ControlId::AnalyzerFftOverlap, overlapCombo);
+        controlBinder->bindCombo (AnalyzerPro::ControlId::AnalyzerBandwidth, bandwidthCombo);
         controlBinder->bindCombo (AnalyzerPro::ControlId::AnalyzerWeighting, weightingCombo);
         
         controlBinder->bindCombo (AnalyzerPro::ControlId::ScopeChannelMode, scopeInputCombo);
@@ -174,6 +224,11 @@ void ControlRail::setControlBinder (AnalyzerPro::ControlBinder& binder)
         controlBinder->bindToggle (AnalyzerPro::ControlId::TraceShowMid, showMidButton);
         controlBinder->bindToggle (AnalyzerPro::ControlId::TraceShowSide, showSideButton);
         controlBinder->bindToggle (AnalyzerPro::ControlId::TraceShowRMS, showRmsButton);
+        controlBinder->bindToggle (AnalyzerPro::ControlId::AnalyzerShowSpectrogram, showSpectrogramButton);
+        controlBinder->bindToggle (AnalyzerPro::ControlId::AnalyzerShowLtas, showLtasButton);
+        controlBinder->bindToggle (AnalyzerPro::ControlId::AnalyzerMultiRes, multiResButton);
+        controlBinder->bindToggle (AnalyzerPro::ControlId::AnalyzerFilterBank, filterBankButton);
+        controlBinder->bindCombo (AnalyzerPro::ControlId::AnalyzerBandResolution, bandResolutionCombo);
     }
 }
 
@@ -238,10 +293,22 @@ void ControlRail::resized()
     showMidRow.layout (bounds, y);
     showSideRow.layout (bounds, y);
     showRmsRow.layout (bounds, y);
+    showSpectrogramRow.layout (bounds, y);
+    
+    // LTAS + Reset (same arrangement as Hold + Reset)
+    showLtasRow.layout (bounds, y);
+    y -= m.buttonSmallH + m.gapSmall;
+    resetLtasButton.setBounds (bounds.getX() + m.buttonSmallW + m.gapSmall, y, m.buttonW, m.buttonSmallH);
+    y += m.buttonSmallH + m.gapSmall;
     y += m.sectionSpacing;
     
     // Smoothing
     smoothingRow.layout (bounds, y);
+    overlapRow.layout (bounds, y);
+    bandwidthRow.layout (bounds, y);
+    multiResRow.layout (bounds, y);
+    filterBankRow.layout (bounds, y);
+    bandResolutionRow.layout (bounds, y);
     y += m.sectionSpacing;
     
     // Weighting
@@ -22,6 +22,7 @@ public:
 
     void setControlBinder (AnalyzerPro::ControlBinder& binder);
     void setResetPeaksCallback (std::function<void()> cb);
+    void setResetLtasCallback (std::function<void()> cb) { onResetLtas_ = std::move (cb); }
     
     // Scope Callbacks
     std::function<void(int)> onScopeModeChanged;  // 1=Peak, 2=RMS
@@ -35,6 +36,7 @@ private:
 
     void triggerResetPeaks();
     std::function<void()> onResetPeaks_;
+    std::function<void()> onResetLtas_;
 
     mdsp_ui::UiContext& ui_;
 
@@ -43,6 +45,7 @@ private:
     juce::Slider peakDecaySlider;
     juce::ComboBox tiltCombo;
     juce::TextButton resetPeaksButton { "Reset" };
+    juce::TextButton resetLtasButton { "Reset" };
     
     // Scope Controls
     juce::ComboBox scopeModeCombo;
@@ -80,6 +83,7 @@ private:
     juce::ToggleButton showMidButton;
     juce::ToggleButton showSideButton;
     juce::ToggleButton showRmsButton;
+    juce::ToggleButton showSpectrogramButton;
     
     mdsp_ui::ToggleRow showLrRow;
     mdsp_ui::ToggleRow showMonoRow;
@@ -88,6 +92,9 @@ private:
     mdsp_ui::ToggleRow showMidRow;
     mdsp_ui::ToggleRow showSideRow;
     mdsp_ui::ToggleRow showRmsRow;
+    mdsp_ui::ToggleRow showSpectrogramRow;
+    juce::ToggleButton showLtasButton;
+    mdsp_ui::ToggleRow showLtasRow;
     
     // Smoothing
     
@@ -95,6 +102,24 @@ private:
     juce::ComboBox smoothingCombo;
     mdsp_ui::ChoiceRow smoothingRow;
 
+    // FFT Overlap
+    juce::ComboBox overlapCombo;
+    mdsp_ui::ChoiceRow overlapRow;
+
+    // Analysis Bandwidth (decimating front end)
+    juce::ComboBox bandwidthCombo;
+    mdsp_ui::ChoiceRow bandwidthRow;
+
+    // Multi-Resolution (LOG mode)
+    juce::ToggleButton multiResButton;
+    mdsp_ui::ToggleRow multiResRow;
+
+    // Filter-Bank RTA (BANDS mode)
+    juce::ToggleButton filterBankButton;
+    mdsp_ui::ToggleRow filterBankRow;
+    juce::ComboBox bandResolutionCombo;
+    mdsp_ui::ChoiceRow bandResolutionRow;
+
     // Weighting
     juce::ComboBox weightingCombo;
     mdsp_ui::ChoiceRow weightingRow;
@@ -37,6 +37,9 @@ HeaderBar::HeaderBar (mdsp_ui::UiContext& ui)
     fftSizeCombo_.addItem ("2048", 2);
     fftSizeCombo_.addItem ("4096", 3);
     fftSizeCombo_.addItem ("8192", 4);
+    fftSizeCombo_.addItem ("16384", 5);
+    fftSizeCombo_.addItem ("32768", 6);
+    fftSizeCombo_.addItem ("65536", 7);
     fftSizeCombo_.setSelectedId (2, juce::dontSendNotification);
     fftSizeCombo_.setTooltip ("FFT Size");
     addAndMakeVisible (fftSizeCombo_);
@@ -0,0 +1,38 @@
+#include "BenchHarness.h"
+#include <cstdlib>
+#include <new>
+
+//==============================================================================
+// Global operator new/delete replacement for the benchmark executable: counts every heap
+// allocation per thread so a case can report allocations per call (the audio paths must
+// stay at zero). Only the allocating forms are counted; delete just frees.
+
+namespace
+{
+    thread_local uint64_t threadAllocations = 0;
+
+    void* countedAlloc (std::size_t size)
+    {
+        ++threadAllocations;
+        if (void* p = std::malloc (size == 0 ? 1 : size))
+            return p;
+        throw std::bad_alloc();
+    }
+}
+
+uint64_t AnalyzerPro::bench::getThreadAllocationCount() noexcept
+{
+    return threadAllocations;
+}
+
+void* operator new (std::size_t size)                                    { return countedAlloc (size); }
+void* operator new[] (std::size_t size)                                  { return countedAlloc (size); }
+void* operator new (std::size_t size, const std::nothrow_t&) noexcept    { ++threadAllocations; return std::malloc (size == 0 ? 1 : size); }
+void* operator new[] (std::size_t size, const std::nothrow_t&) noexcept  { ++threadAllocations; return std::malloc (size == 0 ? 1 : size); }
+
+void operator delete (void* p) noexcept                                  { std::free (p); }
+void operator delete[] (void* p) noexcept                                { std::free (p); }
+void operator delete (void* p, std::size_t) noexcept                     { std::free (p); }
+void operator delete[] (void* p, std::size_t) noexcept                   { std::free (p); }
+void operator delete (void* p, const std::nothrow_t&) noexcept           { std::free (p); }
+void operator delete[] (void* p, const std::nothrow_t&) noexcept         { std::free (p); }
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace AnalyzerPro::bench
+{
+
+//==============================================================================
+/** Heap allocations made by the calling thread since it started (operator new is replaced in
+    AllocationCounter.cpp for the benchmark executable only). */
+uint64_t getThreadAllocationCount() noexcept;
+
+//==============================================================================
+/** One measured case. Times are per call; items are whatever one call processes
+    (samples for audio paths, bins for display paths) so runs with different block or
+    FFT sizes stay comparable. */
+struct Result
+{
+    juce::String name;
+    juce::NamedValueSet params;
+    juce::String item = "sample";
+    int itemsPerCall = 0;
+    int calls = 0;
+
+    double nsPerItem = 0.0;
+    double meanNs = 0.0;
+    double medianNs = 0.0;
+    double p99Ns = 0.0;
+    double worstNs = 0.0;
+    double allocsPerCall = 0.0;
+};
+
+/** Runs fn() warmupCalls times untimed, then timedCalls times with each call timed on its
+    own (worst case and percentiles need per-call times, not just a total). betweenCalls()
+    runs before every call outside the timed region (e.g. draining a FIFO the case fills). */
+template <typename Fn, typename Between>
+Result measure (const juce::String& name, int itemsPerCall, int warmupCalls, int timedCalls, Fn&& fn, Between&& betweenCalls)
+{
+    for (int i = 0; i < warmupCalls; ++i)
+    {
+        betweenCalls();
+        fn();
+    }
+
+    std::vector<double> callNs (static_cast<std::size_t> (juce::jmax (1, timedCalls)));
+    const double ticksToNs = 1.0e9 / static_cast<double> (juce::Time::getHighResolutionTicksPerSecond());
+
+    uint64_t allocs = 0;
+    for (auto& ns : callNs)
+    {
+        betweenCalls();
+        const uint64_t allocsBefore = getThreadAllocationCount();
+        const int64_t t0 = juce::Time::getHighResolutionTicks();
+        fn();
+        ns = static_cast<double> (juce::Time::getHighResolutionTicks() - t0) * ticksToNs;
+        allocs += getThreadAllocationCount() - allocsBefore;
+    }
+
+    Result r;
+    r.name = name;
+    r.itemsPerCall = itemsPerCall;
+    r.calls = static_cast<int> (callNs.size());
+
+    double total = 0.0;
+    for (const double ns : callNs)
+        total += ns;
+    r.meanNs = total / static_cast<double> (callNs.size());
+    r.nsPerItem = itemsPerCall > 0 ? r.meanNs / static_cast<double> (itemsPerCall) : 0.0;
+    r.allocsPerCall = static_cast<double> (allocs) / static_cast<double> (callNs.size());
+
+    std::sort (callNs.begin(), callNs.end());
+    r.medianNs = callNs[callNs.size() / 2];
+    r.p99Ns = callNs[juce::jmin (callNs.size() - 1, (callNs.size() * 99) / 100)];
+    r.worstNs = callNs.back();
+    return r;
+}
+
+template <typename Fn>
+Result measure (const juce::String& name, int itemsPerCall, int warmupCalls, int timedCalls, Fn&& fn)
+{
+    return measure (name, itemsPerCall, warmupCalls, timedCalls, std::forward<Fn> (fn), [] {});
+}
+
+} // namespace AnalyzerPro::bench
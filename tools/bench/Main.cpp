@@ -0,0 +1,403 @@
+#include "BenchHarness.h"
+#include "PluginProcessor.h"
+#include "analyzer/AnalyzerEngine.h"
+#include "dsp/loudness/LoudnessAnalyzer.h"
+#include "ui/analyzer/AnalyzerDisplayView.h"
+#include <iostream>
+
+//==============================================================================
+/**
+    AnalyzerPro_Bench: microbenchmarks for the analyzer hot paths.
+
+    Every case is timed per call (mean / median / p99 / worst), normalised per item and
+    checked for heap allocations, and the whole run is written as one JSON document so two
+    commits can be diffed case by case (cases are keyed by name + params).
+
+    Usage:
+        AnalyzerPro_Bench [--out <file.json>] [--quick] [--filter <substring>]
+
+        --out       Write JSON here and print a table to stdout (default: JSON to stdout)
+        --quick     48 kHz only and shorter runs (smoke test / CI)
+        --filter    Only run cases whose name contains the substring
+*/
+
+//==============================================================================
+/** Private hot paths timed directly (friend of RTADisplay and AnalyzerDisplayView). */
+struct AnalyzerBenchAccess
+{
+    static void updateFromSnapshot (AnalyzerDisplayView& view, const AnalyzerSnapshot& snapshot)
+    {
+        view.updateFromSnapshot (snapshot);
+    }
+
+    static void buildDecimatedPath (RTADisplay& display, const std::vector<float>& data, juce::Path& path)
+    {
+        display.buildDecimatedPath (data, path);
+    }
+};
+
+namespace
+{
+    using AnalyzerPro::bench::Result;
+    using AnalyzerPro::bench::measure;
+
+    struct Options
+    {
+        bool quick = false;
+        juce::String filter;
+        double audioSeconds = 2.0;       // Audio timed per audio-path case
+    };
+
+    //==============================================================================
+    /** Deterministic stereo test signal: partially correlated noise plus a few tones,
+        so Mid/Side, bands and ballistics all see realistic content. */
+    juce::AudioBuffer<float> makeTestSignal (double sampleRate, double seconds)
+    {
+        const int numSamples = static_cast<int> (sampleRate * seconds);
+        juce::AudioBuffer<float> buffer (2, numSamples);
+        juce::Random random (1234);
+
+        float* left = buffer.getWritePointer (0);
+        float* right = buffer.getWritePointer (1);
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const double t = static_cast<double> (i) / sampleRate;
+            const float tones = 0.1f * static_cast<float> (std::sin (juce::MathConstants<double>::twoPi * 100.0 * t)
+                                                           + std::sin (juce::MathConstants<double>::twoPi * 1000.0 * t)
+                                                           + std::sin (juce::MathConstants<double>::twoPi * 8000.0 * t));
+            const float common = 0.2f * (random.nextFloat() * 2.0f - 1.0f);
+            left[i] = tones + common + 0.05f * (random.nextFloat() * 2.0f - 1.0f);
+            right[i] = tones + common + 0.05f * (random.nextFloat() * 2.0f - 1.0f);
+        }
+        return buffer;
+    }
+
+    /** Walks a long signal block by block (wrapping), handing out non-owning views. */
+    struct BlockCursor
+    {
+        const juce::AudioBuffer<float>& signal;
+        int blockSize;
+        int position = 0;
+
+        juce::AudioBuffer<float> next()
+        {
+            if (position + blockSize > signal.getNumSamples())
+                position = 0;
+            float* channels[2] = { const_cast<float*> (signal.getReadPointer (0, position)),
+                                   const_cast<float*> (signal.getReadPointer (1, position)) };
+            position += blockSize;
+            // Referencing constructor: channel pointers live in the buffer's preallocated space (no heap)
+            return juce::AudioBuffer<float> (channels, 2, blockSize);
+        }
+    };
+
+    int callsFor (double sampleRate, int blockSize, const Options& options)
+    {
+        return juce::jlimit (64, 200000, static_cast<int> (options.audioSeconds * sampleRate / blockSize));
+    }
+
+    //==============================================================================
+    void benchEngine (std::vector<Result>& results, const Options& options)
+    {
+        const std::vector<double> rates = options.quick ? std::vector<double> { 48000.0 }
+                                                        : std::vector<double> { 44100.0, 48000.0, 96000.0 };
+
+        for (const double sampleRate : rates)
+        {
+            const auto signal = makeTestSignal (sampleRate, 4.0);
+
+            for (const int fftSize : { 1024, 2048, 4096, 8192 })
+                for (const int blockSize : { 16, 64, 256, 1024, 4096 })
+                    for (const bool multiTrace : { true, false })
+                    {
+                        auto engine = std::make_unique<AnalyzerEngine>();
+                        engine->requestFftSize (fftSize);
+                        engine->setMultiTraceEnabled (multiTrace);
+                        engine->addConsumer (AnalyzerEngine::Product::Spectrum);   // Full pipeline, as with an editor open
+                        engine->addConsumer (AnalyzerEngine::Product::StereoScope);
+                        engine->prepare (sampleRate, blockSize);
+
+                        BlockCursor cursor { signal, blockSize };
+                        const int warmup = (2 * fftSize) / blockSize + 8;   // Fill the FIFO and seed ballistics
+
+                        auto r = measure ("engine.processBlock", blockSize, warmup, callsFor (sampleRate, blockSize, options),
+                                          [&] { engine->processBlock (cursor.next()); });
+                        r.params.set ("sampleRate", sampleRate);
+                        r.params.set ("fftSize", fftSize);
+                        r.params.set ("blockSize", blockSize);
+                        r.params.set ("multiTrace", multiTrace);
+                        results.push_back (std::move (r));
+                    }
+        }
+    }
+
+    void benchLoudness (std::vector<Result>& results, const Options& options)
+    {
+        const double sampleRate = 48000.0;
+        const auto signal = makeTestSignal (sampleRate, 4.0);
+
+        for (const int blockSize : { 64, 512, 4096 })
+        {
+            AnalyzerPro::dsp::LoudnessAnalyzer loudness;
+            loudness.prepare (sampleRate, blockSize);
+            BlockCursor cursor { signal, blockSize };
+
+            auto r = measure ("loudness.process", blockSize, 16, callsFor (sampleRate, blockSize, options),
+                              [&] { loudness.process (cursor.next()); });
+            r.params.set ("sampleRate", sampleRate);
+            r.params.set ("blockSize", blockSize);
+            results.push_back (std::move (r));
+        }
+    }
+
+    void benchScope (std::vector<Result>& results, const Options& options)
+    {
+        const double sampleRate = 48000.0;
+        const auto signal = makeTestSignal (sampleRate, 4.0);
+        std::vector<float> destLeft (16384), destRight (16384);
+
+        for (const int blockSize : { 64, 512, 4096 })
+        {
+            StereoScopeAnalyzer scope;
+            BlockCursor cursor { signal, blockSize };
+            int pushed = 0;
+
+            // Drain between calls (untimed) so every push lands in a FIFO with room, as with a live UI
+            auto r = measure ("scope.pushSamples", blockSize, 16, callsFor (sampleRate, blockSize, options),
+                              [&]
+                              {
+                                  const auto block = cursor.next();
+                                  scope.pushSamples (block.getReadPointer (0), block.getReadPointer (1), blockSize);
+                                  pushed += blockSize;
+                              },
+                              [&]
+                              {
+                                  if (pushed + blockSize > 8192)
+                                  {
+                                      scope.getSnapshot (destLeft, destRight, 8192);
+                                      pushed = 0;
+                                  }
+                              });
+            r.params.set ("blockSize", blockSize);
+            results.push_back (std::move (r));
+        }
+
+        for (const int numToRead : { 512, 2048, 8192 })
+        {
+            StereoScopeAnalyzer scope;
+            BlockCursor cursor { signal, 800 };   // ~one 60 Hz UI frame of audio at 48 kHz between reads
+
+            auto r = measure ("scope.getSnapshot", numToRead, 16, options.quick ? 500 : 2000,
+                              [&] { scope.getSnapshot (destLeft, destRight, numToRead); },
+                              [&]
+                              {
+                                  for (int i = 0; i < 3; ++i)
+                                  {
+                                      const auto block = cursor.next();
+                                      scope.pushSamples (block.getReadPointer (0), block.getReadPointer (1), 800);
+                                  }
+                              });
+            r.params.set ("numSamplesToRead", numToRead);
+            results.push_back (std::move (r));
+        }
+    }
+
+    //==============================================================================
+    void benchDisplay (std::vector<Result>& results, const Options& options)
+    {
+        const double sampleRate = 48000.0;
+        const auto signal = makeTestSignal (sampleRate, 4.0);
+        const int calls = options.quick ? 300 : 1500;
+
+        AnalayzerProAudioProcessor processor;
+
+        for (const int fftSize : { 2048, 8192 })
+            for (const bool multiTrace : { true, false })
+            {
+                // A realistic frame straight from the engine
+                AnalyzerEngine engine;
+                engine.requestFftSize (fftSize);
+                engine.setMultiTraceEnabled (multiTrace);
+                engine.addConsumer (AnalyzerEngine::Product::Spectrum);
+                engine.prepare (sampleRate, 512);
+                BlockCursor cursor { signal, 512 };
+                for (int i = 0; i < static_cast<int> (sampleRate) / 512; ++i)
+                    engine.processBlock (cursor.next());
+
+                AnalyzerSnapshot snapshot;
+                if (! engine.getLatestSnapshot (snapshot))
+                    continue;
+
+                RTADisplay::TraceConfig traces;
+                traces.showL = traces.showR = traces.showMid = traces.showSide = multiTrace;
+                traces.showRMS = true;
+
+                for (const int width : { 800, 1600 })
+                    for (const auto mode : { AnalyzerDisplayView::Mode::FFT, AnalyzerDisplayView::Mode::LOG, AnalyzerDisplayView::Mode::BAND })
+                    {
+                        AnalyzerDisplayView view (processor);
+                        view.setSize (width, width / 2);
+                        view.setMode (mode);
+                        view.getRTADisplay().setTraceConfig (traces);
+
+                        auto r = measure ("display.updateFromSnapshot", fftSize / 2 + 1, 16, calls,
+                                          [&] { AnalyzerBenchAccess::updateFromSnapshot (view, snapshot); });
+                        r.item = "bin";
+                        r.params.set ("fftSize", fftSize);
+                        r.params.set ("multiTrace", multiTrace);
+                        r.params.set ("width", width);
+                        r.params.set ("mode", mode == AnalyzerDisplayView::Mode::FFT ? "FFT" : (mode == AnalyzerDisplayView::Mode::LOG ? "LOG" : "BAND"));
+                        results.push_back (std::move (r));
+
+                        view.shutdown();
+                    }
+            }
+
+        // Decimated FFT path at typical plot widths
+        juce::Random random (99);
+        for (const int fftSize : { 2048, 8192, 32768 })
+        {
+            std::vector<float> binsDb (static_cast<std::size_t> (fftSize / 2 + 1));
+            for (auto& db : binsDb)
+                db = -90.0f + 60.0f * random.nextFloat();
+
+            for (const int width : { 600, 1200, 2400 })
+            {
+                RTADisplay display;
+                display.setSize (width, 400);
+                display.setFftMeta (sampleRate, fftSize);
+                display.setFrequencyRange (20.0f, 20000.0f);
+                display.setDbRange (0.0f, -120.0f);
+                display.setViewMode (0);
+                juce::Path path;
+
+                auto r = measure ("rta.buildDecimatedPath", static_cast<int> (binsDb.size()), 16, calls,
+                                  [&] { AnalyzerBenchAccess::buildDecimatedPath (display, binsDb, path); });
+                r.item = "bin";
+                r.params.set ("fftSize", fftSize);
+                r.params.set ("width", width);
+                results.push_back (std::move (r));
+            }
+        }
+    }
+
+    //==============================================================================
+    juce::var toJson (const std::vector<Result>& results, const Options& options)
+    {
+        auto* root = new juce::DynamicObject();
+        root->setProperty ("schema", 1);
+        root->setProperty ("timestamp", juce::Time::getCurrentTime().toISO8601 (true));
+        root->setProperty ("cpu", juce::SystemStats::getCpuModel());
+        root->setProperty ("cores", juce::SystemStats::getNumCpus());
+        root->setProperty ("os", juce::SystemStats::getOperatingSystemName());
+       #if JUCE_DEBUG
+        root->setProperty ("build", "Debug");
+       #else
+        root->setProperty ("build", "Release");
+       #endif
+        root->setProperty ("quick", options.quick);
+
+        juce::Array<juce::var> cases;
+        for (const auto& r : results)
+        {
+            auto* params = new juce::DynamicObject();
+            for (const auto& p : r.params)
+                params->setProperty (p.name, p.value);
+
+            auto* c = new juce::DynamicObject();
+            c->setProperty ("name", r.name);
+            c->setProperty ("params", juce::var (params));
+            c->setProperty ("item", r.item);
+            c->setProperty ("itemsPerCall", r.itemsPerCall);
+            c->setProperty ("calls", r.calls);
+            c->setProperty ("nsPerItem", r.nsPerItem);
+            c->setProperty ("meanNs", r.meanNs);
+            c->setProperty ("medianNs", r.medianNs);
+            c->setProperty ("p99Ns", r.p99Ns);
+            c->setProperty ("worstNs", r.worstNs);
+            c->setProperty ("allocsPerCall", r.allocsPerCall);
+            cases.add (juce::var (c));
+        }
+        root->setProperty ("results", cases);
+        return juce::var (root);
+    }
+
+    juce::String describe (const Result& r)
+    {
+        juce::String line = r.name.paddedRight (' ', 28);
+        juce::StringArray params;
+        for (const auto& p : r.params)
+            params.add (p.name.toString() + "=" + p.value.toString());
+        line << params.joinIntoString (" ").paddedRight (' ', 56)
+             << juce::String (r.nsPerItem, 2).paddedLeft (' ', 10) << " ns/" << r.item
+             << "  worst " << juce::String (r.worstNs / 1000.0, 1) << " us"
+             << "  allocs " << juce::String (r.allocsPerCall, 2);
+        return line;
+    }
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    // Components (RTADisplay, AnalyzerDisplayView) need the message manager
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    Options options;
+    juce::File outFile;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const juce::String arg (argv[i]);
+        if (arg == "--quick")                          options.quick = true;
+        else if (arg == "--out" && i + 1 < argc)       outFile = juce::File::getCurrentWorkingDirectory().getChildFile (argv[++i]);
+        else if (arg == "--filter" && i + 1 < argc)    options.filter = argv[++i];
+        else
+        {
+            std::cerr << "Usage: AnalyzerPro_Bench [--out file.json] [--quick] [--filter substring]\n";
+            return 2;
+        }
+    }
+
+    if (options.quick)
+        options.audioSeconds = 0.5;
+
+    // A group runs if any of its case names matches the filter
+    const auto wanted = [&options] (std::initializer_list<const char*> caseNames)
+    {
+        if (options.filter.isEmpty())
+            return true;
+        for (const auto* name : caseNames)
+            if (juce::String (name).contains (options.filter))
+                return true;
+        return false;
+    };
+
+    std::vector<Result> results;
+    if (wanted ({ "engine.processBlock" }))                                benchEngine (results, options);
+    if (wanted ({ "loudness.process" }))                                   benchLoudness (results, options);
+    if (wanted ({ "scope.pushSamples", "scope.getSnapshot" }))             benchScope (results, options);
+    if (wanted ({ "display.updateFromSnapshot", "rta.buildDecimatedPath" })) benchDisplay (results, options);
+
+    if (options.filter.isNotEmpty())
+        results.erase (std::remove_if (results.begin(), results.end(),
+                                       [&] (const Result& r) { return ! r.name.contains (options.filter); }),
+                       results.end());
+
+    const auto json = juce::JSON::toString (toJson (results, options));
+
+    if (outFile == juce::File())
+    {
+        std::cout << json << "\n";
+        return 0;
+    }
+
+    for (const auto& r : results)
+        std::cout << describe (r) << "\n";
+
+    if (! outFile.replaceWithText (json))
+    {
+        std::cerr << "Cannot write " << outFile.getFullPathName() << "\n";
+        return 1;
+    }
+    return 0;
+}
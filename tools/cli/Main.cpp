@@ -0,0 +1,284 @@
+#include "OfflineAnalysis.h"
+#include <atomic>
+#include <cmath>
+#include <iostream>
+
+//==============================================================================
+/**
+    AnalyzerPro_Cli: headless batch analysis of audio files.
+
+    Runs the plugin's analysis core (AnalyzerEngine, LoudnessAnalyzer) over WAV/AIFF/FLAC
+    files with no GUI modules. Files longer than --chunk seconds are split into chunks that
+    each get their own engine and a --warmup pre-roll, and every chunk of every file is a
+    job on one thread pool, so a single long file uses all cores as well as a folder does.
+
+    Usage:
+        AnalyzerPro_Cli [options] <file> [<file> ...]
+
+        --fft <n>               FFT size (default 8192)
+        --block <n>             Emulated host block size (default 1024)
+        --jobs <n>              Worker threads (default: all cores)
+        --chunk <seconds>       Chunk length (default 120)
+        --warmup <seconds>      Pre-roll per chunk (default 3)
+        --out <dir>             Output directory (default: next to each file)
+        --format json|csv|both  Output format (default json)
+        --self-check            Analyse a generated file with a long digitally silent tail
+                                (chunked) and check the LTAS span and level; exit code 1 on failure
+*/
+namespace
+{
+    void printUsage()
+    {
+        std::cout << "Usage: AnalyzerPro_Cli [--fft n] [--block n] [--jobs n] [--chunk s] [--warmup s]\n"
+                     "                       [--out dir] [--format json|csv|both] <file> [<file> ...]\n"
+                     "       AnalyzerPro_Cli --self-check\n";
+    }
+
+    /** 4 s of 1 kHz tone then 26 s of digital silence, in 10 s chunks: the last two chunks (and the
+        second one's warm-up) are entirely silent, so the engine idles through them. The merged
+        LTAS must still span the whole file, and the tone's band must be diluted by the tail. */
+    int runSelfCheck (AnalyzerPro::offline::Settings settings)
+    {
+        using namespace AnalyzerPro::offline;
+
+        constexpr double sampleRate = 48000.0;
+        constexpr double toneSeconds = 4.0;
+        constexpr double totalSeconds = 30.0;
+        const auto toneSamples = static_cast<int64_t> (toneSeconds * sampleRate);
+        const auto totalSamples = static_cast<int64_t> (totalSeconds * sampleRate);
+
+        const auto file = juce::File::createTempFile (".wav");
+        {
+            std::unique_ptr<juce::OutputStream> stream = std::make_unique<juce::FileOutputStream> (file);
+            auto writer = juce::WavAudioFormat().createWriterFor (stream, juce::AudioFormatWriterOptions()
+                                                                              .withSampleRate (sampleRate)
+                                                                              .withNumChannels (2)
+                                                                              .withBitsPerSample (24));
+            if (writer == nullptr)
+            {
+                std::cerr << "self-check: cannot write " << file.getFullPathName() << "\n";
+                return 1;
+            }
+
+            juce::AudioBuffer<float> block (2, 4800);
+            for (int64_t position = 0; position < totalSamples; position += block.getNumSamples())
+            {
+                for (int i = 0; i < block.getNumSamples(); ++i)
+                {
+                    const int64_t n = position + i;
+                    const float s = (n < toneSamples)
+                                        ? 0.1f * static_cast<float> (std::sin (juce::MathConstants<double>::twoPi * 1000.0 * static_cast<double> (n) / sampleRate))
+                                        : 0.0f;
+                    block.setSample (0, i, s);
+                    block.setSample (1, i, s);
+                }
+                writer->writeFromAudioSampleBuffer (block, 0, block.getNumSamples());
+            }
+        }
+
+        settings.chunkSeconds = 10.0;
+        std::vector<RangeResult> chunks;
+        for (const auto& range : splitIntoChunks (totalSamples, sampleRate, settings))
+            chunks.push_back (analyseRange (file, settings, range.first, range.second));
+        const auto merged = mergeRanges (chunks);
+        const auto tone = analyseRange (file, settings, 0, toneSamples);
+        file.deleteFile();
+
+        if (! merged.ok || ! tone.ok)
+        {
+            std::cerr << "self-check: analysis failed (" << merged.error << tone.error << ")\n";
+            return 1;
+        }
+
+        int failures = 0;
+        auto expect = [&failures] (bool ok, const juce::String& what)
+        {
+            std::cout << (ok ? "PASS " : "FAIL ") << what << "\n";
+            failures += ok ? 0 : 1;
+        };
+
+        // LTAS spans count whole hops from the first hop of each chunk: allow one FFT per chunk
+        const double spanTolerance = static_cast<double> (chunks.size() * static_cast<std::size_t> (settings.fftSize)) / sampleRate;
+        expect (std::abs (merged.ltasSeconds - totalSeconds) <= spanTolerance,
+                "LTAS span " + juce::String (merged.ltasSeconds, 2) + " s of " + juce::String (totalSeconds, 1) + " s");
+
+        // Tone band diluted by the silent tail: tone-only level x tone share of the span
+        std::size_t band = 0;
+        for (std::size_t b = 1; b < tone.ltasBandPower.size(); ++b)
+            if (tone.ltasBandPower[b] > tone.ltasBandPower[band])
+                band = b;
+
+        const double expectedDb = 10.0 * std::log10 (tone.ltasBandPower[band] * tone.ltasSeconds / merged.ltasSeconds);
+        const double actualDb = 10.0 * std::log10 (juce::jmax (1e-30, merged.ltasBandPower[band]));
+        expect (std::abs (actualDb - expectedDb) <= 0.5,
+                "LTAS tone band " + juce::String (actualDb, 2) + " dB, expected " + juce::String (expectedDb, 2) + " dB");
+
+        return failures == 0 ? 0 : 1;
+    }
+
+    struct Job
+    {
+        std::size_t fileIndex = 0;
+        std::size_t chunkIndex = 0;
+        int64_t start = 0;
+        int64_t end = 0;
+    };
+}
+
+int main (int argc, char* argv[])
+{
+    using namespace AnalyzerPro::offline;
+
+    Settings settings;
+    int numThreads = juce::SystemStats::getNumCpus();
+    juce::File outputDirectory;
+    juce::String format ("json");
+    juce::Array<juce::File> inputs;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const juce::String arg (argv[i]);
+        const bool hasValue = (i + 1 < argc);
+
+        if (arg == "--help" || arg == "-h")            { printUsage(); return 0; }
+        else if (arg == "--self-check")                return runSelfCheck (settings);
+        else if (arg == "--fft" && hasValue)           settings.fftSize = juce::String (argv[++i]).getIntValue();
+        else if (arg == "--block" && hasValue)         settings.blockSize = juce::String (argv[++i]).getIntValue();
+        else if (arg == "--jobs" && hasValue)          numThreads = juce::jmax (1, juce::String (argv[++i]).getIntValue());
+        else if (arg == "--chunk" && hasValue)         settings.chunkSeconds = juce::jmax (1.0, juce::String (argv[++i]).getDoubleValue());
+        else if (arg == "--warmup" && hasValue)        settings.warmupSeconds = juce::jmax (0.0, juce::String (argv[++i]).getDoubleValue());
+        else if (arg == "--out" && hasValue)           outputDirectory = juce::File::getCurrentWorkingDirectory().getChildFile (argv[++i]);
+        else if (arg == "--format" && hasValue)        format = juce::String (argv[++i]).toLowerCase();
+        else if (arg.startsWith ("--"))
+        {
+            std::cerr << "Unknown or incomplete option: " << arg << "\n";
+            printUsage();
+            return 2;
+        }
+        else
+        {
+            inputs.add (juce::File::getCurrentWorkingDirectory().getChildFile (arg));
+        }
+    }
+
+    if (inputs.isEmpty() || ! (format == "json" || format == "csv" || format == "both"))
+    {
+        printUsage();
+        return 2;
+    }
+
+    if (outputDirectory != juce::File() && ! outputDirectory.createDirectory())
+    {
+        std::cerr << "Cannot create output directory " << outputDirectory.getFullPathName() << "\n";
+        return 1;
+    }
+
+    //==============================================================================
+    // Probe files and plan the chunk jobs
+    std::vector<FileResult> files (static_cast<std::size_t> (inputs.size()));
+    std::vector<std::vector<RangeResult>> chunkResults (files.size());
+    std::vector<std::vector<double>> chunkSeconds (files.size());
+    std::vector<Job> jobs;
+    {
+        juce::AudioFormatManager formats;
+        formats.registerBasicFormats();
+
+        for (std::size_t f = 0; f < files.size(); ++f)
+        {
+            auto& file = files[f];
+            file.file = inputs[static_cast<int> (f)];
+
+            std::unique_ptr<juce::AudioFormatReader> reader (formats.createReaderFor (file.file));
+            if (reader == nullptr)
+            {
+                file.result.error = "unsupported or unreadable file";
+                continue;
+            }
+
+            file.sampleRate = reader->sampleRate;
+            file.lengthSamples = reader->lengthInSamples;
+            file.numChannels = static_cast<int> (reader->numChannels);
+
+            const auto chunks = splitIntoChunks (file.lengthSamples, file.sampleRate, settings);
+            chunkResults[f].resize (chunks.size());
+            chunkSeconds[f].resize (chunks.size(), 0.0);
+            for (std::size_t c = 0; c < chunks.size(); ++c)
+                jobs.push_back ({ f, c, chunks[c].first, chunks[c].second });
+        }
+    }
+
+    //==============================================================================
+    // Run every chunk of every file on one pool (results land in preallocated slots)
+    const double wallStart = juce::Time::getMillisecondCounterHiRes();
+    {
+        juce::ThreadPool pool (numThreads);
+        for (const auto& job : jobs)
+        {
+            pool.addJob ([&, job]
+            {
+                const double t0 = juce::Time::getMillisecondCounterHiRes();
+                chunkResults[job.fileIndex][job.chunkIndex] = analyseRange (files[job.fileIndex].file, settings, job.start, job.end);
+                chunkSeconds[job.fileIndex][job.chunkIndex] = (juce::Time::getMillisecondCounterHiRes() - t0) * 0.001;
+            });
+        }
+
+        while (pool.getNumJobs() > 0)
+            juce::Thread::sleep (20);
+    }
+    const double wallSeconds = (juce::Time::getMillisecondCounterHiRes() - wallStart) * 0.001;
+
+    //==============================================================================
+    // Merge per file and write outputs
+    int failures = 0;
+    double totalAudioSeconds = 0.0;
+
+    for (std::size_t f = 0; f < files.size(); ++f)
+    {
+        auto& file = files[f];
+        if (! chunkResults[f].empty())
+        {
+            file.result = mergeRanges (chunkResults[f]);
+            for (const double s : chunkSeconds[f])
+                file.processingSeconds += s;
+        }
+        else if (file.result.error.isEmpty())
+        {
+            file.result.error = "empty file";
+        }
+
+        const auto dir = (outputDirectory != juce::File()) ? outputDirectory : file.file.getParentDirectory();
+
+        if (format == "json" || format == "both")
+        {
+            const auto json = juce::JSON::toString (toJson (file, settings));
+            if (! dir.getChildFile (file.file.getFileNameWithoutExtension() + ".analysis.json").replaceWithText (json))
+                file.result.error = "cannot write JSON output";
+        }
+        if ((format == "csv" || format == "both") && file.result.ok)
+        {
+            if (! writeCsv (file, settings, dir))
+                file.result.error = "cannot write CSV output";
+        }
+
+        if (! file.result.ok || file.result.error.isNotEmpty())
+        {
+            ++failures;
+            std::cerr << file.file.getFullPathName() << ": " << file.result.error << "\n";
+            continue;
+        }
+
+        const double seconds = static_cast<double> (file.lengthSamples) / file.sampleRate;
+        totalAudioSeconds += seconds;
+        std::cout << file.file.getFileName()
+                  << "  I " << juce::String (meanSquareToLufs (file.result.integratedMeanSquare), 1) << " LUFS"
+                  << "  TP " << juce::String (file.result.truePeakDb, 1) << " dBTP"
+                  << "  " << juce::String (seconds, 1) << " s"
+                  << "  (" << chunkResults[f].size() << " chunk" << (chunkResults[f].size() == 1 ? "" : "s") << ")\n";
+    }
+
+    std::cout << juce::String (totalAudioSeconds, 1) << " s of audio in " << juce::String (wallSeconds, 2)
+              << " s on " << numThreads << " threads ("
+              << juce::String (wallSeconds > 0.0 ? totalAudioSeconds / wallSeconds : 0.0, 1) << "x realtime)\n";
+
+    return failures == 0 ? 0 : 1;
+}
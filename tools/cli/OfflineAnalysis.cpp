@@ -0,0 +1,383 @@
+#include "OfflineAnalysis.h"
+#include "analyzer/AnalyzerEngine.h"
+#include "dsp/loudness/LoudnessAnalyzer.h"
+#include <algorithm>
+#include <cmath>
+
+namespace AnalyzerPro::offline
+{
+
+//==============================================================================
+void LevelHistogram::add (float db) noexcept
+{
+    const int bin = static_cast<int> (std::floor ((db - kMinDb) / kStepDb));
+    ++counts[static_cast<std::size_t> (juce::jlimit (0, kNumBins - 1, bin))];
+}
+
+void LevelHistogram::merge (const LevelHistogram& other) noexcept
+{
+    for (std::size_t i = 0; i < counts.size(); ++i)
+        counts[i] += other.counts[i];
+}
+
+float LevelHistogram::percentile (float p) const noexcept
+{
+    uint64_t total = 0;
+    for (const auto c : counts)
+        total += c;
+    if (total == 0)
+        return kMinDb;
+
+    const double target = juce::jlimit (0.0, 1.0, static_cast<double> (p)) * static_cast<double> (total);
+    uint64_t running = 0;
+    for (int i = 0; i < kNumBins; ++i)
+    {
+        running += counts[static_cast<std::size_t> (i)];
+        if (static_cast<double> (running) >= target)
+            return kMinDb + kStepDb * (static_cast<float> (i) + 0.5f);
+    }
+    return kMinDb + kStepDb * static_cast<float> (kNumBins);
+}
+
+float meanSquareToLufs (double meanSquare) noexcept
+{
+    // Same mapping and floor as LoudnessAnalyzer::unitsToLufs
+    if (meanSquare <= 1e-10)
+        return -100.0f;
+    return -0.691f + 10.0f * static_cast<float> (std::log10 (meanSquare));
+}
+
+//==============================================================================
+RangeResult analyseRange (const juce::File& file, const Settings& settings, int64_t start, int64_t end)
+{
+    RangeResult range;
+    range.startSample = start;
+    range.numSamples = juce::jmax<int64_t> (0, end - start);
+
+    juce::AudioFormatManager formats;
+    formats.registerBasicFormats();
+    std::unique_ptr<juce::AudioFormatReader> reader (formats.createReaderFor (file));
+    if (reader == nullptr)
+    {
+        range.error = "unsupported or unreadable file";
+        return range;
+    }
+
+    const double sampleRate = reader->sampleRate;
+    const int blockSize = juce::jmax (16, settings.blockSize);
+    const int64_t warmStart = juce::jmax<int64_t> (0, start - static_cast<int64_t> (settings.warmupSeconds * sampleRate));
+    const int64_t intervalSamples = juce::jmax<int64_t> (1, juce::roundToInt (settings.curveIntervalSeconds * sampleRate));
+
+    // Engine: inline analysis (no worker thread), LTAS on, filter bank / multi-res off
+    auto engine = std::make_unique<AnalyzerEngine>();
+    engine->requestFftSize (settings.fftSize);
+    engine->setLtasEnabled (true);
+    engine->addConsumer (AnalyzerEngine::Product::Spectrum);
+    engine->prepare (sampleRate, blockSize);
+
+    AnalyzerPro::dsp::LoudnessAnalyzer loudness;
+    loudness.prepare (sampleRate, blockSize);
+
+    // True peak: 4x (two half-band stages), BS.1770 style
+    juce::dsp::Oversampling<float> oversampler (2, 2, juce::dsp::Oversampling<float>::filterHalfBandFIREquiripple, true, false);
+    oversampler.initProcessing (static_cast<std::size_t> (blockSize));
+
+    juce::AudioBuffer<float> buffer (2, blockSize);
+
+    int64_t position = warmStart;
+    bool measuring = (warmStart == start);
+    int64_t measured = 0;
+    int64_t nextTick = intervalSamples;
+
+    while (position < end)
+    {
+        int numSamples = static_cast<int> (juce::jmin<int64_t> (blockSize, end - position));
+        if (! measuring)
+            numSamples = static_cast<int> (juce::jmin<int64_t> (numSamples, start - position));
+
+        // Mono files are duplicated into both channels by the reader
+        if (! reader->read (&buffer, 0, numSamples, position, true, true))
+        {
+            range.error = "read error at sample " + juce::String (position);
+            return range;
+        }
+
+        juce::AudioBuffer<float> block (buffer.getArrayOfWritePointers(), 2, numSamples);
+        engine->processBlock (block);
+        loudness.process (block);
+
+        juce::dsp::AudioBlock<float> audioBlock (block);
+        const auto upsampled = oversampler.processSamplesUp (audioBlock);
+
+        position += numSamples;
+
+        if (! measuring)
+        {
+            // Warm-up done: restart the accumulating measurements, keep filter/window state
+            if (position == start)
+            {
+                measuring = true;
+                engine->resetLtas();
+                loudness.resetIntegrated();
+                loudness.resetPeak();
+            }
+            continue;
+        }
+
+        range.samplePeakDb = juce::jmax (range.samplePeakDb, juce::Decibels::gainToDecibels (block.getMagnitude (0, numSamples), -100.0f));
+        for (std::size_t ch = 0; ch < upsampled.getNumChannels(); ++ch)
+        {
+            const auto minMax = juce::FloatVectorOperations::findMinAndMax (upsampled.getChannelPointer (ch),
+                                                                            static_cast<int> (upsampled.getNumSamples()));
+            const float magnitude = juce::jmax (std::abs (minMax.getStart()), std::abs (minMax.getEnd()));
+            range.truePeakDb = juce::jmax (range.truePeakDb, juce::Decibels::gainToDecibels (magnitude, -100.0f));
+        }
+
+        measured += numSamples;
+        while (measured >= nextTick)
+        {
+            nextTick += intervalSamples;
+
+            const auto lufs = loudness.getSnapshot();
+            range.momentaryLufs.push_back (lufs.momentaryLufs);
+            range.shortTermLufs.push_back (lufs.shortTermLufs);
+
+            using Trace = AnalyzerSnapshot::Trace;
+            const AnalyzerSnapshot* snapshot = engine->acquireLatestSnapshot();
+            if (snapshot != nullptr && snapshot->getTraceLength (Trace::BandsDb) == RangeResult::kNumBands)
+            {
+                const float* bandsDb = snapshot->getTrace (Trace::BandsDb);
+                for (int b = 0; b < RangeResult::kNumBands; ++b)
+                {
+                    const auto idx = static_cast<std::size_t> (b);
+                    range.bandMaxDb[idx] = juce::jmax (range.bandMaxDb[idx], bandsDb[b]);
+                    range.bandHistograms[idx].add (bandsDb[b]);
+                }
+            }
+        }
+    }
+
+    // LTAS totals straight from the engine: the last snapshot can lag the end of the range by a
+    // hop, and by up to the idle refresh interval when the range ends in digital silence
+    {
+        std::array<float, RangeResult::kNumBands> bandPower {};
+        std::array<float, RangeResult::kNumLogPoints> logPower {};
+        range.ltasSeconds = engine->readLtasPower (bandPower.data(), logPower.data());
+        for (std::size_t i = 0; i < logPower.size(); ++i)
+            range.ltasLogPower[i] = static_cast<double> (logPower[i]);
+        for (std::size_t i = 0; i < bandPower.size(); ++i)
+            range.ltasBandPower[i] = static_cast<double> (bandPower[i]);
+    }
+
+    const float integrated = loudness.getSnapshot().integratedLufs;
+    range.integratedMeanSquare = (integrated > -100.0f) ? std::pow (10.0, (static_cast<double> (integrated) + 0.691) / 10.0) : 0.0;
+    range.ok = true;
+    return range;
+}
+
+//==============================================================================
+RangeResult mergeRanges (const std::vector<RangeResult>& ranges)
+{
+    RangeResult merged;
+    if (ranges.empty())
+        return merged;
+
+    merged.startSample = ranges.front().startSample;
+    merged.ok = true;
+
+    double loudnessWeighted = 0.0;
+    for (const auto& r : ranges)
+    {
+        if (! r.ok)
+        {
+            merged.ok = false;
+            merged.error = r.error;
+            return merged;
+        }
+
+        merged.numSamples += r.numSamples;
+
+        // Time-weighted power means
+        for (std::size_t i = 0; i < merged.ltasLogPower.size(); ++i)
+            merged.ltasLogPower[i] += r.ltasLogPower[i] * r.ltasSeconds;
+        for (std::size_t i = 0; i < merged.ltasBandPower.size(); ++i)
+            merged.ltasBandPower[i] += r.ltasBandPower[i] * r.ltasSeconds;
+        merged.ltasSeconds += r.ltasSeconds;
+
+        for (std::size_t b = 0; b < merged.bandMaxDb.size(); ++b)
+        {
+            merged.bandMaxDb[b] = juce::jmax (merged.bandMaxDb[b], r.bandMaxDb[b]);
+            merged.bandHistograms[b].merge (r.bandHistograms[b]);
+        }
+
+        // Chunks are whole curve intervals long, so the curves simply concatenate
+        merged.momentaryLufs.insert (merged.momentaryLufs.end(), r.momentaryLufs.begin(), r.momentaryLufs.end());
+        merged.shortTermLufs.insert (merged.shortTermLufs.end(), r.shortTermLufs.begin(), r.shortTermLufs.end());
+
+        loudnessWeighted += r.integratedMeanSquare * static_cast<double> (r.numSamples);
+        merged.samplePeakDb = juce::jmax (merged.samplePeakDb, r.samplePeakDb);
+        merged.truePeakDb = juce::jmax (merged.truePeakDb, r.truePeakDb);
+    }
+
+    if (merged.ltasSeconds > 0.0)
+    {
+        for (auto& p : merged.ltasLogPower)
+            p /= merged.ltasSeconds;
+        for (auto& p : merged.ltasBandPower)
+            p /= merged.ltasSeconds;
+    }
+
+    if (merged.numSamples > 0)
+        merged.integratedMeanSquare = loudnessWeighted / static_cast<double> (merged.numSamples);
+
+    return merged;
+}
+
+std::vector<std::pair<int64_t, int64_t>> splitIntoChunks (int64_t lengthSamples, double sampleRate, const Settings& settings)
+{
+    const int64_t interval = juce::jmax<int64_t> (1, juce::roundToInt (settings.curveIntervalSeconds * sampleRate));
+    const int64_t chunk = juce::jmax<int64_t> (1, static_cast<int64_t> (settings.chunkSeconds * sampleRate) / interval) * interval;
+
+    std::vector<std::pair<int64_t, int64_t>> chunks;
+    for (int64_t start = 0; start < lengthSamples; start += chunk)
+        chunks.emplace_back (start, juce::jmin (lengthSamples, start + chunk));
+
+    // A short tail is not worth its own warm-up: fold it into the previous chunk
+    if (chunks.size() > 1 && (chunks.back().second - chunks.back().first) < chunk / 4)
+    {
+        const int64_t tailEnd = chunks.back().second;
+        chunks.pop_back();
+        chunks.back().second = tailEnd;
+    }
+
+    return chunks;
+}
+
+//==============================================================================
+namespace
+{
+    double powerToDb (double power) noexcept
+    {
+        return power > 1e-12 ? 10.0 * std::log10 (power) : -120.0;
+    }
+
+    juce::var roundedDb (double db)
+    {
+        return std::round (db * 100.0) / 100.0;
+    }
+}
+
+juce::var toJson (const FileResult& file, const Settings& settings)
+{
+    const auto& r = file.result;
+    auto* root = new juce::DynamicObject();
+    root->setProperty ("file", file.file.getFullPathName());
+    root->setProperty ("ok", r.ok);
+    if (! r.ok)
+    {
+        root->setProperty ("error", r.error);
+        return juce::var (root);
+    }
+
+    const double seconds = file.sampleRate > 0.0 ? static_cast<double> (file.lengthSamples) / file.sampleRate : 0.0;
+    root->setProperty ("sampleRate", file.sampleRate);
+    root->setProperty ("channels", file.numChannels);
+    root->setProperty ("durationSec", seconds);
+    root->setProperty ("fftSize", settings.fftSize);
+    root->setProperty ("processingSec", file.processingSeconds);
+    root->setProperty ("realtimeFactor", file.processingSeconds > 0.0 ? seconds / file.processingSeconds : 0.0);
+
+    auto* loudness = new juce::DynamicObject();
+    loudness->setProperty ("integratedLufs", roundedDb (meanSquareToLufs (r.integratedMeanSquare)));
+    loudness->setProperty ("samplePeakDb", roundedDb (r.samplePeakDb));
+    loudness->setProperty ("truePeakDb", roundedDb (r.truePeakDb));
+    loudness->setProperty ("curveIntervalSec", settings.curveIntervalSeconds);
+    juce::Array<juce::var> momentary, shortTerm;
+    for (const float v : r.momentaryLufs)
+        momentary.add (roundedDb (v));
+    for (const float v : r.shortTermLufs)
+        shortTerm.add (roundedDb (v));
+    loudness->setProperty ("momentaryLufs", momentary);
+    loudness->setProperty ("shortTermLufs", shortTerm);
+    root->setProperty ("loudness", juce::var (loudness));
+
+    auto* ltas = new juce::DynamicObject();
+    ltas->setProperty ("durationSec", r.ltasSeconds);
+    juce::Array<juce::var> logHz, logDb;
+    for (int i = 0; i < RangeResult::kNumLogPoints; ++i)
+    {
+        logHz.add (std::round (SpectrumResampler::getLogPointFrequency (i) * 10.0) / 10.0);
+        logDb.add (roundedDb (powerToDb (r.ltasLogPower[static_cast<std::size_t> (i)])));
+    }
+    ltas->setProperty ("frequencyHz", logHz);
+    ltas->setProperty ("db", logDb);
+    root->setProperty ("ltas", juce::var (ltas));
+
+    juce::Array<juce::var> bands;
+    const auto& centres = SpectrumResampler::getBandCentresHz();
+    for (int b = 0; b < RangeResult::kNumBands; ++b)
+    {
+        const auto idx = static_cast<std::size_t> (b);
+        auto* band = new juce::DynamicObject();
+        band->setProperty ("centreHz", centres[idx]);
+        band->setProperty ("ltasDb", roundedDb (powerToDb (r.ltasBandPower[idx])));
+        band->setProperty ("maxDb", roundedDb (r.bandMaxDb[idx]));
+        band->setProperty ("p10Db", roundedDb (r.bandHistograms[idx].percentile (0.1f)));
+        band->setProperty ("p50Db", roundedDb (r.bandHistograms[idx].percentile (0.5f)));
+        band->setProperty ("p90Db", roundedDb (r.bandHistograms[idx].percentile (0.9f)));
+        bands.add (juce::var (band));
+    }
+    root->setProperty ("bands", bands);
+
+    return juce::var (root);
+}
+
+bool writeCsv (const FileResult& file, const Settings& settings, const juce::File& outputDirectory)
+{
+    const auto& r = file.result;
+    const auto stem = file.file.getFileNameWithoutExtension();
+    bool ok = true;
+
+    {
+        juce::String csv ("key,value\n");
+        csv << "file," << file.file.getFullPathName().quoted() << "\n"
+            << "sample_rate," << file.sampleRate << "\n"
+            << "duration_s," << (file.sampleRate > 0.0 ? static_cast<double> (file.lengthSamples) / file.sampleRate : 0.0) << "\n"
+            << "integrated_lufs," << meanSquareToLufs (r.integratedMeanSquare) << "\n"
+            << "sample_peak_db," << r.samplePeakDb << "\n"
+            << "true_peak_db," << r.truePeakDb << "\n"
+            << "ltas_duration_s," << r.ltasSeconds << "\n";
+        ok &= outputDirectory.getChildFile (stem + ".summary.csv").replaceWithText (csv);
+    }
+
+    {
+        juce::String csv ("frequency_hz,ltas_db\n");
+        for (int i = 0; i < RangeResult::kNumLogPoints; ++i)
+            csv << SpectrumResampler::getLogPointFrequency (i) << "," << powerToDb (r.ltasLogPower[static_cast<std::size_t> (i)]) << "\n";
+        ok &= outputDirectory.getChildFile (stem + ".ltas.csv").replaceWithText (csv);
+    }
+
+    {
+        juce::String csv ("centre_hz,ltas_db,max_db,p10_db,p50_db,p90_db\n");
+        const auto& centres = SpectrumResampler::getBandCentresHz();
+        for (int b = 0; b < RangeResult::kNumBands; ++b)
+        {
+            const auto idx = static_cast<std::size_t> (b);
+            csv << centres[idx] << "," << powerToDb (r.ltasBandPower[idx]) << "," << r.bandMaxDb[idx] << ","
+                << r.bandHistograms[idx].percentile (0.1f) << "," << r.bandHistograms[idx].percentile (0.5f) << ","
+                << r.bandHistograms[idx].percentile (0.9f) << "\n";
+        }
+        ok &= outputDirectory.getChildFile (stem + ".bands.csv").replaceWithText (csv);
+    }
+
+    {
+        juce::String csv ("time_s,momentary_lufs,short_term_lufs\n");
+        for (std::size_t i = 0; i < r.momentaryLufs.size(); ++i)
+            csv << static_cast<double> (i + 1) * settings.curveIntervalSeconds << "," << r.momentaryLufs[i] << "," << r.shortTermLufs[i] << "\n";
+        ok &= outputDirectory.getChildFile (stem + ".loudness.csv").replaceWithText (csv);
+    }
+
+    return ok;
+}
+
+} // namespace AnalyzerPro::offline
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <juce_audio_formats/juce_audio_formats.h>
+#include "analyzer/SpectrumResampler.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace AnalyzerPro::offline
+{
+
+//==============================================================================
+struct Settings
+{
+    int fftSize = 8192;
+    int blockSize = 1024;               // Host block size emulated for the engine / loudness meter
+    double chunkSeconds = 120.0;        // Files longer than this are split into chunks (rounded to the curve interval)
+    double warmupSeconds = 3.0;         // Pre-roll per chunk (short-term window, ballistics, filter state)
+    double curveIntervalSeconds = 0.1;  // Loudness curve / band statistics sampling period
+};
+
+//==============================================================================
+/** Level histogram for band percentiles: 0.5 dB steps over [-120, +12) dB. */
+struct LevelHistogram
+{
+    static constexpr float kMinDb = -120.0f;
+    static constexpr float kStepDb = 0.5f;
+    static constexpr int kNumBins = 264;
+
+    std::array<uint32_t, kNumBins> counts {};
+
+    void add (float db) noexcept;
+    void merge (const LevelHistogram& other) noexcept;
+    /** Level below which fraction p (0..1) of the samples lie; kMinDb when empty. */
+    float percentile (float p) const noexcept;
+};
+
+//==============================================================================
+/** Measurements of one contiguous range of a file (a whole file or one chunk). */
+struct RangeResult
+{
+    static constexpr int kNumBands = SpectrumResampler::kNumBands;
+    static constexpr int kNumLogPoints = SpectrumResampler::kNumLogPoints;
+
+    int64_t startSample = 0;
+    int64_t numSamples = 0;
+
+    // Long-term average spectrum (linear power) and the span it covers
+    std::array<double, kNumLogPoints> ltasLogPower {};
+    std::array<double, kNumBands> ltasBandPower {};
+    double ltasSeconds = 0.0;
+
+    // Per 1/3-octave band statistics of the (ballistic) band level, sampled every curve interval
+    std::array<float, kNumBands> bandMaxDb {};
+    std::array<LevelHistogram, kNumBands> bandHistograms {};
+
+    // Loudness curves (one value per curve interval from startSample) and totals
+    std::vector<float> momentaryLufs;
+    std::vector<float> shortTermLufs;
+    double integratedMeanSquare = 0.0;  // K-weighted L + R mean square (LoudnessAnalyzer convention, ungated)
+    float samplePeakDb = -100.0f;
+    float truePeakDb = -100.0f;         // 4x oversampled
+
+    bool ok = false;
+    juce::String error;
+
+    RangeResult() { bandMaxDb.fill (-120.0f); }
+};
+
+struct FileResult
+{
+    juce::File file;
+    double sampleRate = 0.0;
+    int64_t lengthSamples = 0;
+    int numChannels = 0;
+    RangeResult result;
+    double processingSeconds = 0.0;     // Summed over chunks (CPU time, not wall time)
+};
+
+//==============================================================================
+/** Analyses [start, end) of the file with its own engine, loudness meter and oversampler.
+    The warm-up pre-roll before start is processed but not measured. Thread-safe (opens
+    its own reader). */
+RangeResult analyseRange (const juce::File& file, const Settings& settings, int64_t start, int64_t end);
+
+/** Combines consecutive ranges of one file (in order) into a whole-file result. */
+RangeResult mergeRanges (const std::vector<RangeResult>& ranges);
+
+/** Chunk boundaries for a file of lengthSamples (a single range when it fits one chunk). */
+std::vector<std::pair<int64_t, int64_t>> splitIntoChunks (int64_t lengthSamples, double sampleRate, const Settings& settings);
+
+juce::var toJson (const FileResult& file, const Settings& settings);
+bool writeCsv (const FileResult& file, const Settings& settings, const juce::File& outputDirectory);
+
+float meanSquareToLufs (double meanSquare) noexcept;
+
+} // namespace AnalyzerPro::offline
@@ -0,0 +1,284 @@
+#include "GoldenCases.h"
+#include "analyzer/AnalyzerEngine.h"
+#include "dsp/loudness/LoudnessAnalyzer.h"
+#include <cmath>
+
+namespace AnalyzerPro::golden
+{
+
+namespace
+{
+    constexpr double kSampleRate = 48000.0;
+    constexpr int kBlockSize = 512;
+    constexpr float kSineGain = 0.5f;           // -6.02 dBFS
+    constexpr int kLogDecimation = 4;           // Every 4th LOG point goes into the golden vector
+
+    // Hann scalloping half a bin off centre: 20 log10 (|W(0.5)| / |W(0)|)
+    constexpr float kHannHalfBinLossDb = -1.4236f;
+
+    const char* getSignalName (Signal s) noexcept
+    {
+        switch (s)
+        {
+            case Signal::SineBinCentre:   return "sine-bin-centre";
+            case Signal::SineBetweenBins: return "sine-between-bins";
+            case Signal::PinkNoise:       return "pink-noise";
+            case Signal::Impulses:        return "impulses";
+            case Signal::Ebu3341Case1:    return "ebu3341-1";
+            case Signal::Ebu3341Case2:    return "ebu3341-2";
+            case Signal::Ebu3341Case5:    return "ebu3341-5";
+        }
+        return "";
+    }
+
+    /** Smoothing label matching the processor's Averaging choices (off, 1/24 .. 1/3, 1 oct). */
+    juce::String getSmoothingName (float octaves)
+    {
+        if (octaves <= 0.0f)
+            return "smooth-off";
+        if (octaves >= 1.0f)
+            return "smooth1";
+        return "smooth1-" + juce::String (juce::roundToInt (1.0f / octaves));
+    }
+
+    //==============================================================================
+    /** Fills both channels with the next block of a signal; keeps its own phase / state. */
+    class Generator
+    {
+    public:
+        Generator (Signal s, int fftSize) : signal (s), period (juce::jmax (1, fftSize))
+        {
+            const int nearestBin = juce::jmax (1, juce::roundToInt (1000.0 * period / kSampleRate));
+            const double bin = (signal == Signal::SineBetweenBins) ? nearestBin + 0.5 : nearestBin;
+            sineIncrement = juce::MathConstants<double>::twoPi * bin / static_cast<double> (period);
+            sineBin = nearestBin;
+
+            if (signal == Signal::Ebu3341Case1 || signal == Signal::Ebu3341Case2 || signal == Signal::Ebu3341Case5)
+                sineIncrement = juce::MathConstants<double>::twoPi * 1000.0 / kSampleRate;
+        }
+
+        int getSineBin() const noexcept { return sineBin; }
+
+        void fill (juce::AudioBuffer<float>& buffer, int numSamples, float gain)
+        {
+            float* left = buffer.getWritePointer (0);
+            for (int i = 0; i < numSamples; ++i)
+                left[i] = gain * nextSample();
+            buffer.copyFrom (1, 0, left, numSamples);
+        }
+
+    private:
+        float nextSample()
+        {
+            switch (signal)
+            {
+                case Signal::PinkNoise:
+                {
+                    // Paul Kellet's refined pink filter on seeded white noise
+                    const float white = random.nextFloat() * 2.0f - 1.0f;
+                    b0 = 0.99886f * b0 + white * 0.0555179f;
+                    b1 = 0.99332f * b1 + white * 0.0750759f;
+                    b2 = 0.96900f * b2 + white * 0.1538520f;
+                    b3 = 0.86650f * b3 + white * 0.3104856f;
+                    b4 = 0.55000f * b4 + white * 0.5329522f;
+                    b5 = -0.7616f * b5 - white * 0.0168980f;
+                    const float pink = b0 + b1 + b2 + b3 + b4 + b5 + b6 + white * 0.5362f;
+                    b6 = white * 0.115926f;
+                    return pink * 0.11f;
+                }
+
+                case Signal::Impulses:
+                {
+                    // One impulse per FFT length: every frame holds exactly one, so its spectrum is flat
+                    const bool impulse = (position++ % period) == period / 3;
+                    return impulse ? 1.0f : 0.0f;
+                }
+
+                case Signal::SineBinCentre:
+                case Signal::SineBetweenBins:
+                case Signal::Ebu3341Case1:
+                case Signal::Ebu3341Case2:
+                case Signal::Ebu3341Case5:
+                default:
+                {
+                    const float s = static_cast<float> (std::sin (phase));
+                    phase = std::fmod (phase + sineIncrement, juce::MathConstants<double>::twoPi);
+                    return s;
+                }
+            }
+        }
+
+        Signal signal;
+        int period;
+        int sineBin = 0;
+        double sineIncrement = 0.0;
+        double phase = 0.0;
+        int64_t position = 0;
+        juce::Random random { 20240117 };
+        float b0 = 0, b1 = 0, b2 = 0, b3 = 0, b4 = 0, b5 = 0, b6 = 0;
+    };
+
+    void expectNear (CaseResult& result, const char* what, float actual, float expected, float tolerance)
+    {
+        if (std::abs (actual - expected) > tolerance)
+            result.failures.add (juce::String (what) + ": " + juce::String (actual, 3) + " dB, expected "
+                                 + juce::String (expected, 3) + " +/- " + juce::String (tolerance, 2));
+    }
+
+    //==============================================================================
+    CaseResult runSpectral (const Case& c, float toleranceDb)
+    {
+        CaseResult result;
+
+        auto engine = std::make_unique<AnalyzerEngine>();
+        engine->requestFftSize (c.fftSize);
+        engine->setSmoothingOctaves (c.smoothingOctaves);
+        engine->addConsumer (AnalyzerEngine::Product::Spectrum);
+        engine->prepare (kSampleRate, kBlockSize);
+
+        // Long enough for several frames at the largest size and for the ballistics to settle
+        const int64_t totalSamples = juce::jmax<int64_t> (static_cast<int64_t> (2.0 * kSampleRate),
+                                                          static_cast<int64_t> (c.fftSize) * 6);
+
+        Generator generator (c.signal, c.fftSize);
+        const float gain = (c.signal == Signal::Impulses || c.signal == Signal::PinkNoise) ? 1.0f : kSineGain;
+        juce::AudioBuffer<float> buffer (2, kBlockSize);
+
+        for (int64_t done = 0; done < totalSamples; done += kBlockSize)
+        {
+            const int n = static_cast<int> (juce::jmin<int64_t> (kBlockSize, totalSamples - done));
+            generator.fill (buffer, n, gain);
+            engine->processBlock (juce::AudioBuffer<float> (buffer.getArrayOfWritePointers(), 2, n));
+        }
+
+        using Trace = AnalyzerSnapshot::Trace;
+        const AnalyzerSnapshot* snapshot = engine->acquireLatestSnapshot();
+        if (snapshot == nullptr || ! snapshot->isValid || snapshot->fftSize != c.fftSize)
+        {
+            result.failures.add ("no snapshot at the requested FFT size");
+            return result;
+        }
+
+        const float* bandsDb = snapshot->getTrace (Trace::BandsDb);
+        const float* logDb = snapshot->getTrace (Trace::LogDb);
+        const float* fftDb = snapshot->getTrace (Trace::FftDb);
+        if (bandsDb == nullptr || logDb == nullptr || fftDb == nullptr)
+        {
+            result.failures.add ("missing Bands / Log / FFT trace");
+            return result;
+        }
+
+        result.values.assign (bandsDb, bandsDb + snapshot->getTraceLength (Trace::BandsDb));
+        for (int i = 0; i < snapshot->getTraceLength (Trace::LogDb); i += kLogDecimation)
+            result.values.push_back (logDb[i]);
+
+        // Analytic checks on the raw bins (frequency smoothing redistributes them, so golden only)
+        if (c.smoothingOctaves > 0.0f)
+            return result;
+
+        const int bin = generator.getSineBin();
+        const float expectedSineDb = juce::Decibels::gainToDecibels (kSineGain);
+
+        if (c.signal == Signal::SineBinCentre)
+        {
+            expectNear (result, "bin-centre sine level", fftDb[bin], expectedSineDb, toleranceDb);
+        }
+        else if (c.signal == Signal::SineBetweenBins)
+        {
+            expectNear (result, "between-bins sine level", juce::jmax (fftDb[bin], fftDb[bin + 1]),
+                        expectedSineDb + kHannHalfBinLossDb, toleranceDb);
+        }
+        else if (c.signal == Signal::Impulses)
+        {
+            // Flat from the first bin to just below Nyquist (DC / Nyquist are scaled separately)
+            auto range = juce::Range<float>::withStartAndLength (fftDb[1], 0.0f);
+            for (int k = 2; k < snapshot->fftBinCount - 1; ++k)
+                range = range.getUnionWith (fftDb[k]);
+            if (range.getLength() > toleranceDb)
+                result.failures.add ("impulse spectrum not flat: " + juce::String (range.getLength(), 3) + " dB spread");
+        }
+
+        return result;
+    }
+
+    //==============================================================================
+    CaseResult runLoudness (const Case& c, float toleranceDb)
+    {
+        CaseResult result;
+
+        struct Segment { float levelDbfs; double seconds; };
+        std::vector<Segment> segments;
+        switch (c.signal)
+        {
+            case Signal::Ebu3341Case1: segments = { { -23.0f, 20.0 } }; break;
+            case Signal::Ebu3341Case2: segments = { { -33.0f, 20.0 } }; break;
+            case Signal::Ebu3341Case5: segments = { { -26.0f, 20.0 }, { -20.0f, 20.1 }, { -26.0f, 20.0 } }; break;
+            case Signal::SineBinCentre:
+            case Signal::SineBetweenBins:
+            case Signal::PinkNoise:
+            case Signal::Impulses:
+            default: break;
+        }
+
+        AnalyzerPro::dsp::LoudnessAnalyzer loudness;
+        loudness.prepare (kSampleRate, kBlockSize);
+
+        Generator generator (c.signal, 0);
+        juce::AudioBuffer<float> buffer (2, kBlockSize);
+
+        for (const auto& segment : segments)
+        {
+            const auto total = static_cast<int64_t> (segment.seconds * kSampleRate);
+            for (int64_t done = 0; done < total; done += kBlockSize)
+            {
+                const int n = static_cast<int> (juce::jmin<int64_t> (kBlockSize, total - done));
+                generator.fill (buffer, n, juce::Decibels::decibelsToGain (segment.levelDbfs));
+                loudness.process (juce::AudioBuffer<float> (buffer.getArrayOfWritePointers(), 2, n));
+            }
+
+            // Every segment is far longer than the 3 s short-term window: M and S read its level
+            const auto lufs = loudness.getSnapshot();
+            result.values.push_back (lufs.momentaryLufs);
+            result.values.push_back (lufs.shortTermLufs);
+            expectNear (result, "momentary", lufs.momentaryLufs, segment.levelDbfs, toleranceDb);
+            expectNear (result, "short-term", lufs.shortTermLufs, segment.levelDbfs, toleranceDb);
+        }
+
+        // Integrated is ungated in LoudnessAnalyzer: only checkable against the nominal for one steady segment
+        const float integrated = loudness.getSnapshot().integratedLufs;
+        result.values.push_back (integrated);
+        if (segments.size() == 1)
+            expectNear (result, "integrated", integrated, segments.front().levelDbfs, toleranceDb);
+
+        return result;
+    }
+}
+
+//==============================================================================
+std::vector<Case> makeCases()
+{
+    static constexpr float kSmoothings[] = { 0.0f, 1.0f / 24.0f, 1.0f / 12.0f, 1.0f / 6.0f, 1.0f / 3.0f, 1.0f };
+    static constexpr Signal kSpectral[] = { Signal::SineBinCentre, Signal::SineBetweenBins, Signal::PinkNoise, Signal::Impulses };
+
+    std::vector<Case> cases;
+    for (const auto signal : kSpectral)
+        for (int fftSize = 1024; fftSize <= AnalyzerSnapshot::kMaxFFTSize; fftSize *= 2)
+            for (const float smoothing : kSmoothings)
+                cases.push_back ({ juce::String (getSignalName (signal)) + "/fft" + juce::String (fftSize) + "/" + getSmoothingName (smoothing),
+                                   signal, fftSize, smoothing });
+
+    for (const auto signal : { Signal::Ebu3341Case1, Signal::Ebu3341Case2, Signal::Ebu3341Case5 })
+        cases.push_back ({ getSignalName (signal), signal, 0, 0.0f });
+
+    return cases;
+}
+
+CaseResult runCase (const Case& c, float toleranceDb)
+{
+    const double start = juce::Time::getMillisecondCounterHiRes();
+    auto result = c.isLoudness() ? runLoudness (c, toleranceDb) : runSpectral (c, toleranceDb);
+    result.seconds = (juce::Time::getMillisecondCounterHiRes() - start) * 0.001;
+    return result;
+}
+
+} // namespace AnalyzerPro::golden
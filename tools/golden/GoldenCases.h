@@ -0,0 +1,51 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <vector>
+
+namespace AnalyzerPro::golden
+{
+
+//==============================================================================
+/** Deterministic test signals. */
+enum class Signal
+{
+    SineBinCentre,      // -6.02 dBFS sine on the bin nearest 1 kHz
+    SineBetweenBins,    // Same, half a bin higher (worst-case Hann scalloping)
+    PinkNoise,          // Seeded white noise through the Kellet pink filter
+    Impulses,           // One unit impulse per FFT length (every frame sees a flat spectrum)
+    Ebu3341Case1,       // Tech 3341 test 1: 1 kHz stereo sine at -23 dBFS, 20 s
+    Ebu3341Case2,       // Tech 3341 test 2: 1 kHz stereo sine at -33 dBFS, 20 s
+    Ebu3341Case5        // Tech 3341 test 5: -26 / -20 / -26 dBFS segments (20 / 20.1 / 20 s)
+};
+
+/** One engine or loudness run. Spectral cases vary FFT size and frequency smoothing. */
+struct Case
+{
+    juce::String name;              // Golden key, e.g. "sine-bin-centre/fft4096/smooth1-6"
+    Signal signal = Signal::SineBinCentre;
+    int fftSize = 0;                // 0 for loudness cases
+    float smoothingOctaves = 0.0f;
+
+    bool isLoudness() const noexcept { return fftSize == 0; }
+};
+
+struct CaseResult
+{
+    /** Compared against the golden file: spectral cases carry BandsDb (31) then every 4th
+        LogDb point; loudness cases carry M / S / I per checkpoint. */
+    std::vector<float> values;
+
+    /** Analytic checks that do not need a golden file (empty when all passed). */
+    juce::StringArray failures;
+    double seconds = 0.0;
+};
+
+//==============================================================================
+/** Every signal x FFT size (1024 .. 65536) x smoothing (off .. 1 oct), then the loudness cases. */
+std::vector<Case> makeCases();
+
+/** Runs one case on its own engine / meter (thread-safe, no shared state). */
+CaseResult runCase (const Case& c, float toleranceDb);
+
+} // namespace AnalyzerPro::golden
@@ -0,0 +1,204 @@
+#include "GoldenCases.h"
+#include <cmath>
+#include <iostream>
+
+//==============================================================================
+/**
+    AnalyzerPro_Golden: spectral and loudness accuracy regression check.
+
+    Feeds deterministic signals (bin-centred and between-bin sines, seeded pink noise,
+    impulse trains, EBU Tech 3341 loudness vectors) through AnalyzerEngine at every FFT
+    size and smoothing setting, and through LoudnessAnalyzer. Every case runs on its own
+    engine, so all of them run in parallel on one thread pool.
+
+    Two kinds of check:
+        - analytic: sine levels against the Hann / scaling maths, impulse flatness,
+          Tech 3341 M / S / I against the nominal level (no golden file needed)
+        - golden: published BandsDb + LOG series (loudness: M / S / I per segment) against
+          the stored reference, within --tolerance dB
+
+    Usage:
+        AnalyzerPro_Golden [--golden <file.json>] [--update] [--tolerance <dB>] [--jobs <n>] [--filter <substring>]
+
+        --golden     Reference file (default: tools/golden/golden.json in the source tree)
+        --update     Rewrite the reference from this build instead of comparing (review the diff)
+        --tolerance  Allowed deviation in dB (default 0.1)
+        --jobs       Worker threads (default: all cores)
+        --filter     Only run cases whose name contains the substring
+
+    Exit code 1 when any check fails.
+*/
+
+#ifndef ANALYZERPRO_GOLDEN_FILE
+ #define ANALYZERPRO_GOLDEN_FILE "golden.json"
+#endif
+
+namespace
+{
+    using namespace AnalyzerPro::golden;
+
+    // Both below this: noise floor / silent bands, not compared
+    constexpr float kFloorDb = -100.0f;
+
+    void printUsage()
+    {
+        std::cout << "Usage: AnalyzerPro_Golden [--golden file.json] [--update] [--tolerance dB] [--jobs n] [--filter substring]\n";
+    }
+
+    juce::var toJson (const std::vector<Case>& cases, const std::vector<CaseResult>& results, float toleranceDb)
+    {
+        auto* caseObject = new juce::DynamicObject();
+        for (std::size_t i = 0; i < cases.size(); ++i)
+        {
+            juce::Array<juce::var> values;
+            for (const float v : results[i].values)
+                values.add (std::round (static_cast<double> (v) * 1000.0) / 1000.0);
+            caseObject->setProperty (cases[i].name, values);
+        }
+
+        auto* root = new juce::DynamicObject();
+        root->setProperty ("tolerance_db", toleranceDb);
+        root->setProperty ("cases", juce::var (caseObject));
+        return juce::var (root);
+    }
+
+    /** Empty when within tolerance, otherwise a one-line description of the worst deviation. */
+    juce::String compareWithGolden (const CaseResult& result, const juce::var& golden, float toleranceDb)
+    {
+        const auto* expected = golden.getArray();
+        if (expected == nullptr)
+            return "not in the golden file (run --update on a reference build)";
+        if (expected->size() != static_cast<int> (result.values.size()))
+            return "golden has " + juce::String (expected->size()) + " values, this build " + juce::String (static_cast<int> (result.values.size()));
+
+        float worst = 0.0f;
+        int worstIndex = -1;
+        for (int i = 0; i < expected->size(); ++i)
+        {
+            const float want = static_cast<float> (static_cast<double> ((*expected)[i]));
+            const float got = result.values[static_cast<std::size_t> (i)];
+            if (want <= kFloorDb && got <= kFloorDb)
+                continue;
+
+            const float deviation = std::abs (got - want);
+            if (deviation > worst)
+            {
+                worst = deviation;
+                worstIndex = i;
+            }
+        }
+
+        if (worst <= toleranceDb)
+            return {};
+
+        const float want = static_cast<float> (static_cast<double> ((*expected)[worstIndex]));
+        return "value " + juce::String (worstIndex) + " is " + juce::String (result.values[static_cast<std::size_t> (worstIndex)], 3)
+             + " dB, golden " + juce::String (want, 3) + " (off by " + juce::String (worst, 3) + " dB)";
+    }
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    auto goldenFile = juce::File::getCurrentWorkingDirectory().getChildFile (ANALYZERPRO_GOLDEN_FILE);
+    bool update = false;
+    float toleranceDb = 0.1f;
+    int numThreads = juce::SystemStats::getNumCpus();
+    juce::String filter;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const juce::String arg (argv[i]);
+        const bool hasValue = (i + 1 < argc);
+
+        if (arg == "--help" || arg == "-h")            { printUsage(); return 0; }
+        else if (arg == "--update")                    update = true;
+        else if (arg == "--golden" && hasValue)        goldenFile = juce::File::getCurrentWorkingDirectory().getChildFile (argv[++i]);
+        else if (arg == "--tolerance" && hasValue)     toleranceDb = juce::jmax (0.0f, juce::String (argv[++i]).getFloatValue());
+        else if (arg == "--jobs" && hasValue)          numThreads = juce::jmax (1, juce::String (argv[++i]).getIntValue());
+        else if (arg == "--filter" && hasValue)        filter = argv[++i];
+        else
+        {
+            std::cerr << "Unknown or incomplete option: " << arg << "\n";
+            printUsage();
+            return 2;
+        }
+    }
+
+    std::vector<Case> cases;
+    for (auto& c : makeCases())
+        if (filter.isEmpty() || c.name.contains (filter))
+            cases.push_back (std::move (c));
+
+    //==============================================================================
+    // Every case on one pool (results land in preallocated slots)
+    std::vector<CaseResult> results (cases.size());
+    const double wallStart = juce::Time::getMillisecondCounterHiRes();
+    {
+        juce::ThreadPool pool (numThreads);
+        for (std::size_t i = 0; i < cases.size(); ++i)
+            pool.addJob ([&, i] { results[i] = runCase (cases[i], toleranceDb); });
+
+        while (pool.getNumJobs() > 0)
+            juce::Thread::sleep (20);
+    }
+    const double wallSeconds = (juce::Time::getMillisecondCounterHiRes() - wallStart) * 0.001;
+
+    //==============================================================================
+    int failures = 0;
+    for (std::size_t i = 0; i < cases.size(); ++i)
+    {
+        for (const auto& message : results[i].failures)
+        {
+            std::cout << "FAIL " << cases[i].name << ": " << message << "\n";
+            ++failures;
+        }
+    }
+
+    if (update)
+    {
+        // A filtered update keeps the other cases already in the file
+        auto json = toJson (cases, results, toleranceDb);
+        if (filter.isNotEmpty())
+        {
+            const auto existing = juce::JSON::parse (goldenFile);
+            if (auto* existingCases = existing["cases"].getDynamicObject())
+                for (const auto& property : existingCases->getProperties())
+                    if (! json["cases"].hasProperty (property.name))
+                        json["cases"].getDynamicObject()->setProperty (property.name, property.value);
+        }
+
+        if (! goldenFile.replaceWithText (juce::JSON::toString (json)))
+        {
+            std::cerr << "Cannot write " << goldenFile.getFullPathName() << "\n";
+            return 1;
+        }
+        std::cout << "Wrote " << cases.size() << " cases to " << goldenFile.getFullPathName() << "\n";
+    }
+    else
+    {
+        const auto golden = juce::JSON::parse (goldenFile);
+        if (! golden.isObject())
+        {
+            std::cout << "FAIL no golden file at " << goldenFile.getFullPathName() << " (run --update on a reference build)\n";
+            ++failures;
+        }
+        else
+        {
+            for (std::size_t i = 0; i < cases.size(); ++i)
+            {
+                const auto message = compareWithGolden (results[i], golden["cases"][juce::Identifier (cases[i].name)], toleranceDb);
+                if (message.isNotEmpty())
+                {
+                    std::cout << "FAIL " << cases[i].name << ": " << message << "\n";
+                    ++failures;
+                }
+            }
+        }
+    }
+
+    std::cout << cases.size() << " cases in " << juce::String (wallSeconds, 2) << " s on " << numThreads << " threads: "
+              << (failures == 0 ? juce::String ("all passed") : juce::String (failures) + " failure(s)") << "\n";
+
+    return failures == 0 ? 0 : 1;
+}
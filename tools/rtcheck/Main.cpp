@@ -0,0 +1,297 @@
+#include "PluginProcessor.h"
+#include "diagnostics/RealtimeGuard.h"
+#include <cmath>
+#include <functional>
+#include <iostream>
+
+//==============================================================================
+/**
+    AnalyzerPro_RtCheck: real-time safety regression check.
+
+    Runs the processor the way a host does and marks every processBlock call as a
+    real-time thread (processBlock also marks itself, as does the analysis worker's
+    drain). The hooks linked into this executable (RealtimeGuardHooks.cpp) then flag any
+    allocation, free or mutex lock on those threads. Parameter changes are made from this
+    driver thread between blocks, like a host's message thread would.
+
+    The engine analyses on the shared pool (realtime mode) at Foreground priority, and the
+    driver waits after every block until the pool has taken everything queued, so each
+    scenario's hops, size swaps and publishes run inside it. Every scenario must also end
+    with no ring overruns, and every FFT size must publish at least one frame at that size;
+    a failed check counts like a violation.
+
+    Scenarios, at 44.1 / 48 / 96 kHz and 32 / 512 / 2048-sample blocks:
+        - every parameter swept through normalised 0, 0.25, 0.5, 0.75, 1
+        - every FFT size in turn, with enough blocks for hops at that size
+        - block sizes varying below the prepared maximum
+        - blocks larger than the prepared maximum (host contract stretch seen in offline renders)
+
+    Usage:
+        AnalyzerPro_RtCheck [--abort] [--quick]
+
+        --abort     Abort on the first violation with its stack (for a debugger / CI core)
+        --quick     48 kHz / 512 only
+
+    Exit code 1 when any violation or check failure was recorded; the report lists each
+    violating call site once.
+*/
+
+namespace
+{
+    struct Config
+    {
+        double sampleRate;
+        int blockSize;
+    };
+
+    constexpr AnalyzerEngine::Product kAllProducts[] = { AnalyzerEngine::Product::Spectrum,
+                                                         AnalyzerEngine::Product::StereoScope,
+                                                         AnalyzerEngine::Product::Spectrogram };
+
+    /** Deterministic stereo noise + tone so every analysis path has content. */
+    void fillSignal (juce::AudioBuffer<float>& buffer, int numSamples, juce::Random& random, double& phase, double sampleRate)
+    {
+        const double increment = juce::MathConstants<double>::twoPi * 997.0 / sampleRate;
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float tone = 0.25f * static_cast<float> (std::sin (phase));
+            phase += increment;
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                buffer.setSample (ch, i, tone + 0.1f * (random.nextFloat() * 2.0f - 1.0f));
+        }
+    }
+
+    class Runner
+    {
+    public:
+        Runner (AnalayzerProAudioProcessor& p, const Config& c)
+            : processor (p), config (c),
+              buffer (juce::jmax (2, juce::jmax (p.getTotalNumInputChannels(), p.getTotalNumOutputChannels())), 65536)
+        {
+            // Every engine product on, as with an editor showing all views
+            for (auto product : kAllProducts)
+                processor.getAnalyzerEngine().addConsumer (product);
+
+            processor.setRateAndBufferSizeDetails (config.sampleRate, config.blockSize);
+            processor.prepareToPlay (config.sampleRate, config.blockSize);
+
+            // Unthrottled pool service, as with an editor open
+            processor.getAnalyzerEngine().setAnalysisPriority (AnalysisScheduler::Priority::Foreground);
+        }
+
+        ~Runner()
+        {
+            processor.releaseResources();
+
+            for (auto product : kAllProducts)
+                processor.getAnalyzerEngine().removeConsumer (product);
+        }
+
+        /** One host callback on a marked thread. Buffer preparation happens outside the mark. */
+        void runBlock (int numSamples)
+        {
+            fillSignal (buffer, numSamples, random, phase, config.sampleRate);
+            juce::AudioBuffer<float> view (buffer.getArrayOfWritePointers(), buffer.getNumChannels(), numSamples);
+
+            {
+                RealtimeGuard::ScopedRealtimeThread realtimeScope;
+                processor.processBlock (view, midi);
+            }
+
+            waitForAnalysis();
+        }
+
+        /** Blocks until the analysis context has taken every queued sample (no-op inline). */
+        void waitForAnalysis()
+        {
+            const auto& engine = processor.getAnalyzerEngine();
+            const auto deadline = juce::Time::getMillisecondCounter() + kWaitTimeoutMs;
+            while (engine.getNumQueuedAnalysisSamples() > 0)
+            {
+                if (juce::Time::getMillisecondCounter() > deadline)
+                {
+                    fail ("analysis ring not drained within " + juce::String (kWaitTimeoutMs) + " ms");
+                    return;
+                }
+                juce::Thread::sleep (1);
+            }
+        }
+
+        /** Blocks until a frame at fftSize was published after framesBefore. */
+        bool waitForFrame (int fftSize, uint32_t framesBefore)
+        {
+            auto& engine = processor.getAnalyzerEngine();
+            const auto deadline = juce::Time::getMillisecondCounter() + kWaitTimeoutMs;
+            for (;;)
+            {
+                const AnalyzerSnapshot* snapshot = engine.acquireLatestSnapshot();
+                if (engine.getNumPublishedFrames() != framesBefore && snapshot != nullptr && snapshot->fftSize == fftSize)
+                    return true;
+                if (juce::Time::getMillisecondCounter() > deadline)
+                    return false;
+                juce::Thread::sleep (1);
+            }
+        }
+
+        /** Checks that ran at the end of the scenario; returns the failure count. */
+        int finish()
+        {
+            const auto overruns = processor.getAnalyzerEngine().getAnalysisOverrunCount();
+            if (overruns != 0)
+                fail (juce::String (overruns) + " analysis ring overrun(s)");
+            return failures;
+        }
+
+        void runBlocks (int count)
+        {
+            for (int i = 0; i < count; ++i)
+                runBlock (config.blockSize);
+        }
+
+        void sweepParameters()
+        {
+            static constexpr float kValues[] = { 0.0f, 0.25f, 0.5f, 0.75f, 1.0f };
+
+            auto& audioProcessor = static_cast<juce::AudioProcessor&> (processor);
+            for (auto* param : audioProcessor.getParameters())
+            {
+                const float original = param->getValue();
+                for (const float value : kValues)
+                {
+                    param->setValueNotifyingHost (value);
+                    runBlocks (4);
+                }
+                param->setValueNotifyingHost (original);
+                runBlocks (2);
+            }
+        }
+
+        void cycleFftSizes()
+        {
+            auto* param = dynamic_cast<juce::RangedAudioParameter*> (processor.getAPVTS().getParameter ("FftSize"));
+            if (param == nullptr)
+                return;
+
+            const int numSizes = static_cast<int> (param->getNormalisableRange().end) + 1;
+            for (int index = 0; index < numSizes; ++index)
+            {
+                const uint32_t framesBefore = processor.getAnalyzerEngine().getNumPublishedFrames();
+                param->setValueNotifyingHost (param->convertTo0to1 (static_cast<float> (index)));
+
+                // Two full frames at this size (1024 << index), so the resize and at least one hop both run
+                const int fftSize = 1024 << index;
+                runBlocks (2 * fftSize / config.blockSize + 2);
+
+                if (! waitForFrame (fftSize, framesBefore))
+                    fail ("no frame published at FFT size " + juce::String (fftSize));
+            }
+        }
+
+        void varyBlockSizes()
+        {
+            for (int n = 1; n <= config.blockSize; n = n * 3 + 1)
+                runBlock (n);
+            runBlocks (2);
+        }
+
+        void oversizedBlocks()
+        {
+            runBlock (juce::jmin (buffer.getNumSamples(), config.blockSize * 4));
+            runBlock (buffer.getNumSamples());
+        }
+
+    private:
+        static constexpr juce::uint32 kWaitTimeoutMs = 2000;
+
+        void fail (const juce::String& what)
+        {
+            // Report each kind once per scenario, count every occurrence
+            if (failures++ == 0 || what != lastFailure)
+                std::cout << "  check failed: " << what << "\n";
+            lastFailure = what;
+        }
+
+        AnalayzerProAudioProcessor& processor;
+        Config config;
+        juce::AudioBuffer<float> buffer;
+        juce::MidiBuffer midi;
+        juce::Random random { 42 };
+        double phase = 0.0;
+        int failures = 0;
+        juce::String lastFailure;
+    };
+
+    int runScenario (const char* name, const Config& config, const std::function<void (Runner&)>& scenario)
+    {
+        const int before = RealtimeGuard::getNumViolations();
+        int failures = 0;
+        {
+            AnalayzerProAudioProcessor processor;
+            Runner runner (processor, config);
+            runner.runBlocks (4);   // Settle (first-block latching)
+            scenario (runner);
+            failures = runner.finish();
+        }
+
+        const int found = RealtimeGuard::getNumViolations() - before;
+        juce::String result;
+        if (found > 0)
+            result << found << " violation(s)";
+        if (failures > 0)
+            result << (result.isEmpty() ? "" : ", ") << failures << " failed check(s)";
+
+        std::cout << juce::String (name).paddedRight (' ', 16) << " "
+                  << juce::String (config.sampleRate / 1000.0, 1) << " kHz  "
+                  << juce::String (config.blockSize).paddedLeft (' ', 5) << "  "
+                  << (result.isEmpty() ? juce::String ("ok") : result) << "\n";
+        return found + failures;
+    }
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    // APVTS and the analyzer's timers need the message manager
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    bool quick = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        const juce::String arg (argv[i]);
+        if (arg == "--abort")       RealtimeGuard::setMode (RealtimeGuard::Mode::Abort);
+        else if (arg == "--quick")  quick = true;
+        else
+        {
+            std::cerr << "Usage: AnalyzerPro_RtCheck [--abort] [--quick]\n";
+            return 2;
+        }
+    }
+
+    std::vector<Config> configs;
+    if (quick)
+        configs.push_back ({ 48000.0, 512 });
+    else
+        for (const double sampleRate : { 44100.0, 48000.0, 96000.0 })
+            for (const int blockSize : { 32, 512, 2048 })
+                configs.push_back ({ sampleRate, blockSize });
+
+    RealtimeGuard::clearViolations();
+
+    int total = 0;
+    for (const auto& config : configs)
+    {
+        total += runScenario ("parameters", config, [] (Runner& r) { r.sweepParameters(); });
+        total += runScenario ("fft sizes", config, [] (Runner& r) { r.cycleFftSizes(); });
+        total += runScenario ("block sizes", config, [] (Runner& r) { r.varyBlockSizes(); });
+        total += runScenario ("oversized blocks", config, [] (Runner& r) { r.oversizedBlocks(); });
+    }
+
+    if (total == 0)
+    {
+        std::cout << "\nNo real-time violations.\n";
+        return 0;
+    }
+
+    std::cout << "\n" << total << " real-time violation(s) / failed check(s):\n\n" << RealtimeGuard::getReport() << "\n";
+    return 1;
+}
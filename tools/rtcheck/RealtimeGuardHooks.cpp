@@ -0,0 +1,233 @@
+#include "diagnostics/RealtimeGuard.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#if defined (__GLIBC__)
+ #include <cerrno>
+ #include <dlfcn.h>
+ #include <pthread.h>
+#endif
+
+//==============================================================================
+// Hooks that feed RealtimeGuard in the rtcheck executable (never linked into the plugin).
+//
+// glibc: malloc/calloc/realloc/free and the aligned entry points (aligned_alloc, posix_memalign,
+// memalign, which libstdc++'s over-aligned operator new uses) are interposed, so every heap call
+// is seen exactly once. Locks: pthread_mutex_lock/trylock/timedlock/clocklock, which std::mutex,
+// std::timed_mutex and juce::CriticalSection go through, and the matching pthread_rwlock rd/wr
+// entry points (std::shared_mutex).
+// Not covered: valloc/pvalloc, raw futex syscalls and semaphores.
+// Elsewhere only the global operator new/delete can be replaced portably, so C allocations
+// and locks go unchecked there. Spin locks never reach a hook on any platform.
+
+#if defined (__GLIBC__)
+
+extern "C"
+{
+    void* __libc_malloc (size_t);
+    void* __libc_calloc (size_t, size_t);
+    void* __libc_realloc (void*, size_t);
+    void  __libc_free (void*);
+
+    void* malloc (size_t size)
+    {
+        RealtimeGuard::checkAllocation (size);
+        return __libc_malloc (size);
+    }
+
+    void* calloc (size_t count, size_t size)
+    {
+        RealtimeGuard::checkAllocation (count * size);
+        return __libc_calloc (count, size);
+    }
+
+    void* realloc (void* p, size_t size)
+    {
+        RealtimeGuard::checkAllocation (size);
+        return __libc_realloc (p, size);
+    }
+
+    void free (void* p)
+    {
+        if (p != nullptr)
+            RealtimeGuard::checkDeallocation();
+        __libc_free (p);
+    }
+
+    // No __libc_ variants of aligned_alloc/posix_memalign: all three go through memalign
+    void* __libc_memalign (size_t, size_t);
+
+    void* memalign (size_t alignment, size_t size)
+    {
+        RealtimeGuard::checkAllocation (size);
+        return __libc_memalign (alignment, size);
+    }
+
+    void* aligned_alloc (size_t alignment, size_t size)
+    {
+        RealtimeGuard::checkAllocation (size);
+        return __libc_memalign (alignment, size);
+    }
+
+    int posix_memalign (void** result, size_t alignment, size_t size)
+    {
+        RealtimeGuard::checkAllocation (size);
+
+        if (alignment == 0 || alignment % sizeof (void*) != 0 || (alignment & (alignment - 1)) != 0)
+            return EINVAL;
+
+        void* p = __libc_memalign (alignment, size);
+        if (p == nullptr)
+            return ENOMEM;
+
+        *result = p;
+        return 0;
+    }
+}
+
+namespace
+{
+    /** Next definition of a hooked symbol, resolved on first use; no function-local static
+        (its guard could itself lock). */
+    template <typename Fn>
+    Fn resolveNext (std::atomic<Fn>& cache, const char* name) noexcept
+    {
+        auto fn = cache.load (std::memory_order_acquire);
+        if (fn == nullptr)
+        {
+            fn = reinterpret_cast<Fn> (dlsym (RTLD_NEXT, name));
+            cache.store (fn, std::memory_order_release);
+        }
+        return fn;
+    }
+
+    using MutexFn = int (*) (pthread_mutex_t*);
+    using MutexTimedFn = int (*) (pthread_mutex_t*, const struct timespec*);
+    using RwLockFn = int (*) (pthread_rwlock_t*);
+    using RwLockTimedFn = int (*) (pthread_rwlock_t*, const struct timespec*);
+    using MutexClockFn = int (*) (pthread_mutex_t*, clockid_t, const struct timespec*);
+    using RwLockClockFn = int (*) (pthread_rwlock_t*, clockid_t, const struct timespec*);
+
+    std::atomic<MutexFn> realMutexLock { nullptr };
+    std::atomic<MutexFn> realMutexTryLock { nullptr };
+    std::atomic<MutexTimedFn> realMutexTimedLock { nullptr };
+    std::atomic<MutexClockFn> realMutexClockLock { nullptr };
+    std::atomic<RwLockFn> realRdLock { nullptr };
+    std::atomic<RwLockFn> realTryRdLock { nullptr };
+    std::atomic<RwLockTimedFn> realTimedRdLock { nullptr };
+    std::atomic<RwLockClockFn> realClockRdLock { nullptr };
+    std::atomic<RwLockFn> realWrLock { nullptr };
+    std::atomic<RwLockFn> realTryWrLock { nullptr };
+    std::atomic<RwLockTimedFn> realTimedWrLock { nullptr };
+    std::atomic<RwLockClockFn> realClockWrLock { nullptr };
+}
+
+extern "C"
+{
+    int pthread_mutex_lock (pthread_mutex_t* mutex)
+    {
+        RealtimeGuard::checkLock();
+        return resolveNext (realMutexLock, "pthread_mutex_lock") (mutex);
+    }
+
+    int pthread_mutex_trylock (pthread_mutex_t* mutex)
+    {
+        RealtimeGuard::checkLock();
+        return resolveNext (realMutexTryLock, "pthread_mutex_trylock") (mutex);
+    }
+
+    int pthread_mutex_timedlock (pthread_mutex_t* mutex, const struct timespec* timeout)
+    {
+        RealtimeGuard::checkLock();
+        return resolveNext (realMutexTimedLock, "pthread_mutex_timedlock") (mutex, timeout);
+    }
+
+    int pthread_mutex_clocklock (pthread_mutex_t* mutex, clockid_t clock, const struct timespec* timeout)
+    {
+        RealtimeGuard::checkLock();
+        return resolveNext (realMutexClockLock, "pthread_mutex_clocklock") (mutex, clock, timeout);
+    }
+
+    int pthread_rwlock_rdlock (pthread_rwlock_t* lock)
+    {
+        RealtimeGuard::checkLock();
+        return resolveNext (realRdLock, "pthread_rwlock_rdlock") (lock);
+    }
+
+    int pthread_rwlock_tryrdlock (pthread_rwlock_t* lock)
+    {
+        RealtimeGuard::checkLock();
+        return resolveNext (realTryRdLock, "pthread_rwlock_tryrdlock") (lock);
+    }
+
+    int pthread_rwlock_timedrdlock (pthread_rwlock_t* lock, const struct timespec* timeout)
+    {
+        RealtimeGuard::checkLock();
+        return resolveNext (realTimedRdLock, "pthread_rwlock_timedrdlock") (lock, timeout);
+    }
+
+    int pthread_rwlock_clockrdlock (pthread_rwlock_t* lock, clockid_t clock, const struct timespec* timeout)
+    {
+        RealtimeGuard::checkLock();
+        return resolveNext (realClockRdLock, "pthread_rwlock_clockrdlock") (lock, clock, timeout);
+    }
+
+    int pthread_rwlock_wrlock (pthread_rwlock_t* lock)
+    {
+        RealtimeGuard::checkLock();
+        return resolveNext (realWrLock, "pthread_rwlock_wrlock") (lock);
+    }
+
+    int pthread_rwlock_trywrlock (pthread_rwlock_t* lock)
+    {
+        RealtimeGuard::checkLock();
+        return resolveNext (realTryWrLock, "pthread_rwlock_trywrlock") (lock);
+    }
+
+    int pthread_rwlock_timedwrlock (pthread_rwlock_t* lock, const struct timespec* timeout)
+    {
+        RealtimeGuard::checkLock();
+        return resolveNext (realTimedWrLock, "pthread_rwlock_timedwrlock") (lock, timeout);
+    }
+
+    int pthread_rwlock_clockwrlock (pthread_rwlock_t* lock, clockid_t clock, const struct timespec* timeout)
+    {
+        RealtimeGuard::checkLock();
+        return resolveNext (realClockWrLock, "pthread_rwlock_clockwrlock") (lock, clock, timeout);
+    }
+}
+
+#else
+
+namespace
+{
+    void* checkedAlloc (std::size_t size)
+    {
+        RealtimeGuard::checkAllocation (size);
+        if (void* p = std::malloc (size == 0 ? 1 : size))
+            return p;
+        throw std::bad_alloc();
+    }
+
+    void checkedFree (void* p) noexcept
+    {
+        if (p != nullptr)
+            RealtimeGuard::checkDeallocation();
+        std::free (p);
+    }
+}
+
+void* operator new (std::size_t size)                                    { return checkedAlloc (size); }
+void* operator new[] (std::size_t size)                                  { return checkedAlloc (size); }
+void* operator new (std::size_t size, const std::nothrow_t&) noexcept    { RealtimeGuard::checkAllocation (size); return std::malloc (size == 0 ? 1 : size); }
+void* operator new[] (std::size_t size, const std::nothrow_t&) noexcept  { RealtimeGuard::checkAllocation (size); return std::malloc (size == 0 ? 1 : size); }
+
+void operator delete (void* p) noexcept                                  { checkedFree (p); }
+void operator delete[] (void* p) noexcept                                { checkedFree (p); }
+void operator delete (void* p, std::size_t) noexcept                     { checkedFree (p); }
+void operator delete[] (void* p, std::size_t) noexcept                   { checkedFree (p); }
+void operator delete (void* p, const std::nothrow_t&) noexcept           { checkedFree (p); }
+void operator delete[] (void* p, const std::nothrow_t&) noexcept         { checkedFree (p); }
+
+#endif